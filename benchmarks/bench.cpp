@@ -5,6 +5,7 @@
 #include <vector>
 #include <cstdlib>
 #include "../src/collections/vec.h"
+#include "../src/collections/small_vec.h"
 
 void rand_vector(picobench::state& s)
 {
@@ -28,6 +29,111 @@ void sc2d_rand_vector(picobench::state& s)
 }
 PICOBENCH(sc2d_rand_vector);
 
+// Short-lived vectors with a few elements: component lists, quadtree node contents
+PICOBENCH_SUITE("short vectors, 6 elements");
+
+void short_vector(picobench::state& s)
+{
+    int sum = 0;
+    for (auto _ : s)
+    {
+        std::vector<int> v;
+        for (int i = 0; i < 6; ++i)
+            v.push_back(i);
+        sum += v[5];
+    }
+    s.set_result(sum);
+}
+PICOBENCH(short_vector).baseline();
+
+void sc2d_short_vec(picobench::state& s)
+{
+    int sum = 0;
+    for (auto _ : s)
+    {
+        sc2d::vec<int> v;
+        for (int i = 0; i < 6; ++i)
+            v.push_back(i);
+        sum += v[5];
+    }
+    s.set_result(sum);
+}
+PICOBENCH(sc2d_short_vec);
+
+void sc2d_short_small_vec(picobench::state& s)
+{
+    int sum = 0;
+    for (auto _ : s)
+    {
+        sc2d::small_vec<int, 8> v;
+        for (int i = 0; i < 6; ++i)
+            v.push_back(i);
+        sum += v[5];
+    }
+    s.set_result(sum);
+}
+PICOBENCH(sc2d_short_small_vec);
+
+PICOBENCH_SUITE("insert / erase at front, 1000 elements");
+
+void front_insert_erase_vector(picobench::state& s)
+{
+    std::vector<int> v(1000, 1);
+    int sum = 0;
+    for (auto _ : s)
+    {
+        v.insert(v.begin(), 2);
+        sum += v[1];
+        v.erase(v.begin());
+    }
+    s.set_result(sum);
+}
+PICOBENCH(front_insert_erase_vector).baseline();
+
+void sc2d_front_insert_erase_vec(picobench::state& s)
+{
+    sc2d::vec<int> v(1000, 1);
+    int sum = 0;
+    for (auto _ : s)
+    {
+        v.insert(v.begin(), 2);
+        sum += v[1];
+        v.erase(v.begin());
+    }
+    s.set_result(sum);
+}
+PICOBENCH(sc2d_front_insert_erase_vec);
+
+PICOBENCH_SUITE("append 4096 ints");
+
+static int source_ints[4096];
+
+void append_vector(picobench::state& s)
+{
+    int sum = 0;
+    for (auto _ : s)
+    {
+        std::vector<int> v;
+        v.insert(v.end(), source_ints, source_ints + 4096);
+        sum += v[4095];
+    }
+    s.set_result(sum);
+}
+PICOBENCH(append_vector).baseline();
+
+void sc2d_append_vec(picobench::state& s)
+{
+    int sum = 0;
+    for (auto _ : s)
+    {
+        sc2d::vec<int> v;
+        v.append(source_ints, 4096);
+        sum += v[4095];
+    }
+    s.set_result(sum);
+}
+PICOBENCH(sc2d_append_vec);
+
 
 
 //void rand_vector_reserve(picobench::state& s)
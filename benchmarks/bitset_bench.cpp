@@ -0,0 +1,87 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "picobench/picobench.hpp"
+
+#include "../src/collections/bitset.h"
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    constexpr size_t BIT_COUNT = 1u << 16u;
+}
+
+// Marking objects found in several quadtree leaves
+PICOBENCH_SUITE("bitset, visited set of 65536 objects");
+
+void vector_bool_visited(picobench::state& s)
+{
+    std::vector<bool> visited(BIT_COUNT);
+    size_t first_visits = 0;
+    uint32_t id = 1;
+    for(auto _ : s) {
+        id = id * 1103515245u + 12345u;
+        const size_t index = (id >> 8u) % BIT_COUNT;
+        if(!visited[index]) {
+            visited[index] = true;
+            ++first_visits;
+        }
+    }
+    s.set_result(first_visits);
+}
+PICOBENCH(vector_bool_visited).baseline();
+
+void dynamic_bitset_visited(picobench::state& s)
+{
+    sc2d::dynamic_bitset visited(BIT_COUNT);
+    size_t first_visits = 0;
+    uint32_t id = 1;
+    for(auto _ : s) {
+        id = id * 1103515245u + 12345u;
+        first_visits += !visited.test_and_set((id >> 8u) % BIT_COUNT);
+    }
+    s.set_result(first_visits);
+}
+PICOBENCH(dynamic_bitset_visited);
+
+PICOBENCH_SUITE("bitset, and + popcount of 65536 bits");
+
+void vector_bool_and_count(picobench::state& s)
+{
+    std::vector<bool> a(BIT_COUNT);
+    std::vector<bool> b(BIT_COUNT);
+    for(size_t i = 0; i < BIT_COUNT; i += 3)
+        a[i] = true;
+    for(size_t i = 0; i < BIT_COUNT; i += 5)
+        b[i] = true;
+
+    size_t count = 0;
+    for(auto _ : s) {
+        for(size_t i = 0; i < BIT_COUNT; ++i) {
+            a[i] = a[i] && b[i];
+            count += a[i];
+        }
+    }
+    s.set_result(count);
+}
+PICOBENCH(vector_bool_and_count).iterations({8, 64}).baseline();
+
+void dynamic_bitset_and_count(picobench::state& s)
+{
+    sc2d::dynamic_bitset a(BIT_COUNT);
+    sc2d::dynamic_bitset b(BIT_COUNT);
+    for(size_t i = 0; i < BIT_COUNT; i += 3)
+        a.set(i);
+    for(size_t i = 0; i < BIT_COUNT; i += 5)
+        b.set(i);
+
+    size_t count = 0;
+    for(auto _ : s) {
+        a &= b;
+        count += a.count();
+    }
+    s.set_result(count);
+}
+PICOBENCH(dynamic_bitset_and_count).iterations({8, 64});
@@ -0,0 +1,149 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "picobench/picobench.hpp"
+
+#include "../src/collections/flat_map.h"
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    const std::vector<int> MAP_SIZES = {100, 10000, 1000000};
+
+    /**
+     * Scattered keys, like component ids and hashed names
+     */
+    std::vector<unsigned> make_keys(size_t count)
+    {
+        std::vector<unsigned> keys(count);
+        unsigned seed = 42;
+        for(auto& key : keys) {
+            seed = seed * 1103515245u + 12345u;
+            key = seed;
+        }
+        return keys;
+    }
+
+    std::vector<std::string> make_names(size_t count)
+    {
+        std::vector<std::string> names;
+        names.reserve(count);
+        for(unsigned key : make_keys(count))
+            names.emplace_back("resources/textures/" + std::to_string(key) + ".png");
+        return names;
+    }
+
+    template <typename Map>
+    void insert_keys(picobench::state& s)
+    {
+        const auto keys = make_keys(s.iterations());
+        picobench::scope scope(s);
+        Map map;
+        for(unsigned key : keys)
+            map[key] = key;
+        s.set_result(map.size());
+    }
+
+    template <typename Map, typename Key>
+    void find_keys(picobench::state& s, const std::vector<Key>& keys)
+    {
+        Map map;
+        for(size_t i = 0; i < keys.size(); ++i)
+            map[keys[i]] = i;
+
+        picobench::scope scope(s);
+        size_t sum = 0;
+        // Every other lookup misses
+        for(size_t i = 0; i < keys.size(); ++i) {
+            auto it = map.find(keys[i]);
+            sum += it != map.end() ? it->second : 0;
+            sum += map.find(keys[keys.size() - 1 - i] + 1) != map.end();
+        }
+        s.set_result(sum);
+    }
+
+    template <typename Map>
+    void find_ints(picobench::state& s)
+    {
+        find_keys<Map>(s, make_keys(s.iterations()));
+    }
+
+    template <typename Map>
+    void find_strings(picobench::state& s)
+    {
+        const auto names = make_names(s.iterations());
+        Map map;
+        for(size_t i = 0; i < names.size(); ++i)
+            map[names[i]] = i;
+
+        picobench::scope scope(s);
+        size_t sum = 0;
+        for(const auto& name : names)
+            sum += map.find(name)->second;
+        s.set_result(sum);
+    }
+}
+
+PICOBENCH_SUITE("flat_map, insert int keys");
+
+void std_map_insert(picobench::state& s)
+{
+    insert_keys<std::map<unsigned, unsigned>>(s);
+}
+PICOBENCH(std_map_insert).iterations(MAP_SIZES).baseline();
+
+void std_unordered_map_insert(picobench::state& s)
+{
+    insert_keys<std::unordered_map<unsigned, unsigned>>(s);
+}
+PICOBENCH(std_unordered_map_insert).iterations(MAP_SIZES);
+
+void sc2d_flat_map_insert(picobench::state& s)
+{
+    insert_keys<sc2d::flat_map<unsigned, unsigned>>(s);
+}
+PICOBENCH(sc2d_flat_map_insert).iterations(MAP_SIZES);
+
+PICOBENCH_SUITE("flat_map, find int keys, half misses");
+
+void std_map_find(picobench::state& s)
+{
+    find_ints<std::map<unsigned, size_t>>(s);
+}
+PICOBENCH(std_map_find).iterations(MAP_SIZES).baseline();
+
+void std_unordered_map_find(picobench::state& s)
+{
+    find_ints<std::unordered_map<unsigned, size_t>>(s);
+}
+PICOBENCH(std_unordered_map_find).iterations(MAP_SIZES);
+
+void sc2d_flat_map_find(picobench::state& s)
+{
+    find_ints<sc2d::flat_map<unsigned, size_t>>(s);
+}
+PICOBENCH(sc2d_flat_map_find).iterations(MAP_SIZES);
+
+PICOBENCH_SUITE("flat_map, find string keys");
+
+void std_map_find_string(picobench::state& s)
+{
+    find_strings<std::map<std::string, size_t>>(s);
+}
+PICOBENCH(std_map_find_string).iterations(MAP_SIZES).baseline();
+
+void std_unordered_map_find_string(picobench::state& s)
+{
+    find_strings<std::unordered_map<std::string, size_t>>(s);
+}
+PICOBENCH(std_unordered_map_find_string).iterations(MAP_SIZES);
+
+void sc2d_flat_map_find_string(picobench::state& s)
+{
+    find_strings<sc2d::flat_map<std::string, size_t>>(s);
+}
+PICOBENCH(sc2d_flat_map_find_string).iterations(MAP_SIZES);
@@ -0,0 +1,68 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "picobench/picobench.hpp"
+
+#include "../src/memory/small_allocator.h"
+#include <cstdlib>
+#include <vector>
+
+PICOBENCH_SUITE("small-object allocator");
+
+namespace
+{
+    // Mixed sizes, every 3rd block is freed right away, the rest at the end
+    template <typename Alloc, typename Free>
+    void alloc_free_mixed(picobench::state& s, Alloc alloc, Free dealloc)
+    {
+        std::vector<void*> live;
+        live.reserve(s.iterations());
+        size_t i = 0;
+        for(auto _ : s) {
+            void* ptr = alloc(8 + (i * 24) % 504);
+            if(i++ % 3 == 0)
+                dealloc(ptr);
+            else
+                live.push_back(ptr);
+        }
+        for(void* ptr : live)
+            dealloc(ptr);
+        s.set_result((uintptr_t)live.size());
+    }
+}
+
+void malloc_mixed(picobench::state& s)
+{
+    alloc_free_mixed(s, malloc, free);
+}
+PICOBENCH(malloc_mixed).baseline();
+
+void small_alloc_mixed(picobench::state& s)
+{
+    alloc_free_mixed(s, sc2d::memory::small_allocator::allocate,
+                     [](void* ptr) { sc2d::memory::small_allocator::deallocate(ptr); });
+}
+PICOBENCH(small_alloc_mixed);
+
+PICOBENCH_SUITE("small-object allocator, alloc / free pair");
+
+void malloc_free_pair(picobench::state& s)
+{
+    // Keeps the compiler from eliding malloc / free pairs
+    void* (*volatile alloc)(size_t) = malloc;
+    for(auto _ : s) {
+        void* ptr = alloc(32);
+        free(ptr);
+    }
+}
+PICOBENCH(malloc_free_pair).baseline();
+
+void small_alloc_free_pair(picobench::state& s)
+{
+    for(auto _ : s) {
+        void* ptr = sc2d::memory::small_allocator::allocate(32);
+        sc2d::memory::small_allocator::deallocate(ptr);
+    }
+}
+PICOBENCH(small_alloc_free_pair);
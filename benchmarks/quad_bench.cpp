@@ -0,0 +1,167 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "picobench/picobench.hpp"
+
+#include "../src/core/rendering/rendering_types.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr size_t SPRITE_COUNT = sc2d::limits::DRAWCALL_QUADS;
+
+    struct sprite_columns
+    {
+        std::vector<float> x, y, width, height, rotation;
+        std::vector<sc2d::uv_rect> uv;
+        std::vector<uint32_t> color;
+        std::vector<sc2d::batch_sprite> sprites;
+
+        sprite_columns()
+        {
+            std::mt19937 rng(3);
+            std::uniform_real_distribution<float> coord(0.0f, 1920.0f);
+            std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+            for(size_t i = 0; i < SPRITE_COUNT; ++i) {
+                x.push_back(coord(rng));
+                y.push_back(coord(rng));
+                width.push_back(32.0f);
+                height.push_back(32.0f);
+                rotation.push_back(angle(rng));
+                uv.push_back({{0.25f, 0.5f}, {0.5f, 0.75f}});
+                color.push_back(0xff8040ffu);
+
+                sc2d::batch_sprite sprite;
+                sprite.pos = {x.back(), y.back()};
+                sprite.size = {32.0f, 32.0f};
+                sprite.origin = {0.5f, 0.5f};
+                sprite.rotation = rotation.back();
+                sprite.uv = uv.back();
+                sprite.color = {1.0f, 0.25f, 0.5f, 1.0f};
+                sprites.push_back(sprite);
+            }
+        }
+
+        sc2d::sprite_arrays arrays(bool rotated) const
+        {
+            sc2d::sprite_arrays result;
+            result.x = x.data();
+            result.y = y.data();
+            result.width = width.data();
+            result.height = height.data();
+            result.rotation = rotated ? rotation.data() : nullptr;
+            result.uv = uv.data();
+            result.color = color.data();
+            result.origin = {0.5f, 0.5f};
+            return result;
+        }
+    };
+
+    const sprite_columns& columns()
+    {
+        static const sprite_columns instance;
+        return instance;
+    }
+
+    void single_adds(picobench::state& s, bool rotated)
+    {
+        auto buffer = std::make_unique<sc2d::QuadBuffer>();
+        std::vector<sc2d::batch_sprite> sprites = columns().sprites;
+        if(!rotated) {
+            for(auto& sprite : sprites)
+                sprite.rotation = 0.0f;
+        }
+
+        float sum = 0.0f;
+        picobench::scope scope(s);
+        for(int i = 0; i < s.iterations(); ++i) {
+            buffer->clear();
+            for(const auto& sprite : sprites)
+                buffer->add(sprite, 0);
+            sum += buffer->data[SPRITE_COUNT - 1].tl.pos.x;
+        }
+        s.set_result((size_t)sum);
+    }
+
+    template <typename Buffer = sc2d::QuadBuffer>
+    void bulk_add(picobench::state& s, bool rotated)
+    {
+        auto buffer = std::make_unique<Buffer>();
+        const sc2d::sprite_arrays arrays = columns().arrays(rotated);
+
+        float sum = 0.0f;
+        picobench::scope scope(s);
+        for(int i = 0; i < s.iterations(); ++i) {
+            buffer->clear();
+            buffer->add_many(arrays, SPRITE_COUNT, 0);
+            sum += buffer->data[SPRITE_COUNT - 1].tl.pos.x;
+        }
+        s.set_result((size_t)sum);
+    }
+
+    void instance_fill(picobench::state& s, bool rotated)
+    {
+        auto instances = std::make_unique<sc2d::sprite_instance[]>(SPRITE_COUNT);
+        const sc2d::sprite_arrays arrays = columns().arrays(rotated);
+
+        float sum = 0.0f;
+        picobench::scope scope(s);
+        for(int i = 0; i < s.iterations(); ++i) {
+            sc2d::make_sprite_instances(arrays, SPRITE_COUNT, 0, instances.get());
+            sum += instances[SPRITE_COUNT - 1].pos.x;
+        }
+        s.set_result((size_t)sum);
+    }
+}
+
+// One iteration fills a QuadBuffer with 1024 sprites, quads/second = 1024e9 / ns per iteration
+PICOBENCH_SUITE("QuadBuffer, 1024 rotated sprites");
+
+void quad_single_add_rotated(picobench::state& s)
+{
+    single_adds(s, true);
+}
+PICOBENCH(quad_single_add_rotated).iterations({100, 1000}).baseline();
+
+void quad_add_many_rotated(picobench::state& s)
+{
+    bulk_add(s, true);
+}
+PICOBENCH(quad_add_many_rotated).iterations({100, 1000});
+
+void quad_add_many_rotated_packed(picobench::state& s)
+{
+    bulk_add<sc2d::PackedQuadBuffer>(s, true);
+}
+PICOBENCH(quad_add_many_rotated_packed).iterations({100, 1000});
+
+// InstancedSpriteBatch, rotation is left to the vertex shader
+void sprite_instances_rotated(picobench::state& s)
+{
+    instance_fill(s, true);
+}
+PICOBENCH(sprite_instances_rotated).iterations({100, 1000});
+
+PICOBENCH_SUITE("QuadBuffer, 1024 axis-aligned sprites");
+
+void quad_single_add(picobench::state& s)
+{
+    single_adds(s, false);
+}
+PICOBENCH(quad_single_add).iterations({100, 1000}).baseline();
+
+void quad_add_many(picobench::state& s)
+{
+    bulk_add(s, false);
+}
+PICOBENCH(quad_add_many).iterations({100, 1000});
+
+void quad_add_many_packed(picobench::state& s)
+{
+    bulk_add<sc2d::PackedQuadBuffer>(s, false);
+}
+PICOBENCH(quad_add_many_packed).iterations({100, 1000});
@@ -0,0 +1,172 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "picobench/picobench.hpp"
+
+#include "../src/collections/mpmc_queue.h"
+#include "../src/collections/spsc_queue.h"
+#include <atomic>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr size_t QUEUE_CAPACITY = 1024;
+    constexpr size_t BATCH = 32;
+
+    /**
+     * std::queue behind a mutex, bounded like the ring buffers
+     */
+    class locked_queue
+    {
+    public:
+        bool try_push(int value)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if(items.size() == QUEUE_CAPACITY)
+                return false;
+            items.push(value);
+            return true;
+        }
+
+        bool try_pop(int& out)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if(items.empty())
+                return false;
+            out = items.front();
+            items.pop();
+            return true;
+        }
+
+    private:
+        std::mutex lock;
+        std::queue<int> items;
+    };
+
+    template <bool Batched, typename Queue>
+    size_t push_items(Queue& q, size_t first, size_t count)
+    {
+        int batch[BATCH];
+        for(size_t i = 0; i < count;) {
+            size_t pushed;
+            if constexpr(Batched) {
+                const size_t n = count - i < BATCH ? count - i : BATCH;
+                for(size_t j = 0; j < n; ++j)
+                    batch[j] = (int)(first + i + j);
+                pushed = q.push_batch(batch, n);
+            } else {
+                pushed = q.try_push((int)(first + i)) ? 1 : 0;
+            }
+
+            if(pushed == 0)
+                std::this_thread::yield();
+            i += pushed;
+        }
+        return count;
+    }
+
+    template <bool Batched, typename Queue>
+    size_t pop_items(Queue& q, std::atomic<size_t>& popped, size_t total)
+    {
+        int batch[BATCH];
+        size_t sum = 0;
+        while(popped.load(std::memory_order_relaxed) < total) {
+            size_t n;
+            if constexpr(Batched)
+                n = q.pop_batch(batch, BATCH);
+            else
+                n = q.try_pop(batch[0]) ? 1 : 0;
+
+            if(n == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            for(size_t i = 0; i < n; ++i)
+                sum += batch[i];
+            popped.fetch_add(n, std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    /**
+     * Moves s.iterations() items from 'producers' to 'consumers' threads
+     */
+    template <bool Batched = false, typename Queue>
+    void transfer(picobench::state& s, Queue& q, size_t producers, size_t consumers)
+    {
+        const size_t total = s.iterations();
+        std::atomic<size_t> popped {0};
+        std::atomic<size_t> sum {0};
+        std::vector<std::thread> threads;
+
+        picobench::scope scope(s);
+        for(size_t c = 0; c < consumers; ++c)
+            threads.emplace_back([&] { sum += pop_items<Batched>(q, popped, total); });
+        for(size_t p = 0; p < producers; ++p) {
+            const size_t first = total * p / producers;
+            const size_t count = total * (p + 1) / producers - first;
+            threads.emplace_back([&q, first, count] { push_items<Batched>(q, first, count); });
+        }
+        for(auto& t : threads)
+            t.join();
+
+        s.set_result(sum.load());
+    }
+}
+
+PICOBENCH_SUITE("queue, 1 producer -> 1 consumer");
+
+void locked_queue_spsc(picobench::state& s)
+{
+    locked_queue q;
+    transfer(s, q, 1, 1);
+}
+PICOBENCH(locked_queue_spsc).baseline();
+
+void spsc_queue_single(picobench::state& s)
+{
+    sc2d::spsc_queue<int> q(QUEUE_CAPACITY);
+    transfer(s, q, 1, 1);
+}
+PICOBENCH(spsc_queue_single);
+
+void spsc_queue_batch(picobench::state& s)
+{
+    sc2d::spsc_queue<int> q(QUEUE_CAPACITY);
+    transfer<true>(s, q, 1, 1);
+}
+PICOBENCH(spsc_queue_batch);
+
+void mpmc_queue_spsc(picobench::state& s)
+{
+    sc2d::mpmc_queue<int> q(QUEUE_CAPACITY);
+    transfer(s, q, 1, 1);
+}
+PICOBENCH(mpmc_queue_spsc);
+
+PICOBENCH_SUITE("queue, 2 producers -> 2 consumers");
+
+void locked_queue_mpmc(picobench::state& s)
+{
+    locked_queue q;
+    transfer(s, q, 2, 2);
+}
+PICOBENCH(locked_queue_mpmc).baseline();
+
+void mpmc_queue_single(picobench::state& s)
+{
+    sc2d::mpmc_queue<int> q(QUEUE_CAPACITY);
+    transfer(s, q, 2, 2);
+}
+PICOBENCH(mpmc_queue_single);
+
+void mpmc_queue_batch(picobench::state& s)
+{
+    sc2d::mpmc_queue<int> q(QUEUE_CAPACITY);
+    transfer<true>(s, q, 2, 2);
+}
+PICOBENCH(mpmc_queue_batch);
@@ -0,0 +1,102 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "picobench/picobench.hpp"
+
+#include "../src/collections/radix_sort.h"
+#include "../src/core/rendering/render_key.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    /**
+     * Fields RenderQueue reads from rend_data2d, without the GL types
+     */
+    struct draw_item
+    {
+        uint32_t layer;
+        uint32_t shader;
+        uint32_t texid;
+        uint32_t depth;
+    };
+
+    struct queue_item
+    {
+        uint64_t key;
+        const draw_item* data;
+    };
+
+    std::vector<draw_item> make_items(size_t count)
+    {
+        std::vector<draw_item> items(count);
+        uint32_t seed = 7;
+        for(auto& item : items) {
+            seed = seed * 1103515245u + 12345u;
+            item = {(seed >> 8u) % 4, (seed >> 12u) % 8, (seed >> 16u) % 64, seed % 100000};
+        }
+        return items;
+    }
+
+    const std::vector<int> QUEUE_SIZES = {10000, 30000, 100000};
+}
+
+// Sort one frame worth of draw items, s.iterations() items
+PICOBENCH_SUITE("render queue sort");
+
+void stable_sort_members(picobench::state& s)
+{
+    const auto items = make_items(s.iterations());
+    std::vector<const draw_item*> queue;
+    queue.reserve(items.size());
+    for(const auto& item : items)
+        queue.push_back(&item);
+
+    picobench::scope scope(s);
+    std::stable_sort(queue.begin(), queue.end(), [](const draw_item* a, const draw_item* b) {
+        if(a->layer != b->layer)
+            return a->layer < b->layer;
+        if(a->shader != b->shader)
+            return a->shader < b->shader;
+        if(a->texid != b->texid)
+            return a->texid < b->texid;
+        return a->depth < b->depth;
+    });
+    s.set_result(queue.front()->depth);
+}
+PICOBENCH(stable_sort_members).iterations(QUEUE_SIZES).baseline();
+
+void stable_sort_keys(picobench::state& s)
+{
+    const auto items = make_items(s.iterations());
+    const sc2d::render_key_layout layout;
+    std::vector<queue_item> queue;
+    queue.reserve(items.size());
+
+    picobench::scope scope(s);
+    for(const auto& item : items)
+        queue.push_back({layout.encode(item.layer, item.shader, item.texid, item.depth), &item});
+    std::stable_sort(queue.begin(), queue.end(),
+                     [](const queue_item& a, const queue_item& b) { return a.key < b.key; });
+    s.set_result(queue.front().data->depth);
+}
+PICOBENCH(stable_sort_keys).iterations(QUEUE_SIZES);
+
+void radix_sort_keys(picobench::state& s)
+{
+    const auto items = make_items(s.iterations());
+    const sc2d::render_key_layout layout;
+    std::vector<queue_item> queue;
+    std::vector<queue_item> scratch(items.size());
+    queue.reserve(items.size());
+
+    picobench::scope scope(s);
+    for(const auto& item : items)
+        queue.push_back({layout.encode(item.layer, item.shader, item.texid, item.depth), &item});
+    sc2d::radix_sort64(queue.data(), scratch.data(), queue.size(),
+                       [](const queue_item& item) { return item.key; });
+    s.set_result(queue.front().data->depth);
+}
+PICOBENCH(radix_sort_keys).iterations(QUEUE_SIZES);
@@ -0,0 +1,105 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "picobench/picobench.hpp"
+
+#include "../src/collections/soa_vec.h"
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    constexpr float DT = 1.0f / 60.0f;
+
+    /**
+     * Layout of a typical transformable sprite: hot position and velocity
+     * next to a cached model matrix and other cold data
+     */
+    struct sprite_aos
+    {
+        float x, y;
+        float vx, vy;
+        float rotation;
+        float scale_x, scale_y;
+        float model[16];
+        uint32_t color;
+    };
+
+    using sprite_soa =
+        sc2d::soa_vec<float, float, float, float, float, float, float, sprite_aos*, uint32_t>;
+    enum sprite_field
+    {
+        X,
+        Y,
+        VX,
+        VY
+    };
+
+    void fill(std::vector<sprite_aos>& sprites, size_t count)
+    {
+        sprites.resize(count);
+        for(size_t i = 0; i < count; ++i) {
+            sprites[i].x = (float)i;
+            sprites[i].y = (float)i;
+            sprites[i].vx = 1.0f;
+            sprites[i].vy = -1.0f;
+        }
+    }
+
+    void fill(sprite_soa& sprites, size_t count)
+    {
+        for(size_t i = 0; i < count; ++i)
+            sprites.push_back((float)i, (float)i, 1.0f, -1.0f, 0.0f, 1.0f, 1.0f, nullptr,
+                              0xffffffffu);
+    }
+}
+
+// Integrate positions of s.iterations() sprites, only x/y/vx/vy are touched
+PICOBENCH_SUITE("soa_vec, position update");
+
+void aos_position_update(picobench::state& s)
+{
+    std::vector<sprite_aos> sprites;
+    fill(sprites, s.iterations());
+
+    picobench::scope scope(s);
+    for(auto& sprite : sprites) {
+        sprite.x += sprite.vx * DT;
+        sprite.y += sprite.vy * DT;
+    }
+    s.set_result((size_t)sprites.back().x);
+}
+PICOBENCH(aos_position_update).iterations({10000, 100000, 1000000}).baseline();
+
+void soa_position_update(picobench::state& s)
+{
+    sprite_soa sprites;
+    fill(sprites, s.iterations());
+
+    picobench::scope scope(s);
+    float* __restrict x = sprites.data<X>();
+    float* __restrict y = sprites.data<Y>();
+    const float* __restrict vx = sprites.data<VX>();
+    const float* __restrict vy = sprites.data<VY>();
+    for(size_t i = 0, count = sprites.size(); i < count; ++i) {
+        x[i] += vx[i] * DT;
+        y[i] += vy[i] * DT;
+    }
+    s.set_result((size_t)x[sprites.size() - 1]);
+}
+PICOBENCH(soa_position_update).iterations({10000, 100000, 1000000});
+
+void soa_proxy_position_update(picobench::state& s)
+{
+    sprite_soa sprites;
+    fill(sprites, s.iterations());
+
+    picobench::scope scope(s);
+    for(auto [x, y, vx, vy, rotation, sx, sy, owner, color] : sprites) {
+        x += vx * DT;
+        y += vy * DT;
+    }
+    s.set_result((size_t)sprites.data<X>()[sprites.size() - 1]);
+}
+PICOBENCH(soa_proxy_position_update).iterations({10000, 100000, 1000000});
@@ -0,0 +1,131 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "picobench/picobench.hpp"
+
+#include "../src/collections/sparse_set.h"
+#include "../src/memory/object_pool.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    const std::vector<int> SET_SIZES = {1000, 100000};
+
+    struct particle
+    {
+        float x, y;
+        float vx, vy;
+    };
+
+    /**
+     * Order of removals, scattered like entities dying in a level
+     */
+    std::vector<size_t> make_removals(size_t count)
+    {
+        std::vector<size_t> order(count);
+        for(size_t i = 0; i < count; ++i)
+            order[i] = i;
+        unsigned seed = 7;
+        for(size_t i = count - 1; i > 0; --i) {
+            seed = seed * 1103515245u + 12345u;
+            std::swap(order[i], order[(seed >> 8u) % (i + 1)]);
+        }
+        order.resize(count / 2);
+        return order;
+    }
+}
+
+// Insert N values, remove half of them in random order, update the rest once
+PICOBENCH_SUITE("sparse_set, insert / erase half / iterate");
+
+void unordered_map_churn(picobench::state& s)
+{
+    const auto removals = make_removals(s.iterations());
+    picobench::scope scope(s);
+    std::unordered_map<uint32_t, particle> map;
+    for(uint32_t i = 0; i < (uint32_t)s.iterations(); ++i)
+        map[i] = {(float)i, 0, 1, 1};
+    for(size_t i : removals)
+        map.erase((uint32_t)i);
+    float sum = 0;
+    for(auto& [id, p] : map) {
+        p.x += p.vx;
+        sum += p.x;
+    }
+    s.set_result((picobench::result_t)sum);
+}
+PICOBENCH(unordered_map_churn).iterations(SET_SIZES).baseline();
+
+void object_pool_churn(picobench::state& s)
+{
+    const auto removals = make_removals(s.iterations());
+    picobench::scope scope(s);
+    sc2d::memory::object_pool<particle> pool;
+    std::vector<sc2d::memory::pool_handle> handles;
+    handles.reserve(s.iterations());
+    for(size_t i = 0; i < (size_t)s.iterations(); ++i)
+        handles.push_back(pool.create(particle {(float)i, 0, 1, 1}));
+    for(size_t i : removals)
+        pool.destroy(handles[i]);
+    float sum = 0;
+    pool.for_each([&](sc2d::memory::pool_handle, particle& p) {
+        p.x += p.vx;
+        sum += p.x;
+    });
+    s.set_result((picobench::result_t)sum);
+}
+PICOBENCH(object_pool_churn).iterations(SET_SIZES);
+
+void sparse_set_churn(picobench::state& s)
+{
+    const auto removals = make_removals(s.iterations());
+    picobench::scope scope(s);
+    sc2d::sparse_set<particle> set;
+    std::vector<sc2d::memory::pool_handle> handles;
+    handles.reserve(s.iterations());
+    for(size_t i = 0; i < (size_t)s.iterations(); ++i)
+        handles.push_back(set.insert({(float)i, 0, 1, 1}));
+    for(size_t i : removals)
+        set.erase(handles[i]);
+    float sum = 0;
+    for(particle& p : set) {
+        p.x += p.vx;
+        sum += p.x;
+    }
+    s.set_result((picobench::result_t)sum);
+}
+PICOBENCH(sparse_set_churn).iterations(SET_SIZES);
+
+PICOBENCH_SUITE("sparse_set, lookup by handle");
+
+void unordered_map_lookup(picobench::state& s)
+{
+    std::unordered_map<uint32_t, particle> map;
+    for(uint32_t i = 0; i < (uint32_t)s.iterations(); ++i)
+        map[i] = {(float)i, 0, 1, 1};
+
+    picobench::scope scope(s);
+    float sum = 0;
+    for(uint32_t i = 0; i < (uint32_t)s.iterations(); ++i)
+        sum += map.find((i * 7919u) % (uint32_t)s.iterations())->second.x;
+    s.set_result((picobench::result_t)sum);
+}
+PICOBENCH(unordered_map_lookup).iterations(SET_SIZES).baseline();
+
+void sparse_set_lookup(picobench::state& s)
+{
+    sc2d::sparse_set<particle> set;
+    std::vector<sc2d::memory::pool_handle> handles;
+    for(size_t i = 0; i < (size_t)s.iterations(); ++i)
+        handles.push_back(set.insert({(float)i, 0, 1, 1}));
+
+    picobench::scope scope(s);
+    float sum = 0;
+    for(uint32_t i = 0; i < (uint32_t)s.iterations(); ++i)
+        sum += set.get(handles[(i * 7919u) % (uint32_t)s.iterations()])->x;
+    s.set_result((picobench::result_t)sum);
+}
+PICOBENCH(sparse_set_lookup).iterations(SET_SIZES);
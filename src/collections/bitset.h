@@ -0,0 +1,473 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_BITSET_H
+#define SCARECROW2D_BITSET_H
+
+#include "core/bits.h"
+#include "core/compiler.h"
+#include "core/dbg/dbg_asserts.h"
+#include "core/types.h"
+#include <cstring>
+#include <vector>
+
+#if COMPILER_AVX2
+#    include <immintrin.h>
+#elif COMPILER_SSE2
+#    include <emmintrin.h>
+#endif
+
+namespace sc2d
+{
+    namespace detail
+    {
+        constexpr size_t BITS_PER_WORD = 64;
+
+        constexpr size_t words_for_bits(size_t bits)
+        {
+            return (bits + BITS_PER_WORD - 1) / BITS_PER_WORD;
+        }
+
+        enum class word_op
+        {
+            AND,
+            OR,
+            XOR,
+            AND_NOT
+        };
+
+        template <word_op OP>
+        forceinline u64 apply_word(u64 a, u64 b)
+        {
+            if constexpr(OP == word_op::AND)
+                return a & b;
+            else if constexpr(OP == word_op::OR)
+                return a | b;
+            else if constexpr(OP == word_op::XOR)
+                return a ^ b;
+            else
+                return a & ~b;
+        }
+
+        /**
+         * dst[i] = dst[i] OP src[i], 4 words per step with AVX2, 2 with SSE2
+         */
+        template <word_op OP>
+        void apply_words(u64* dst, const u64* src, size_t count)
+        {
+            size_t i = 0;
+#if COMPILER_AVX2
+            for(; i + 4 <= count; i += 4) {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                __m256i r;
+                if constexpr(OP == word_op::AND)
+                    r = _mm256_and_si256(a, b);
+                else if constexpr(OP == word_op::OR)
+                    r = _mm256_or_si256(a, b);
+                else if constexpr(OP == word_op::XOR)
+                    r = _mm256_xor_si256(a, b);
+                else
+                    r = _mm256_andnot_si256(b, a);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+            }
+#elif COMPILER_SSE2
+            for(; i + 2 <= count; i += 2) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                __m128i r;
+                if constexpr(OP == word_op::AND)
+                    r = _mm_and_si128(a, b);
+                else if constexpr(OP == word_op::OR)
+                    r = _mm_or_si128(a, b);
+                else if constexpr(OP == word_op::XOR)
+                    r = _mm_xor_si128(a, b);
+                else
+                    r = _mm_andnot_si128(b, a);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), r);
+            }
+#endif
+            for(; i < count; ++i)
+                dst[i] = apply_word<OP>(dst[i], src[i]);
+        }
+
+        inline size_t count_words(const u64* words, size_t count)
+        {
+            size_t result = 0;
+            for(size_t i = 0; i < count; ++i)
+                result += bits::popcount64(words[i]);
+            return result;
+        }
+
+        inline bool any_words(const u64* words, size_t count)
+        {
+            u64 merged = 0;
+            for(size_t i = 0; i < count; ++i)
+                merged |= words[i];
+            return merged != 0;
+        }
+
+        /**
+         * True if every bit of 'subset' is set in 'words'
+         */
+        inline bool contains_words(const u64* words, const u64* subset, size_t count)
+        {
+            u64 missing = 0;
+            for(size_t i = 0; i < count; ++i)
+                missing |= subset[i] & ~words[i];
+            return missing == 0;
+        }
+
+        /**
+         * Index of the first set bit at or after 'from', 'bits' if there is none
+         */
+        inline size_t find_from(const u64* words, size_t bits, size_t from)
+        {
+            if(from >= bits)
+                return bits;
+
+            size_t word = from / BITS_PER_WORD;
+            u64 current = words[word] & (~0ull << (from % BITS_PER_WORD));
+            const size_t word_count = words_for_bits(bits);
+            while(true) {
+                if(current) {
+                    const size_t index = word * BITS_PER_WORD + bits::ctz64(current);
+                    return index < bits ? index : bits;
+                }
+                if(++word == word_count)
+                    return bits;
+                current = words[word];
+            }
+        }
+
+        /**
+         * Calls fn(index) for every set bit, lowest first
+         */
+        template <typename Fn>
+        void for_each_set(const u64* words, size_t count, Fn&& fn)
+        {
+            for(size_t i = 0; i < count; ++i) {
+                for(u64 word = words[i]; word; word &= word - 1)
+                    fn(i * BITS_PER_WORD + bits::ctz64(word));
+            }
+        }
+    }
+
+    /**
+     * Compile-time sized set of bits, e.g. component signatures
+     * @tparam N number of bits
+     */
+    template <size_t N>
+    class fixed_bitset
+    {
+    public:
+        static constexpr size_t WORD_COUNT = detail::words_for_bits(N);
+
+        constexpr fixed_bitset() = default;
+
+        static constexpr size_t size()
+        {
+            return N;
+        }
+
+        bool test(size_t index) const
+        {
+            return (words[index / 64] >> (index % 64)) & 1u;
+        }
+
+        bool operator[](size_t index) const
+        {
+            return test(index);
+        }
+
+        fixed_bitset& set(size_t index)
+        {
+            words[index / 64] |= 1ull << (index % 64);
+            return *this;
+        }
+
+        fixed_bitset& reset(size_t index)
+        {
+            words[index / 64] &= ~(1ull << (index % 64));
+            return *this;
+        }
+
+        fixed_bitset& reset()
+        {
+            memset(words, 0, sizeof(words));
+            return *this;
+        }
+
+        size_t count() const
+        {
+            return detail::count_words(words, WORD_COUNT);
+        }
+
+        bool any() const
+        {
+            return detail::any_words(words, WORD_COUNT);
+        }
+
+        bool none() const
+        {
+            return !any();
+        }
+
+        /**
+         * True if every bit set in 'other' is set here
+         */
+        bool contains(const fixed_bitset& other) const
+        {
+            return detail::contains_words(words, other.words, WORD_COUNT);
+        }
+
+        /**
+         * @return index of the first set bit, size() if none
+         */
+        size_t find_first() const
+        {
+            return detail::find_from(words, N, 0);
+        }
+
+        size_t find_next(size_t index) const
+        {
+            return detail::find_from(words, N, index + 1);
+        }
+
+        template <typename Fn>
+        void for_each_set(Fn&& fn) const
+        {
+            detail::for_each_set(words, WORD_COUNT, fn);
+        }
+
+        fixed_bitset& operator&=(const fixed_bitset& other)
+        {
+            detail::apply_words<detail::word_op::AND>(words, other.words, WORD_COUNT);
+            return *this;
+        }
+
+        fixed_bitset& operator|=(const fixed_bitset& other)
+        {
+            detail::apply_words<detail::word_op::OR>(words, other.words, WORD_COUNT);
+            return *this;
+        }
+
+        fixed_bitset& operator^=(const fixed_bitset& other)
+        {
+            detail::apply_words<detail::word_op::XOR>(words, other.words, WORD_COUNT);
+            return *this;
+        }
+
+        /**
+         * Clears bits that are set in 'other'
+         */
+        fixed_bitset& and_not(const fixed_bitset& other)
+        {
+            detail::apply_words<detail::word_op::AND_NOT>(words, other.words, WORD_COUNT);
+            return *this;
+        }
+
+        bool operator==(const fixed_bitset& other) const
+        {
+            return memcmp(words, other.words, sizeof(words)) == 0;
+        }
+
+        bool operator!=(const fixed_bitset& other) const
+        {
+            return !(*this == other);
+        }
+
+        const u64* data() const
+        {
+            return words;
+        }
+
+    private:
+        u64 words[WORD_COUNT] = {};
+    };
+
+    /**
+     * Resizable set of bits, e.g. visited flags of objects with dense ids.
+     * Bits past size() in the last word are always 0.
+     */
+    class dynamic_bitset
+    {
+    public:
+        static constexpr size_t npos = (size_t)-1;
+
+        dynamic_bitset() = default;
+        explicit dynamic_bitset(size_t bits, bool value = false)
+        {
+            resize(bits, value);
+        }
+
+        size_t size() const
+        {
+            return num_of_bits;
+        }
+
+        bool empty() const
+        {
+            return num_of_bits == 0;
+        }
+
+        void resize(size_t bits, bool value = false);
+
+        /**
+         * Sets all bits to 0, keeps size
+         */
+        void clear()
+        {
+            if(!words.empty())
+                memset(words.data(), 0, words.size() * sizeof(u64));
+        }
+
+        bool test(size_t index) const
+        {
+            return (words[index / 64] >> (index % 64)) & 1u;
+        }
+
+        bool operator[](size_t index) const
+        {
+            return test(index);
+        }
+
+        void set(size_t index)
+        {
+            words[index / 64] |= 1ull << (index % 64);
+        }
+
+        void reset(size_t index)
+        {
+            words[index / 64] &= ~(1ull << (index % 64));
+        }
+
+        /**
+         * Sets the bit
+         * @return previous value, false on first visit
+         */
+        bool test_and_set(size_t index)
+        {
+            u64& word = words[index / 64];
+            const u64 mask = 1ull << (index % 64);
+            const bool was_set = (word & mask) != 0;
+            word |= mask;
+            return was_set;
+        }
+
+        size_t count() const
+        {
+            return detail::count_words(words.data(), words.size());
+        }
+
+        bool any() const
+        {
+            return detail::any_words(words.data(), words.size());
+        }
+
+        bool none() const
+        {
+            return !any();
+        }
+
+        /**
+         * True if every bit set in 'other' is set here, sizes must match
+         */
+        bool contains(const dynamic_bitset& other) const
+        {
+            DBG_FAIL_IF(other.num_of_bits != num_of_bits, "dynamic_bitset size mismatch")
+            return detail::contains_words(words.data(), other.words.data(), words.size());
+        }
+
+        /**
+         * @return index of the first set bit, npos if none
+         */
+        size_t find_first() const
+        {
+            return to_npos(detail::find_from(words.data(), num_of_bits, 0));
+        }
+
+        size_t find_next(size_t index) const
+        {
+            return to_npos(detail::find_from(words.data(), num_of_bits, index + 1));
+        }
+
+        template <typename Fn>
+        void for_each_set(Fn&& fn) const
+        {
+            detail::for_each_set(words.data(), words.size(), fn);
+        }
+
+        dynamic_bitset& operator&=(const dynamic_bitset& other)
+        {
+            return apply<detail::word_op::AND>(other);
+        }
+
+        dynamic_bitset& operator|=(const dynamic_bitset& other)
+        {
+            return apply<detail::word_op::OR>(other);
+        }
+
+        dynamic_bitset& operator^=(const dynamic_bitset& other)
+        {
+            return apply<detail::word_op::XOR>(other);
+        }
+
+        /**
+         * Clears bits that are set in 'other'
+         */
+        dynamic_bitset& and_not(const dynamic_bitset& other)
+        {
+            return apply<detail::word_op::AND_NOT>(other);
+        }
+
+        bool operator==(const dynamic_bitset& other) const
+        {
+            return num_of_bits == other.num_of_bits && words == other.words;
+        }
+
+        bool operator!=(const dynamic_bitset& other) const
+        {
+            return !(*this == other);
+        }
+
+        const u64* data() const
+        {
+            return words.data();
+        }
+
+    private:
+        template <detail::word_op OP>
+        dynamic_bitset& apply(const dynamic_bitset& other)
+        {
+            DBG_FAIL_IF(other.num_of_bits != num_of_bits, "dynamic_bitset size mismatch")
+            detail::apply_words<OP>(words.data(), other.words.data(), words.size());
+            return *this;
+        }
+
+        size_t to_npos(size_t index) const
+        {
+            return index == num_of_bits ? npos : index;
+        }
+
+        std::vector<u64> words;
+        size_t num_of_bits = 0;
+    };
+
+    inline void dynamic_bitset::resize(size_t bits, bool value)
+    {
+        const size_t old_bits = num_of_bits;
+        if(value && old_bits % 64 && bits > old_bits) {
+            // Tail of the old last word becomes part of the set
+            words.back() |= ~0ull << (old_bits % 64);
+        }
+
+        words.resize(detail::words_for_bits(bits), value ? ~0ull : 0);
+        num_of_bits = bits;
+        if(bits % 64)
+            words.back() &= ~0ull >> (64 - bits % 64);
+    }
+}
+
+#endif //SCARECROW2D_BITSET_H
@@ -0,0 +1,195 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_CONCURRENT_MAP_H
+#define SCARECROW2D_CONCURRENT_MAP_H
+
+#include "collections/flat_map.h"
+#include "core/compiler.h"
+#include "core/types.h"
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace sc2d
+{
+    /**
+     * Read-mostly hash map for sharing data between threads, e.g. loader threads publishing
+     * resources while the render thread looks them up.
+     * Keys are split between SHARD_COUNT flat_maps, each behind its own reader-writer lock,
+     * so readers never block each other and a writer blocks only its shard.
+     * Values live in their own allocations: pointers returned by find() stay valid until
+     * clear(), even when the value is replaced (the old one is kept until clear()).
+     * clear() must not run while other threads use the map or hold pointers to values.
+     * @tparam K key type
+     * @tparam V mapped type
+     */
+    template <typename K, typename V, typename Hash = std::hash<K>,
+              typename KeyEqual = std::equal_to<K>, size_t SHARD_COUNT = 16>
+    class concurrent_map
+    {
+        static_assert((SHARD_COUNT & (SHARD_COUNT - 1)) == 0,
+                      "concurrent_map shard count must be a power of two");
+
+    public:
+        concurrent_map() = default;
+        concurrent_map(const concurrent_map& other) = delete;
+        concurrent_map& operator=(const concurrent_map& other) = delete;
+
+        /**
+         * @return value or nullptr if key is not in the map
+         */
+        const V* find(const K& key) const;
+
+        bool contains(const K& key) const
+        {
+            return find(key) != nullptr;
+        }
+
+        /**
+         * Inserts value if key is not in the map yet. The value is constructed before the
+         * shard is locked, so slow constructors do not stall readers.
+         * @return stored value and true if it was inserted
+         */
+        template <typename... Args>
+        std::pair<const V*, bool> try_emplace(const K& key, Args&&... args);
+
+        /**
+         * Inserts or replaces the value of key, the replaced value stays alive until clear()
+         * @return stored value
+         */
+        const V* insert_or_assign(const K& key, V&& value);
+
+        size_t size() const;
+
+        /**
+         * Calls fn(key, value) for every entry, one shard locked at a time
+         */
+        template <typename Fn>
+        void for_each(Fn&& fn) const;
+
+        /**
+         * Calls fn(value) for every value replaced by insert_or_assign() since the last clear()
+         */
+        template <typename Fn>
+        void for_each_retired(Fn&& fn) const;
+
+        void clear();
+
+    private:
+        using value_map = flat_map<K, std::unique_ptr<V>, Hash, KeyEqual>;
+
+        struct alignas(COMPILER_CACHE_LINE_SIZE) shard
+        {
+            mutable std::shared_mutex lock;
+            value_map values;
+            std::vector<std::unique_ptr<V>> retired;
+        };
+
+        /**
+         * Uses the high bits of a differently mixed hash, flat_map probes with the low bits
+         */
+        static size_t shard_index(const K& key)
+        {
+            const u64 h = (u64)Hash {}(key) * 0xff51afd7ed558ccdull;
+            return (size_t)(h >> 32u) & (SHARD_COUNT - 1);
+        }
+
+        shard& shard_for(const K& key)
+        {
+            return shards[shard_index(key)];
+        }
+
+        const shard& shard_for(const K& key) const
+        {
+            return shards[shard_index(key)];
+        }
+
+        shard shards[SHARD_COUNT];
+    };
+
+    template <typename K, typename V, typename H, typename E, size_t S>
+    const V* concurrent_map<K, V, H, E, S>::find(const K& key) const
+    {
+        const shard& s = shard_for(key);
+        std::shared_lock<std::shared_mutex> guard(s.lock);
+        const auto it = s.values.find(key);
+        return it != s.values.end() ? it->second.get() : nullptr;
+    }
+
+    template <typename K, typename V, typename H, typename E, size_t S>
+    template <typename... Args>
+    std::pair<const V*, bool> concurrent_map<K, V, H, E, S>::try_emplace(const K& key,
+                                                                         Args&&... args)
+    {
+        auto value = std::make_unique<V>(std::forward<Args>(args)...);
+        shard& s = shard_for(key);
+        std::unique_lock<std::shared_mutex> guard(s.lock);
+        const auto [it, inserted] = s.values.try_emplace(key, std::move(value));
+        return {it->second.get(), inserted};
+    }
+
+    template <typename K, typename V, typename H, typename E, size_t S>
+    const V* concurrent_map<K, V, H, E, S>::insert_or_assign(const K& key, V&& value)
+    {
+        auto stored = std::make_unique<V>(std::move(value));
+        const V* result = stored.get();
+        shard& s = shard_for(key);
+        std::unique_lock<std::shared_mutex> guard(s.lock);
+        auto [it, inserted] = s.values.try_emplace(key, std::move(stored));
+        if(!inserted) {
+            // readers may still hold the old value
+            s.retired.push_back(std::move(it->second));
+            it->second = std::move(stored);
+        }
+        return result;
+    }
+
+    template <typename K, typename V, typename H, typename E, size_t S>
+    size_t concurrent_map<K, V, H, E, S>::size() const
+    {
+        size_t result = 0;
+        for(const shard& s : shards) {
+            std::shared_lock<std::shared_mutex> guard(s.lock);
+            result += s.values.size();
+        }
+        return result;
+    }
+
+    template <typename K, typename V, typename H, typename E, size_t S>
+    template <typename Fn>
+    void concurrent_map<K, V, H, E, S>::for_each(Fn&& fn) const
+    {
+        for(const shard& s : shards) {
+            std::shared_lock<std::shared_mutex> guard(s.lock);
+            for(const auto& [key, value] : s.values)
+                fn(key, *value);
+        }
+    }
+
+    template <typename K, typename V, typename H, typename E, size_t S>
+    template <typename Fn>
+    void concurrent_map<K, V, H, E, S>::for_each_retired(Fn&& fn) const
+    {
+        for(const shard& s : shards) {
+            std::shared_lock<std::shared_mutex> guard(s.lock);
+            for(const std::unique_ptr<V>& value : s.retired)
+                fn(*value);
+        }
+    }
+
+    template <typename K, typename V, typename H, typename E, size_t S>
+    void concurrent_map<K, V, H, E, S>::clear()
+    {
+        for(shard& s : shards) {
+            std::unique_lock<std::shared_mutex> guard(s.lock);
+            s.values.clear();
+            s.retired.clear();
+        }
+    }
+}
+
+#endif //SCARECROW2D_CONCURRENT_MAP_H
@@ -0,0 +1,674 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_FLAT_MAP_H
+#define SCARECROW2D_FLAT_MAP_H
+
+#include "core/bits.h"
+#include "core/compiler.h"
+#include "core/types.h"
+#include "memory/memory.h"
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if COMPILER_SSE2
+#    include <emmintrin.h>
+#endif
+
+namespace sc2d
+{
+    namespace detail
+    {
+        using ctrl_t = i8;
+        // Full slots store the low 7 bits of the hash (0..127), free slots are negative
+        constexpr ctrl_t CTRL_EMPTY = -128;
+        constexpr ctrl_t CTRL_DELETED = -2;
+        // Ends the control bytes, neither free nor matching any hash
+        constexpr ctrl_t CTRL_SENTINEL = -1;
+
+        /**
+         * 16 control bytes compared at once, bit i of a result is set for byte i
+         */
+        struct ctrl_group
+        {
+            static constexpr size_t WIDTH = 16;
+
+#if COMPILER_SSE2
+            explicit ctrl_group(const ctrl_t* pos)
+                : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos)))
+            { }
+
+            forceinline u32 match(ctrl_t hash) const
+            {
+                return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash), ctrl));
+            }
+
+            forceinline u32 match_empty() const
+            {
+                return match(CTRL_EMPTY);
+            }
+
+            forceinline u32 match_free() const
+            {
+                return (u32)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl));
+            }
+
+            __m128i ctrl;
+#else
+            explicit ctrl_group(const ctrl_t* pos)
+            {
+                memcpy(ctrl, pos, WIDTH);
+            }
+
+            forceinline u32 match(ctrl_t hash) const
+            {
+                u32 mask = 0;
+                for(u32 i = 0; i < WIDTH; ++i)
+                    mask |= (u32)(ctrl[i] == hash) << i;
+                return mask;
+            }
+
+            forceinline u32 match_empty() const
+            {
+                return match(CTRL_EMPTY);
+            }
+
+            forceinline u32 match_free() const
+            {
+                u32 mask = 0;
+                for(u32 i = 0; i < WIDTH; ++i)
+                    mask |= (u32)(ctrl[i] < -1) << i;
+                return mask;
+            }
+
+            ctrl_t ctrl[WIDTH];
+#endif
+        };
+
+        /**
+         * Control bytes of an empty map, so lookups need no null checks
+         */
+        inline const ctrl_t* empty_ctrl_group()
+        {
+            alignas(16) static const ctrl_t empty[ctrl_group::WIDTH] = {
+                CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY,
+                CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY,
+                CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY};
+            return empty;
+        }
+    }
+
+    /**
+     * Open-addressing hash map with all entries in one flat array.
+     * Every slot has a control byte with 7 bits of the key hash, lookups compare 16
+     * control bytes at once (SSE2 when available) and touch entries only on a hash match.
+     * Unlike std::unordered_map, inserting may move entries: pointers, references and
+     * iterators are invalidated when the map grows.
+     * @tparam K key type
+     * @tparam V mapped type
+     */
+    template <typename K, typename V, typename Hash = std::hash<K>,
+              typename KeyEqual = std::equal_to<K>>
+    class flat_map
+    {
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair<const K, V>;
+        using size_type = size_t;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+        template <bool IS_CONST>
+        class iterator_base
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = flat_map::value_type;
+            using difference_type = ptrdiff_t;
+            using reference = std::conditional_t<IS_CONST, const value_type&, value_type&>;
+            using pointer = std::conditional_t<IS_CONST, const value_type*, value_type*>;
+
+            iterator_base() = default;
+
+            template <bool OTHER_CONST, typename = std::enable_if_t<IS_CONST && !OTHER_CONST>>
+            iterator_base(const iterator_base<OTHER_CONST>& other)
+                : ctrl(other.ctrl)
+                , slot(other.slot)
+            { }
+
+            reference operator*() const
+            {
+                return *slot;
+            }
+
+            pointer operator->() const
+            {
+                return slot;
+            }
+
+            iterator_base& operator++()
+            {
+                ++ctrl;
+                ++slot;
+                skip_free();
+                return *this;
+            }
+
+            iterator_base operator++(int)
+            {
+                iterator_base copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            bool operator==(const iterator_base& other) const
+            {
+                return slot == other.slot;
+            }
+
+            bool operator!=(const iterator_base& other) const
+            {
+                return slot != other.slot;
+            }
+
+        private:
+            friend class flat_map;
+
+            iterator_base(const detail::ctrl_t* first_ctrl, pointer first_slot)
+                : ctrl(first_ctrl)
+                , slot(first_slot)
+            { }
+
+            // Control bytes end with a sentinel, so the loop needs no bounds check
+            void skip_free()
+            {
+                while(*ctrl < detail::CTRL_SENTINEL) {
+                    ++ctrl;
+                    ++slot;
+                }
+            }
+
+            const detail::ctrl_t* ctrl = nullptr;
+            pointer slot = nullptr;
+        };
+
+        using iterator = iterator_base<false>;
+        using const_iterator = iterator_base<true>;
+
+        flat_map() = default;
+        explicit flat_map(size_type expected_size);
+        flat_map(std::initializer_list<value_type> ilist);
+        flat_map(const flat_map& other);
+        flat_map(flat_map&& other) noexcept;
+        ~flat_map();
+
+        flat_map& operator=(const flat_map& other);
+        flat_map& operator=(flat_map&& other) noexcept;
+
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+
+        size_type size() const
+        {
+            return length;
+        }
+
+        bool empty() const
+        {
+            return length == 0;
+        }
+
+        size_type capacity() const
+        {
+            return cap;
+        }
+
+        /**
+         * Makes room for 'expected_size' entries without growing
+         */
+        void reserve(size_type expected_size);
+        void clear();
+
+        iterator find(const K& key);
+        const_iterator find(const K& key) const;
+
+        bool contains(const K& key) const
+        {
+            return find(key) != end();
+        }
+
+        size_type count(const K& key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        /**
+         * Inserts a default constructed value when key is missing
+         */
+        V& operator[](const K& key);
+
+        /**
+         * Constructs value from args only when key is missing
+         * @return iterator to entry with key and true if it was inserted
+         */
+        template <typename... Args>
+        std::pair<iterator, bool> try_emplace(const K& key, Args&&... args);
+        template <typename... Args>
+        std::pair<iterator, bool> try_emplace(K&& key, Args&&... args);
+
+        std::pair<iterator, bool> insert(const value_type& value)
+        {
+            return try_emplace(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type&& value)
+        {
+            return try_emplace(std::move(const_cast<K&>(value.first)), std::move(value.second));
+        }
+
+        /**
+         * Inserts or replaces value of key
+         */
+        template <typename M>
+        std::pair<iterator, bool> insert_or_assign(const K& key, M&& value);
+
+        size_type erase(const K& key);
+        void erase(const_iterator pos);
+
+        void swap(flat_map& other) noexcept;
+
+    private:
+        static constexpr size_t GROUP_WIDTH = detail::ctrl_group::WIDTH;
+
+        static constexpr size_t MIN_CAPACITY = GROUP_WIDTH - 1;
+
+        /**
+         * Max load factor 7/8
+         */
+        static constexpr size_t max_load(size_t capacity)
+        {
+            return capacity - capacity / 8;
+        }
+
+        forceinline static size_t hash_key(const K& key)
+        {
+            // std::hash of integers is identity, mixing bits for the 7-bit control hash
+            const u64 h = (u64)Hash {}(key) * 0x9E3779B97F4A7C15ull;
+            return (size_t)(h ^ (h >> 32u));
+        }
+
+        forceinline static detail::ctrl_t ctrl_hash(size_t hash)
+        {
+            return (detail::ctrl_t)(hash & 0x7f);
+        }
+
+        forceinline value_type* slot_at(size_t index) const
+        {
+            return slots + index;
+        }
+
+        void set_ctrl(size_t index, detail::ctrl_t value);
+
+        /**
+         * @return slot index of key or cap when missing
+         */
+        size_t find_index(const K& key, size_t hash) const;
+
+        /**
+         * First empty or deleted slot on the probe sequence of hash
+         */
+        size_t find_free(size_t hash) const;
+
+        /**
+         * Finds key or prepares a free slot for it
+         * @return slot index and true if the slot is free
+         */
+        std::pair<size_t, bool> find_or_prepare(const K& key);
+
+        void rehash(size_t new_capacity);
+        void destroy_slots();
+
+        // Capacity is 2^n - 1 and used as the probe mask.
+        // Control bytes: cap entries, sentinel, GROUP_WIDTH - 1 mirrored from the beginning
+        detail::ctrl_t* ctrl = const_cast<detail::ctrl_t*>(detail::empty_ctrl_group());
+        value_type* slots = nullptr;
+        size_t cap = 0;
+        size_t length = 0;
+        size_t num_of_deleted = 0;
+    };
+
+    template <typename K, typename V, typename H, typename E>
+    flat_map<K, V, H, E>::flat_map(size_type expected_size)
+    {
+        reserve(expected_size);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    flat_map<K, V, H, E>::flat_map(std::initializer_list<value_type> ilist)
+    {
+        reserve(ilist.size());
+        for(const auto& item : ilist)
+            insert(item);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    flat_map<K, V, H, E>::flat_map(const flat_map& other)
+    {
+        reserve(other.length);
+        for(const auto& item : other)
+            insert(item);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    flat_map<K, V, H, E>::flat_map(flat_map&& other) noexcept
+    {
+        swap(other);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    flat_map<K, V, H, E>::~flat_map()
+    {
+        destroy_slots();
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    flat_map<K, V, H, E>& flat_map<K, V, H, E>::operator=(const flat_map& other)
+    {
+        if(this != &other) {
+            clear();
+            reserve(other.length);
+            for(const auto& item : other)
+                insert(item);
+        }
+        return *this;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    flat_map<K, V, H, E>& flat_map<K, V, H, E>::operator=(flat_map&& other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    typename flat_map<K, V, H, E>::iterator flat_map<K, V, H, E>::begin()
+    {
+        iterator it(ctrl, slots);
+        if(cap)
+            it.skip_free();
+        return it;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    typename flat_map<K, V, H, E>::iterator flat_map<K, V, H, E>::end()
+    {
+        return iterator(ctrl + cap, slots + cap);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    typename flat_map<K, V, H, E>::const_iterator flat_map<K, V, H, E>::begin() const
+    {
+        return const_cast<flat_map*>(this)->begin();
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    typename flat_map<K, V, H, E>::const_iterator flat_map<K, V, H, E>::end() const
+    {
+        return const_cast<flat_map*>(this)->end();
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    void flat_map<K, V, H, E>::reserve(size_type expected_size)
+    {
+        size_t new_capacity = MIN_CAPACITY;
+        while(max_load(new_capacity) < expected_size)
+            new_capacity = new_capacity * 2 + 1;
+        if(new_capacity > cap)
+            rehash(new_capacity);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    void flat_map<K, V, H, E>::clear()
+    {
+        if(!cap)
+            return;
+
+        if constexpr(!std::is_trivially_destructible<value_type>::value) {
+            for(size_t i = 0; i < cap; ++i) {
+                if(ctrl[i] >= 0)
+                    slot_at(i)->~value_type();
+            }
+        }
+        memset(ctrl, detail::CTRL_EMPTY, cap);
+        memset(ctrl + cap + 1, detail::CTRL_EMPTY, GROUP_WIDTH - 1);
+        length = 0;
+        num_of_deleted = 0;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    size_t flat_map<K, V, H, E>::find_index(const K& key, size_t hash) const
+    {
+        if(!cap)
+            return 0;
+
+        const detail::ctrl_t h2 = ctrl_hash(hash);
+        size_t pos = (hash >> 7u) & cap;
+        for(size_t step = GROUP_WIDTH;; step += GROUP_WIDTH) {
+            const detail::ctrl_group group(ctrl + pos);
+            for(u32 match = group.match(h2); match; match &= match - 1) {
+                const size_t index = (pos + bits::ctz32(match)) & cap;
+                if(E {}(slot_at(index)->first, key))
+                    return index;
+            }
+            if(group.match_empty())
+                return cap;
+            // Triangular probing visits every group when capacity + 1 is a power of two
+            pos = (pos + step) & cap;
+        }
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    size_t flat_map<K, V, H, E>::find_free(size_t hash) const
+    {
+        size_t pos = (hash >> 7u) & cap;
+        for(size_t step = GROUP_WIDTH;; step += GROUP_WIDTH) {
+            const detail::ctrl_group group(ctrl + pos);
+            if(const u32 free = group.match_free())
+                return (pos + bits::ctz32(free)) & cap;
+            pos = (pos + step) & cap;
+        }
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    typename flat_map<K, V, H, E>::iterator flat_map<K, V, H, E>::find(const K& key)
+    {
+        const size_t index = find_index(key, hash_key(key));
+        return index == cap ? end() : iterator(ctrl + index, slot_at(index));
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    typename flat_map<K, V, H, E>::const_iterator flat_map<K, V, H, E>::find(const K& key) const
+    {
+        return const_cast<flat_map*>(this)->find(key);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    std::pair<size_t, bool> flat_map<K, V, H, E>::find_or_prepare(const K& key)
+    {
+        const size_t hash = hash_key(key);
+        const size_t index = find_index(key, hash);
+        if(cap && index != cap)
+            return {index, false};
+
+        if(length + num_of_deleted + 1 > max_load(cap)) {
+            // Mostly tombstones: rehashing in place is enough
+            const size_t new_capacity =
+                cap && length + 1 <= max_load(cap) / 2 ? cap : (cap ? cap * 2 + 1 : MIN_CAPACITY);
+            rehash(new_capacity);
+        }
+
+        const size_t free = find_free(hash);
+        num_of_deleted -= ctrl[free] == detail::CTRL_DELETED;
+        set_ctrl(free, ctrl_hash(hash));
+        ++length;
+        return {free, true};
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    V& flat_map<K, V, H, E>::operator[](const K& key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    template <typename... Args>
+    std::pair<typename flat_map<K, V, H, E>::iterator, bool>
+    flat_map<K, V, H, E>::try_emplace(const K& key, Args&&... args)
+    {
+        const auto [index, inserted] = find_or_prepare(key);
+        if(inserted) {
+            new(slot_at(index)) value_type(std::piecewise_construct, std::forward_as_tuple(key),
+                                           std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+        return {iterator(ctrl + index, slot_at(index)), inserted};
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    template <typename... Args>
+    std::pair<typename flat_map<K, V, H, E>::iterator, bool>
+    flat_map<K, V, H, E>::try_emplace(K&& key, Args&&... args)
+    {
+        const auto [index, inserted] = find_or_prepare(key);
+        if(inserted) {
+            new(slot_at(index))
+                value_type(std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+        return {iterator(ctrl + index, slot_at(index)), inserted};
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    template <typename M>
+    std::pair<typename flat_map<K, V, H, E>::iterator, bool>
+    flat_map<K, V, H, E>::insert_or_assign(const K& key, M&& value)
+    {
+        auto result = try_emplace(key, std::forward<M>(value));
+        if(!result.second)
+            result.first->second = std::forward<M>(value);
+        return result;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    typename flat_map<K, V, H, E>::size_type flat_map<K, V, H, E>::erase(const K& key)
+    {
+        const size_t index = find_index(key, hash_key(key));
+        if(!cap || index == cap)
+            return 0;
+
+        erase(const_iterator(ctrl + index, slot_at(index)));
+        return 1;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    void flat_map<K, V, H, E>::erase(const_iterator pos)
+    {
+        const size_t index = pos.slot - slots;
+        slot_at(index)->~value_type();
+        --length;
+
+        // Slot can become empty again if no probe sequence ever passed a full group here
+        const detail::ctrl_group before(ctrl + ((index - GROUP_WIDTH) & cap));
+        const detail::ctrl_group after(ctrl + index);
+        const u32 empty_before = before.match_empty();
+        const u32 empty_after = after.match_empty();
+        if(empty_before && empty_after) {
+            // Full slots between the last empty before and the first empty after
+            const u32 gap = (GROUP_WIDTH - 1 - bits::msb32(empty_before)) + bits::ctz32(empty_after);
+            if(gap < GROUP_WIDTH) {
+                set_ctrl(index, detail::CTRL_EMPTY);
+                return;
+            }
+        }
+        set_ctrl(index, detail::CTRL_DELETED);
+        ++num_of_deleted;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    void flat_map<K, V, H, E>::swap(flat_map& other) noexcept
+    {
+        std::swap(ctrl, other.ctrl);
+        std::swap(slots, other.slots);
+        std::swap(cap, other.cap);
+        std::swap(length, other.length);
+        std::swap(num_of_deleted, other.num_of_deleted);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    forceinline void flat_map<K, V, H, E>::set_ctrl(size_t index, detail::ctrl_t value)
+    {
+        ctrl[index] = value;
+        // Mirrored bytes after the sentinel let a group load start at any index
+        if(index < GROUP_WIDTH - 1)
+            ctrl[cap + 1 + index] = value;
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    void flat_map<K, V, H, E>::rehash(size_t new_capacity)
+    {
+        detail::ctrl_t* old_ctrl = ctrl;
+        value_type* old_slots = slots;
+        const size_t old_capacity = cap;
+
+        constexpr size_t alignment =
+            alignof(value_type) > sizeof(void*) ? alignof(value_type) : sizeof(void*);
+        const size_t ctrl_bytes =
+            (new_capacity + GROUP_WIDTH + alignment - 1) & ~(alignment - 1);
+        const size_t bytes = ctrl_bytes + new_capacity * sizeof(value_type);
+        auto* memory = (unsigned char*)malloc_aligned(bytes, alignment);
+
+        ctrl = (detail::ctrl_t*)memory;
+        slots = (value_type*)(memory + ctrl_bytes);
+        cap = new_capacity;
+        num_of_deleted = 0;
+        memset(ctrl, detail::CTRL_EMPTY, new_capacity + GROUP_WIDTH);
+        ctrl[new_capacity] = detail::CTRL_SENTINEL;
+
+        for(size_t i = 0; i < old_capacity; ++i) {
+            if(old_ctrl[i] < 0)
+                continue;
+            value_type* old_slot = old_slots + i;
+            const size_t hash = hash_key(old_slot->first);
+            const size_t index = find_free(hash);
+            set_ctrl(index, ctrl_hash(hash));
+            new(slot_at(index)) value_type(std::move(const_cast<K&>(old_slot->first)),
+                                           std::move(old_slot->second));
+            old_slot->~value_type();
+        }
+
+        if(old_capacity)
+            free_aligned(old_ctrl);
+    }
+
+    template <typename K, typename V, typename H, typename E>
+    void flat_map<K, V, H, E>::destroy_slots()
+    {
+        if(!cap)
+            return;
+
+        clear();
+        free_aligned(ctrl);
+        ctrl = const_cast<detail::ctrl_t*>(detail::empty_ctrl_group());
+        slots = nullptr;
+        cap = 0;
+    }
+}
+
+#endif //SCARECROW2D_FLAT_MAP_H
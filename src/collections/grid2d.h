@@ -0,0 +1,326 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_GRID2D_H
+#define SCARECROW2D_GRID2D_H
+
+#include "core/bits.h"
+#include "core/dbg/dbg_asserts.h"
+#include "core/types.h"
+#include <algorithm>
+#include <vector>
+
+namespace sc2d
+{
+    /**
+     * 2D grid of cells (tiles, nav costs, collision flags).
+     * Cells are stored in square blocks of 2^BLOCK_SHIFT cells per side, blocks are row-major
+     * and cells inside a block are in Z-order (Morton), so cells close in 2D are close in
+     * memory whatever the scan direction. BLOCK_SHIFT = 0 gives a plain row-major grid.
+     * Storage is padded up to whole blocks.
+     * @tparam T cell type
+     * @tparam BLOCK_SHIFT log2 of block side
+     */
+    template <typename T, u32 BLOCK_SHIFT = 3>
+    class grid2d
+    {
+        static_assert(BLOCK_SHIFT <= 8, "grid2d block side is limited to 256 cells");
+
+    public:
+        static constexpr u32 BLOCK_SIZE = 1u << BLOCK_SHIFT;
+        static constexpr u32 BLOCK_AREA = BLOCK_SIZE * BLOCK_SIZE;
+
+        grid2d() = default;
+        grid2d(u32 width, u32 height, const T& value = T())
+        {
+            assign(width, height, value);
+        }
+
+        /**
+         * Resizes the grid, previous contents are discarded
+         */
+        void assign(u32 width, u32 height, const T& value = T());
+
+        /**
+         * Resizes the grid and copies width * height cells stored row by row
+         */
+        void assign_row_major(const T* src, u32 width, u32 height);
+        void fill(const T& value);
+        void clear();
+
+        u32 width() const
+        {
+            return num_of_cols;
+        }
+
+        u32 height() const
+        {
+            return num_of_rows;
+        }
+
+        size_t size() const
+        {
+            return (size_t)num_of_cols * num_of_rows;
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        bool in_bounds(int x, int y) const
+        {
+            return (u32)x < num_of_cols && (u32)y < num_of_rows;
+        }
+
+        /**
+         * Position of cell in data()
+         */
+        size_t index_of(u32 x, u32 y) const
+        {
+            return row_offset(y) + col_offset(x);
+        }
+
+        T& operator()(u32 x, u32 y)
+        {
+            return cells[index_of(x, y)];
+        }
+
+        const T& operator()(u32 x, u32 y) const
+        {
+            return cells[index_of(x, y)];
+        }
+
+        T& at(int x, int y)
+        {
+            DBG_FAIL_IF(!in_bounds(x, y), "grid2d cell out of bounds")
+            return cells[index_of(x, y)];
+        }
+
+        const T& at(int x, int y) const
+        {
+            DBG_FAIL_IF(!in_bounds(x, y), "grid2d cell out of bounds")
+            return cells[index_of(x, y)];
+        }
+
+        /**
+         * @return cell or 'outside' if x, y is out of bounds
+         */
+        const T& get_or(int x, int y, const T& outside) const
+        {
+            return in_bounds(x, y) ? cells[index_of(x, y)] : outside;
+        }
+
+        /**
+         * Calls fn(x, y, cell) for the in-bounds edge neighbors of x, y
+         */
+        template <typename Fn>
+        void for_each_neighbor4(int x, int y, Fn&& fn) const;
+
+        /**
+         * Calls fn(x, y, cell) for the in-bounds edge and corner neighbors of x, y
+         */
+        template <typename Fn>
+        void for_each_neighbor8(int x, int y, Fn&& fn) const;
+
+        /**
+         * Calls fn(x, y, cell) for every cell of the rectangle clipped to the grid,
+         * block by block so each block is touched once
+         */
+        template <typename Fn>
+        void for_each_in_region(int x, int y, int width, int height, Fn&& fn);
+        template <typename Fn>
+        void for_each_in_region(int x, int y, int width, int height, Fn&& fn) const;
+
+        template <typename Fn>
+        void for_each(Fn&& fn)
+        {
+            for_each_in_region(0, 0, (int)num_of_cols, (int)num_of_rows, fn);
+        }
+
+        template <typename Fn>
+        void for_each(Fn&& fn) const
+        {
+            for_each_in_region(0, 0, (int)num_of_cols, (int)num_of_rows, fn);
+        }
+
+        /**
+         * Copies a width x height window at x, y into 'out' row by row,
+         * cells outside the grid are set to 'outside'
+         */
+        void copy_window(int x, int y, u32 width, u32 height, T* out,
+                         const T& outside = T()) const;
+
+        T* data()
+        {
+            return cells.data();
+        }
+
+        const T* data() const
+        {
+            return cells.data();
+        }
+
+        /**
+         * Cells in data(), including block padding
+         */
+        size_t storage_size() const
+        {
+            return cells.size();
+        }
+
+    private:
+        static constexpr u32 CELL_MASK = BLOCK_SIZE - 1;
+
+        static u32 blocks_for(u32 cells)
+        {
+            return (cells + CELL_MASK) >> BLOCK_SHIFT;
+        }
+
+        size_t row_offset(u32 y) const
+        {
+            return ((size_t)(y >> BLOCK_SHIFT) * blocks_x << (2 * BLOCK_SHIFT))
+                   + (bits::part1by1(y & CELL_MASK) << 1u);
+        }
+
+        static size_t col_offset(u32 x)
+        {
+            return ((size_t)(x >> BLOCK_SHIFT) << (2 * BLOCK_SHIFT)) + bits::part1by1(x & CELL_MASK);
+        }
+
+        template <typename Grid, typename Fn>
+        static void region(Grid& grid, int x, int y, int width, int height, Fn&& fn);
+
+        std::vector<T> cells;
+        u32 num_of_cols = 0;
+        u32 num_of_rows = 0;
+        u32 blocks_x = 0;
+    };
+
+    template <typename T, u32 BLOCK_SHIFT>
+    void grid2d<T, BLOCK_SHIFT>::assign(u32 width, u32 height, const T& value)
+    {
+        num_of_cols = width;
+        num_of_rows = height;
+        blocks_x = blocks_for(width);
+        cells.assign((size_t)blocks_x * blocks_for(height) * BLOCK_AREA, value);
+    }
+
+    template <typename T, u32 BLOCK_SHIFT>
+    void grid2d<T, BLOCK_SHIFT>::assign_row_major(const T* src, u32 width, u32 height)
+    {
+        assign(width, height);
+        for(u32 y = 0; y < height; ++y) {
+            const size_t row = row_offset(y);
+            const T* src_row = src + (size_t)y * width;
+            for(u32 x = 0; x < width; ++x)
+                cells[row + col_offset(x)] = src_row[x];
+        }
+    }
+
+    template <typename T, u32 BLOCK_SHIFT>
+    void grid2d<T, BLOCK_SHIFT>::fill(const T& value)
+    {
+        std::fill(cells.begin(), cells.end(), value);
+    }
+
+    template <typename T, u32 BLOCK_SHIFT>
+    void grid2d<T, BLOCK_SHIFT>::clear()
+    {
+        cells.clear();
+        num_of_cols = 0;
+        num_of_rows = 0;
+        blocks_x = 0;
+    }
+
+    template <typename T, u32 BLOCK_SHIFT>
+    template <typename Fn>
+    void grid2d<T, BLOCK_SHIFT>::for_each_neighbor4(int x, int y, Fn&& fn) const
+    {
+        static constexpr int OFFSETS[4][2] = {{0, -1}, {-1, 0}, {1, 0}, {0, 1}};
+        for(const auto& offset : OFFSETS) {
+            const int nx = x + offset[0];
+            const int ny = y + offset[1];
+            if(in_bounds(nx, ny))
+                fn(nx, ny, cells[index_of(nx, ny)]);
+        }
+    }
+
+    template <typename T, u32 BLOCK_SHIFT>
+    template <typename Fn>
+    void grid2d<T, BLOCK_SHIFT>::for_each_neighbor8(int x, int y, Fn&& fn) const
+    {
+        for(int ny = y - 1; ny <= y + 1; ++ny) {
+            if((u32)ny >= num_of_rows)
+                continue;
+            const size_t row = row_offset(ny);
+            for(int nx = x - 1; nx <= x + 1; ++nx) {
+                if((u32)nx < num_of_cols && (nx != x || ny != y))
+                    fn(nx, ny, cells[row + col_offset(nx)]);
+            }
+        }
+    }
+
+    template <typename T, u32 BLOCK_SHIFT>
+    template <typename Grid, typename Fn>
+    void grid2d<T, BLOCK_SHIFT>::region(Grid& grid, int x, int y, int width, int height, Fn&& fn)
+    {
+        const u32 x0 = (u32)std::max(x, 0);
+        const u32 y0 = (u32)std::max(y, 0);
+        const u32 x1 = (u32)std::clamp(x + width, 0, (int)grid.num_of_cols);
+        const u32 y1 = (u32)std::clamp(y + height, 0, (int)grid.num_of_rows);
+        if(x0 >= x1 || y0 >= y1)
+            return;
+
+        for(u32 by = y0 & ~CELL_MASK; by < y1; by += BLOCK_SIZE) {
+            const u32 row_begin = std::max(by, y0);
+            const u32 row_end = std::min(by + BLOCK_SIZE, y1);
+            for(u32 bx = x0 & ~CELL_MASK; bx < x1; bx += BLOCK_SIZE) {
+                const u32 col_begin = std::max(bx, x0);
+                const u32 col_end = std::min(bx + BLOCK_SIZE, x1);
+                for(u32 cy = row_begin; cy < row_end; ++cy) {
+                    const size_t row = grid.row_offset(cy);
+                    for(u32 cx = col_begin; cx < col_end; ++cx)
+                        fn(cx, cy, grid.cells[row + col_offset(cx)]);
+                }
+            }
+        }
+    }
+
+    template <typename T, u32 BLOCK_SHIFT>
+    template <typename Fn>
+    void grid2d<T, BLOCK_SHIFT>::for_each_in_region(int x, int y, int width, int height, Fn&& fn)
+    {
+        region(*this, x, y, width, height, fn);
+    }
+
+    template <typename T, u32 BLOCK_SHIFT>
+    template <typename Fn>
+    void grid2d<T, BLOCK_SHIFT>::for_each_in_region(int x, int y, int width, int height,
+                                                    Fn&& fn) const
+    {
+        region(*this, x, y, width, height, fn);
+    }
+
+    template <typename T, u32 BLOCK_SHIFT>
+    void grid2d<T, BLOCK_SHIFT>::copy_window(int x, int y, u32 width, u32 height, T* out,
+                                             const T& outside) const
+    {
+        for(u32 wy = 0; wy < height; ++wy, out += width) {
+            const int cy = y + (int)wy;
+            if((u32)cy >= num_of_rows) {
+                std::fill(out, out + width, outside);
+                continue;
+            }
+
+            const size_t row = row_offset(cy);
+            for(u32 wx = 0; wx < width; ++wx) {
+                const int cx = x + (int)wx;
+                out[wx] = (u32)cx < num_of_cols ? cells[row + col_offset(cx)] : outside;
+            }
+        }
+    }
+}
+
+#endif //SCARECROW2D_GRID2D_H
@@ -0,0 +1,235 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_MPMC_QUEUE_H
+#define SCARECROW2D_MPMC_QUEUE_H
+
+#include "core/compiler.h"
+#include "memory/memory.h"
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sc2d
+{
+
+    /**
+     * Bounded lock-free queue for many producer and many consumer threads.
+     * Every cell has a sequence number telling whether it is ready for the producer or
+     * the consumer of a given position, so a thread claims a position with one CAS
+     * and publishes the cell with one store, no locks or per-item allocations.
+     * @tparam T element type
+     */
+    template <typename T>
+    class mpmc_queue
+    {
+    public:
+        /**
+         * @param capacity rounded up to a power of two
+         */
+        explicit mpmc_queue(size_t capacity);
+        ~mpmc_queue();
+        mpmc_queue(const mpmc_queue&) = delete;
+        mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+        template <typename... Args>
+        bool try_emplace(Args&&... args);
+        bool try_push(const T& data);
+        bool try_push(T&& data);
+        /**
+         * Claims up to count consecutive cells with a single CAS.
+         * @return number of pushed items, may be less than count when the queue fills up
+         */
+        size_t push_batch(const T* items, size_t count);
+
+        bool try_pop(T& out);
+        /**
+         * Claims up to max_count consecutive items with a single CAS.
+         * @return number of items moved to out
+         */
+        size_t pop_batch(T* out, size_t max_count);
+
+        /**
+         * Approximate while other threads are working on the queue
+         */
+        size_t size() const
+        {
+            const size_t enq = enqueue_pos.load(std::memory_order_acquire);
+            const size_t deq = dequeue_pos.load(std::memory_order_acquire);
+            return enq > deq ? enq - deq : 0;
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        size_t capacity() const
+        {
+            return mask + 1;
+        }
+
+    private:
+        struct cell
+        {
+            std::atomic<size_t> sequence;
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            forceinline T* data()
+            {
+                return reinterpret_cast<T*>(storage);
+            }
+        };
+
+        forceinline cell& cell_at(size_t pos) const
+        {
+            return cells[pos & mask];
+        }
+
+        /**
+         * Finds how many cells starting at 'pos' are in the state 'pos + i + offset'
+         * and claims them by moving 'position' forward.
+         * @return first claimed position in 'pos' and number of claimed cells
+         */
+        size_t claim(std::atomic<size_t>& position, size_t& pos, size_t count, size_t offset);
+
+        // Read-only after construction
+        alignas(COMPILER_CACHE_LINE_SIZE) cell* cells;
+        size_t mask;
+
+        alignas(COMPILER_CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos {0};
+        alignas(COMPILER_CACHE_LINE_SIZE) std::atomic<size_t> dequeue_pos {0};
+    };
+
+    template <typename T>
+    mpmc_queue<T>::mpmc_queue(size_t capacity)
+    {
+        size_t rounded = 2;
+        while(rounded < capacity)
+            rounded <<= 1u;
+        mask = rounded - 1;
+
+        constexpr size_t alignment =
+            alignof(cell) > COMPILER_CACHE_LINE_SIZE ? alignof(cell) : COMPILER_CACHE_LINE_SIZE;
+        const size_t bytes = (rounded * sizeof(cell) + alignment - 1) & ~(alignment - 1);
+        cells = reinterpret_cast<cell*>(malloc_aligned(bytes, alignment));
+        for(size_t i = 0; i < rounded; ++i)
+            new(&cells[i].sequence) std::atomic<size_t>(i);
+    }
+
+    template <typename T>
+    mpmc_queue<T>::~mpmc_queue()
+    {
+        if constexpr(!std::is_trivially_destructible<T>::value) {
+            const size_t end = enqueue_pos.load(std::memory_order_relaxed);
+            for(size_t i = dequeue_pos.load(std::memory_order_relaxed); i != end; ++i)
+                cell_at(i).data()->~T();
+        }
+        free_aligned(cells);
+    }
+
+    template <typename T>
+    size_t mpmc_queue<T>::claim(std::atomic<size_t>& position, size_t& pos, size_t count,
+                                size_t offset)
+    {
+        pos = position.load(std::memory_order_relaxed);
+        if(count == 0)
+            return 0;
+
+        while(true) {
+            size_t n = 0;
+            for(; n < count; ++n) {
+                const size_t seq = cell_at(pos + n).sequence.load(std::memory_order_acquire);
+                if(seq != pos + n + offset)
+                    break;
+            }
+
+            if(n > 0) {
+                // Cells can't change state until their position is claimed
+                if(position.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed))
+                    return n;
+                continue;
+            }
+
+            const size_t seq = cell_at(pos).sequence.load(std::memory_order_acquire);
+            if((intptr_t)(seq - (pos + offset)) < 0)
+                return 0; // Full for producers, empty for consumers
+            // Another thread claimed 'pos' already
+            pos = position.load(std::memory_order_relaxed);
+        }
+    }
+
+    template <typename T>
+    template <typename... Args>
+    bool mpmc_queue<T>::try_emplace(Args&&... args)
+    {
+        size_t pos;
+        if(!claim(enqueue_pos, pos, 1, 0))
+            return false;
+
+        cell& c = cell_at(pos);
+        new(c.data()) T(std::forward<Args>(args)...);
+        c.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename T>
+    forceinline bool mpmc_queue<T>::try_push(const T& data)
+    {
+        return try_emplace(data);
+    }
+
+    template <typename T>
+    forceinline bool mpmc_queue<T>::try_push(T&& data)
+    {
+        return try_emplace(std::move(data));
+    }
+
+    template <typename T>
+    size_t mpmc_queue<T>::push_batch(const T* items, size_t count)
+    {
+        size_t pos;
+        const size_t n = claim(enqueue_pos, pos, count, 0);
+        for(size_t i = 0; i < n; ++i) {
+            cell& c = cell_at(pos + i);
+            new(c.data()) T(items[i]);
+            c.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return n;
+    }
+
+    template <typename T>
+    bool mpmc_queue<T>::try_pop(T& out)
+    {
+        size_t pos;
+        if(!claim(dequeue_pos, pos, 1, 1))
+            return false;
+
+        cell& c = cell_at(pos);
+        T* item = c.data();
+        out = std::move(*item);
+        item->~T();
+        c.sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename T>
+    size_t mpmc_queue<T>::pop_batch(T* out, size_t max_count)
+    {
+        size_t pos;
+        const size_t n = claim(dequeue_pos, pos, max_count, 1);
+        for(size_t i = 0; i < n; ++i) {
+            cell& c = cell_at(pos + i);
+            T* item = c.data();
+            out[i] = std::move(*item);
+            item->~T();
+            c.sequence.store(pos + i + mask + 1, std::memory_order_release);
+        }
+        return n;
+    }
+}
+
+#endif //SCARECROW2D_MPMC_QUEUE_H
@@ -11,6 +11,7 @@
 // WIP
 // TODO:  ------------------- Write tests and benchmarks -------------------
 // TODO: add pool alloc support
+// For passing data between threads use spsc_queue / mpmc_queue
 
 
 namespace sc2d
@@ -20,6 +21,10 @@ namespace sc2d
     class queue
     {
     public:
+        queue() = default;
+        ~queue();
+        queue(const queue&) = delete;
+        queue& operator=(const queue&) = delete;
 
         T push(const T& t);
         T& front() const {return head->data;}
@@ -27,9 +32,9 @@ namespace sc2d
         bool empty();
     private:
         struct node;
-        u32 length;
-        node* head;
-        node* tail;
+        u32 length = 0;
+        node* head = nullptr;
+        node* tail = nullptr;
     };
 
     template<typename T>
@@ -40,6 +45,16 @@ namespace sc2d
         T data;
         node* next;
     };
+    template <typename T>
+    queue<T>::~queue()
+    {
+        while(head) {
+            node* n = head;
+            head = head->next;
+            delete n;
+        }
+    }
+
     template<typename T>
     T queue<T>::push(const T& t)
     {
@@ -62,7 +77,7 @@ namespace sc2d
         head = head->next;
         delete n;
         if(--length == 0)
-            tail == nullptr;
+            tail = nullptr;
     }
 
     template <typename T>
@@ -0,0 +1,69 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_RADIX_SORT_H
+#define SCARECROW2D_RADIX_SORT_H
+
+#include "core/types.h"
+#include <algorithm>
+#include <utility>
+
+namespace sc2d
+{
+    /**
+     * Below this count radix_sort64 falls back to std::stable_sort
+     */
+    constexpr size_t RADIX_SORT_MIN_COUNT = 64;
+
+    /**
+     * Stable LSD radix sort by a 64-bit key, 8 bits per pass.
+     * All byte histograms are built in one pass over the keys, and passes where every key
+     * has the same byte are skipped, so unused high key bits cost nothing.
+     * @param items sorted in place
+     * @param scratch buffer of at least count items
+     * @param key_of u64 key_of(const T&), called several times per item so keep it cheap
+     */
+    template <typename T, typename KeyFn>
+    void radix_sort64(T* items, T* scratch, size_t count, KeyFn&& key_of)
+    {
+        if(count < RADIX_SORT_MIN_COUNT) {
+            std::stable_sort(items, items + count, [&](const T& a, const T& b) {
+                return key_of(a) < key_of(b);
+            });
+            return;
+        }
+
+        constexpr u32 PASSES = 8;
+        size_t histograms[PASSES][256] = {};
+        for(size_t i = 0; i < count; ++i) {
+            const u64 key = key_of(items[i]);
+            for(u32 pass = 0; pass < PASSES; ++pass)
+                ++histograms[pass][(key >> (pass * 8u)) & 0xffu];
+        }
+
+        T* src = items;
+        T* dst = scratch;
+        for(u32 pass = 0; pass < PASSES; ++pass) {
+            size_t* offsets = histograms[pass];
+            const u32 shift = pass * 8u;
+            if(offsets[(key_of(src[0]) >> shift) & 0xffu] == count)
+                continue;
+
+            size_t sum = 0;
+            for(u32 digit = 0; digit < 256; ++digit) {
+                const size_t digit_count = offsets[digit];
+                offsets[digit] = sum;
+                sum += digit_count;
+            }
+            for(size_t i = 0; i < count; ++i)
+                dst[offsets[(key_of(src[i]) >> shift) & 0xffu]++] = std::move(src[i]);
+            std::swap(src, dst);
+        }
+
+        if(src != items)
+            std::move(src, src + count, items);
+    }
+}
+
+#endif //SCARECROW2D_RADIX_SORT_H
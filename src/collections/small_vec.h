@@ -0,0 +1,499 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_SMALL_VEC_H
+#define SCARECROW2D_SMALL_VEC_H
+
+#include "core/compiler.h"
+#include "memory/memory.h"
+#include "memory/relocatable.h"
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sc2d
+{
+
+    /**
+     * Vector with inline storage for N elements.
+     * Heap is used only when the size grows past N, an empty small_vec allocates nothing.
+     * @tparam T element type
+     * @tparam N number of elements stored inline
+     */
+    template <typename T, size_t N>
+    class small_vec
+    {
+        static_assert(N > 0, "small_vec needs at least one inline element");
+
+    public:
+        using value_type = T;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        using size_type = size_t;
+        using IS_T_RELOCATABLE = memory::is_trivially_relocatable<T>;
+
+        small_vec() noexcept = default;
+        explicit small_vec(size_type n);
+        small_vec(size_type n, const T& data);
+        small_vec(std::initializer_list<T> ilist);
+        small_vec(const small_vec& other);
+        small_vec(small_vec&& other) noexcept;
+        ~small_vec();
+
+        small_vec& operator=(const small_vec& other);
+        small_vec& operator=(small_vec&& other) noexcept;
+
+        iterator begin() noexcept
+        {
+            return array;
+        }
+        iterator end() noexcept
+        {
+            return array + length;
+        }
+        const_iterator begin() const noexcept
+        {
+            return array;
+        }
+        const_iterator end() const noexcept
+        {
+            return array + length;
+        }
+        const_iterator cbegin() const noexcept
+        {
+            return array;
+        }
+        const_iterator cend() const noexcept
+        {
+            return array + length;
+        }
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        bool empty() const noexcept
+        {
+            return length == 0;
+        }
+        size_type size() const noexcept
+        {
+            return length;
+        }
+        size_type capacity() const noexcept
+        {
+            return cap;
+        }
+        /**
+         * @return true while elements are kept in the inline buffer
+         */
+        bool is_inline() const noexcept
+        {
+            return array == inline_data();
+        }
+
+        void reserve(size_type new_cap);
+        void resize(size_type new_size);
+        void resize(size_type new_size, const T& data);
+        void shrink_to_fit();
+        void clear() noexcept;
+
+        reference operator[](size_type index)
+        {
+            return array[index];
+        }
+        const_reference operator[](size_type index) const
+        {
+            return array[index];
+        }
+        reference front()
+        {
+            return array[0];
+        }
+        const_reference front() const
+        {
+            return array[0];
+        }
+        reference back()
+        {
+            return array[length - 1];
+        }
+        const_reference back() const
+        {
+            return array[length - 1];
+        }
+        T* data() noexcept
+        {
+            return array;
+        }
+        const T* data() const noexcept
+        {
+            return array;
+        }
+
+        template <typename... Args>
+        reference emplace_back(Args&&... args);
+        void push_back(const T& data);
+        void push_back(T&& data);
+        void pop_back();
+
+        iterator insert(const_iterator pos, const T& data);
+        iterator insert(const_iterator pos, T&& data);
+        iterator erase(const_iterator pos);
+        iterator erase(const_iterator first, const_iterator last);
+
+        bool operator==(const small_vec& other) const;
+        bool operator!=(const small_vec& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        forceinline T* inline_data() noexcept
+        {
+            return reinterpret_cast<T*>(storage);
+        }
+        forceinline const T* inline_data() const noexcept
+        {
+            return reinterpret_cast<const T*>(storage);
+        }
+
+        void grow(size_type min_cap);
+        template <typename... Args>
+        reference grow_emplace_back(Args&&... args);
+        static T* allocate_heap(size_type new_cap);
+        void reallocate(size_type new_cap);
+        void release_heap();
+        static void relocate(T* dest, T* src, size_type count);
+        iterator make_gap(const_iterator pos);
+
+        T* array = inline_data();
+        size_type length = 0;
+        size_type cap = N;
+        alignas(T) unsigned char storage[sizeof(T) * N];
+    };
+
+    template <typename T, size_t N>
+    small_vec<T, N>::small_vec(size_type n)
+    {
+        resize(n);
+    }
+
+    template <typename T, size_t N>
+    small_vec<T, N>::small_vec(size_type n, const T& data)
+    {
+        resize(n, data);
+    }
+
+    template <typename T, size_t N>
+    small_vec<T, N>::small_vec(std::initializer_list<T> ilist)
+    {
+        reserve(ilist.size());
+        for(const auto& item : ilist)
+            new(array + length++) T(item);
+    }
+
+    template <typename T, size_t N>
+    small_vec<T, N>::small_vec(const small_vec& other)
+    {
+        reserve(other.length);
+        for(size_type i = 0; i < other.length; ++i)
+            new(array + i) T(other.array[i]);
+        length = other.length;
+    }
+
+    template <typename T, size_t N>
+    small_vec<T, N>::small_vec(small_vec&& other) noexcept
+    {
+        if(!other.is_inline()) {
+            // Stealing heap buffer
+            array = other.array;
+            cap = other.cap;
+            length = other.length;
+            other.array = other.inline_data();
+            other.cap = N;
+            other.length = 0;
+        } else {
+            relocate(array, other.array, other.length);
+            length = other.length;
+            other.length = 0;
+        }
+    }
+
+    template <typename T, size_t N>
+    small_vec<T, N>::~small_vec()
+    {
+        clear();
+        release_heap();
+    }
+
+    template <typename T, size_t N>
+    small_vec<T, N>& small_vec<T, N>::operator=(const small_vec& other)
+    {
+        if(this != &other) {
+            clear();
+            reserve(other.length);
+            for(size_type i = 0; i < other.length; ++i)
+                new(array + i) T(other.array[i]);
+            length = other.length;
+        }
+        return *this;
+    }
+
+    template <typename T, size_t N>
+    small_vec<T, N>& small_vec<T, N>::operator=(small_vec&& other) noexcept
+    {
+        if(this != &other) {
+            clear();
+            release_heap();
+            new(this) small_vec(std::move(other));
+        }
+        return *this;
+    }
+
+    template <typename T, size_t N>
+    void small_vec<T, N>::reserve(size_type new_cap)
+    {
+        if(new_cap > cap)
+            reallocate(new_cap);
+    }
+
+    template <typename T, size_t N>
+    void small_vec<T, N>::resize(size_type new_size)
+    {
+        reserve(new_size);
+        for(size_type i = length; i < new_size; ++i)
+            new(array + i) T();
+        for(size_type i = new_size; i < length; ++i)
+            array[i].~T();
+        length = new_size;
+    }
+
+    template <typename T, size_t N>
+    void small_vec<T, N>::resize(size_type new_size, const T& data)
+    {
+        reserve(new_size);
+        for(size_type i = length; i < new_size; ++i)
+            new(array + i) T(data);
+        for(size_type i = new_size; i < length; ++i)
+            array[i].~T();
+        length = new_size;
+    }
+
+    template <typename T, size_t N>
+    void small_vec<T, N>::shrink_to_fit()
+    {
+        if(!is_inline() && length < cap)
+            reallocate(length);
+    }
+
+    template <typename T, size_t N>
+    void small_vec<T, N>::clear() noexcept
+    {
+        if constexpr(!std::is_trivially_destructible<T>::value) {
+            for(size_type i = 0; i < length; ++i)
+                array[i].~T();
+        }
+        length = 0;
+    }
+
+    template <typename T, size_t N>
+    template <typename... Args>
+    typename small_vec<T, N>::reference small_vec<T, N>::emplace_back(Args&&... args)
+    {
+        if(length == cap)
+            return grow_emplace_back(std::forward<Args>(args)...);
+        return *new(array + length++) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T, size_t N>
+    forceinline void small_vec<T, N>::push_back(const T& data)
+    {
+        emplace_back(data);
+    }
+
+    template <typename T, size_t N>
+    forceinline void small_vec<T, N>::push_back(T&& data)
+    {
+        emplace_back(std::move(data));
+    }
+
+    template <typename T, size_t N>
+    void small_vec<T, N>::pop_back()
+    {
+        array[--length].~T();
+    }
+
+    template <typename T, size_t N>
+    typename small_vec<T, N>::iterator small_vec<T, N>::insert(const_iterator pos, const T& data)
+    {
+        T copy(data);
+        iterator gap = make_gap(pos);
+        new(gap) T(std::move(copy));
+        return gap;
+    }
+
+    template <typename T, size_t N>
+    typename small_vec<T, N>::iterator small_vec<T, N>::insert(const_iterator pos, T&& data)
+    {
+        // 'data' may point into this vector, the gap moves it
+        T moved(std::move(data));
+        iterator gap = make_gap(pos);
+        new(gap) T(std::move(moved));
+        return gap;
+    }
+
+    template <typename T, size_t N>
+    typename small_vec<T, N>::iterator small_vec<T, N>::erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    template <typename T, size_t N>
+    typename small_vec<T, N>::iterator small_vec<T, N>::erase(const_iterator first,
+                                                                const_iterator last)
+    {
+        iterator dest = array + (first - array);
+        const size_type count = last - first;
+        if(count == 0)
+            return dest;
+
+        if constexpr(IS_T_RELOCATABLE::value) {
+            if constexpr(!std::is_trivially_destructible<T>::value) {
+                for(iterator i = dest; i != dest + count; ++i)
+                    i->~T();
+            }
+            memmove((void*)dest, (const void*)last, (end() - last) * sizeof(T));
+        } else {
+            iterator src = array + (last - array);
+            for(iterator i = dest; src != end(); ++i, ++src)
+                *i = std::move(*src);
+            for(iterator i = end() - count; i != end(); ++i)
+                i->~T();
+        }
+        length -= count;
+        return dest;
+    }
+
+    template <typename T, size_t N>
+    bool small_vec<T, N>::operator==(const small_vec& other) const
+    {
+        if(length != other.length)
+            return false;
+        for(size_type i = 0; i < length; ++i) {
+            if(!(array[i] == other.array[i]))
+                return false;
+        }
+        return true;
+    }
+
+    template <typename T, size_t N>
+    void small_vec<T, N>::grow(size_type min_cap)
+    {
+        const size_type doubled = cap << 1u;
+        reallocate(doubled > min_cap ? doubled : min_cap);
+    }
+
+    template <typename T, size_t N>
+    template <typename... Args>
+    typename small_vec<T, N>::reference small_vec<T, N>::grow_emplace_back(Args&&... args)
+    {
+        // 'args' may point into this vector, the element is built before the old storage goes.
+        // Growing a full vector always leaves the inline storage
+        const size_type doubled = cap << 1u;
+        const size_type new_cap = doubled > length + 1 ? doubled : length + 1;
+        T* new_array = allocate_heap(new_cap);
+        new(new_array + length) T(std::forward<Args>(args)...);
+
+        relocate(new_array, array, length);
+        release_heap();
+        array = new_array;
+        cap = new_cap;
+        return array[length++];
+    }
+
+    template <typename T, size_t N>
+    T* small_vec<T, N>::allocate_heap(size_type new_cap)
+    {
+        constexpr size_t alignment = alignof(T) > sizeof(void*) ? alignof(T) : sizeof(void*);
+        const size_t bytes = (new_cap * sizeof(T) + alignment - 1) & ~(alignment - 1);
+        return reinterpret_cast<T*>(malloc_aligned(bytes, alignment));
+    }
+
+    template <typename T, size_t N>
+    void small_vec<T, N>::reallocate(size_type new_cap)
+    {
+        T* new_array;
+        if(new_cap <= N) {
+            if(is_inline())
+                return;
+            new_array = inline_data();
+            new_cap = N;
+        } else {
+            new_array = allocate_heap(new_cap);
+        }
+
+        relocate(new_array, array, length);
+        release_heap();
+        array = new_array;
+        cap = new_cap;
+    }
+
+    template <typename T, size_t N>
+    forceinline void small_vec<T, N>::release_heap()
+    {
+        if(!is_inline()) {
+            free_aligned(array);
+            array = inline_data();
+            cap = N;
+        }
+    }
+
+    template <typename T, size_t N>
+    void small_vec<T, N>::relocate(T* dest, T* src, size_type count)
+    {
+        if constexpr(IS_T_RELOCATABLE::value) {
+            if(count)
+                memcpy((void*)dest, (const void*)src, count * sizeof(T));
+        } else {
+            for(size_type i = 0; i < count; ++i) {
+                new(dest + i) T(std::move(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+
+    template <typename T, size_t N>
+    typename small_vec<T, N>::iterator small_vec<T, N>::make_gap(const_iterator pos)
+    {
+        const size_type index = pos - array;
+        if(length == cap)
+            grow(length + 1);
+
+        iterator gap = array + index;
+        if constexpr(IS_T_RELOCATABLE::value) {
+            memmove((void*)(gap + 1), (const void*)gap, (length - index) * sizeof(T));
+        } else if(index < length) {
+            new(array + length) T(std::move(array[length - 1]));
+            for(iterator i = array + length - 1; i != gap; --i)
+                *i = std::move(*(i - 1));
+            gap->~T();
+        }
+        ++length;
+        return gap;
+    }
+}
+
+#endif //SCARECROW2D_SMALL_VEC_H
@@ -0,0 +1,524 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_SOA_VEC_H
+#define SCARECROW2D_SOA_VEC_H
+
+#include "core/compiler.h"
+#include "core/types.h"
+#include "memory/memory.h"
+#include "memory/relocatable.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sc2d
+{
+    /**
+     * View of one field array of soa_vec
+     */
+    template <typename T>
+    class field_span
+    {
+    public:
+        field_span(T* values, size_t count)
+            : ptr(values)
+            , length(count)
+        { }
+
+        T& operator[](size_t index) const
+        {
+            return ptr[index];
+        }
+
+        T* data() const
+        {
+            return ptr;
+        }
+
+        size_t size() const
+        {
+            return length;
+        }
+
+        T* begin() const
+        {
+            return ptr;
+        }
+
+        T* end() const
+        {
+            return ptr + length;
+        }
+
+    private:
+        T* ptr;
+        size_t length;
+    };
+
+    /**
+     * Vector that stores every field in its own array (struct of arrays).
+     * All arrays share size and capacity and live in one allocation, each one aligned
+     * to SIMD register width, so kernels can stream just the fields they need.
+     * Elements are accessed as tuples of references: auto [pos, size] = items[i];
+     * @tparam Ts field types
+     */
+    template <typename... Ts>
+    class soa_vec
+    {
+        static_assert(sizeof...(Ts) > 0, "soa_vec needs at least one field");
+
+    public:
+        static constexpr size_t FIELD_COUNT = sizeof...(Ts);
+        static constexpr size_t ALIGNMENT = std::max({size_t(32), alignof(Ts)...});
+
+        template <size_t I>
+        using field_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+        using reference = std::tuple<Ts&...>;
+        using const_reference = std::tuple<const Ts&...>;
+
+        template <bool IS_CONST>
+        class iterator_base
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::tuple<Ts...>;
+            using difference_type = ptrdiff_t;
+            using reference = std::conditional_t<IS_CONST, const_reference, soa_vec::reference>;
+            using pointer = void;
+            using owner_t = std::conditional_t<IS_CONST, const soa_vec, soa_vec>;
+
+            iterator_base(owner_t* vec, size_t at)
+                : owner(vec)
+                , index(at)
+            { }
+
+            reference operator*() const
+            {
+                return (*owner)[index];
+            }
+
+            iterator_base& operator++()
+            {
+                ++index;
+                return *this;
+            }
+
+            iterator_base& operator--()
+            {
+                --index;
+                return *this;
+            }
+
+            iterator_base& operator+=(difference_type n)
+            {
+                index += n;
+                return *this;
+            }
+
+            iterator_base operator+(difference_type n) const
+            {
+                return iterator_base(owner, index + n);
+            }
+
+            difference_type operator-(const iterator_base& other) const
+            {
+                return (difference_type)index - (difference_type)other.index;
+            }
+
+            bool operator==(const iterator_base& other) const
+            {
+                return index == other.index;
+            }
+
+            bool operator!=(const iterator_base& other) const
+            {
+                return index != other.index;
+            }
+
+        private:
+            owner_t* owner;
+            size_t index;
+        };
+
+        using iterator = iterator_base<false>;
+        using const_iterator = iterator_base<true>;
+
+        soa_vec() = default;
+        explicit soa_vec(size_t capacity);
+        soa_vec(const soa_vec& other);
+        soa_vec(soa_vec&& other) noexcept;
+        ~soa_vec();
+
+        soa_vec& operator=(const soa_vec& other);
+        soa_vec& operator=(soa_vec&& other) noexcept;
+
+        size_t size() const
+        {
+            return length;
+        }
+
+        size_t capacity() const
+        {
+            return cap;
+        }
+
+        bool empty() const
+        {
+            return length == 0;
+        }
+
+        void reserve(size_t new_capacity);
+        /**
+         * New elements are value initialized
+         */
+        void resize(size_t new_size);
+        void clear();
+
+        /**
+         * Constructs one field from every argument
+         */
+        template <typename... Args>
+        void emplace_back(Args&&... values);
+        void push_back(const Ts&... values)
+        {
+            emplace_back(values...);
+        }
+        void pop_back();
+
+        /**
+         * Appends count value initialized elements
+         * @return index of the first appended element
+         */
+        size_t append(size_t count);
+
+        /**
+         * Appends count elements copied from one source array per field
+         */
+        void append(size_t count, const Ts*... sources);
+
+        /**
+         * Removes [first, last), keeps order of the remaining elements
+         */
+        void erase(size_t first, size_t last);
+        void erase(size_t index)
+        {
+            erase(index, index + 1);
+        }
+
+        /**
+         * Moves the last element into index, O(1) but changes order
+         */
+        void swap_erase(size_t index);
+
+        reference operator[](size_t index)
+        {
+            return element(index, std::index_sequence_for<Ts...> {});
+        }
+
+        const_reference operator[](size_t index) const
+        {
+            return element(index, std::index_sequence_for<Ts...> {});
+        }
+
+        template <size_t I>
+        field_type<I>* data()
+        {
+            return std::get<I>(arrays);
+        }
+
+        template <size_t I>
+        const field_type<I>* data() const
+        {
+            return std::get<I>(arrays);
+        }
+
+        template <size_t I>
+        field_span<field_type<I>> field()
+        {
+            return {std::get<I>(arrays), length};
+        }
+
+        template <size_t I>
+        field_span<const field_type<I>> field() const
+        {
+            return {std::get<I>(arrays), length};
+        }
+
+        iterator begin()
+        {
+            return iterator(this, 0);
+        }
+
+        iterator end()
+        {
+            return iterator(this, length);
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(this, 0);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(this, length);
+        }
+
+        void swap(soa_vec& other) noexcept;
+
+    private:
+        template <size_t... Is>
+        reference element(size_t index, std::index_sequence<Is...>)
+        {
+            return reference(std::get<Is>(arrays)[index]...);
+        }
+
+        template <size_t... Is>
+        const_reference element(size_t index, std::index_sequence<Is...>) const
+        {
+            return const_reference(std::get<Is>(arrays)[index]...);
+        }
+
+        /**
+         * Calls fn(field_array) for every field
+         */
+        template <typename Fn>
+        void for_each_field(Fn&& fn)
+        {
+            std::apply([&](auto*... array) { (fn(array), ...); }, arrays);
+        }
+
+        /**
+         * Calls fn(field_array, other_array) for every field
+         */
+        template <typename Tuple, typename Fn, size_t... Is>
+        void for_each_field_pair(const Tuple& other, Fn&& fn, std::index_sequence<Is...>)
+        {
+            (fn(std::get<Is>(arrays), std::get<Is>(other)), ...);
+        }
+
+        template <size_t... Is>
+        static std::tuple<Ts*...> field_arrays(u8* base, const size_t* offsets,
+                                               std::index_sequence<Is...>)
+        {
+            return std::tuple<Ts*...>(reinterpret_cast<Ts*>(base + offsets[Is])...);
+        }
+
+        void grow(size_t min_capacity)
+        {
+            reserve(std::max(cap * 2, min_capacity));
+        }
+
+        static constexpr size_t align_up(size_t value)
+        {
+            return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        }
+
+        void* memory = nullptr;
+        std::tuple<Ts*...> arrays {};
+        size_t length = 0;
+        size_t cap = 0;
+    };
+
+    template <typename... Ts>
+    soa_vec<Ts...>::soa_vec(size_t capacity)
+    {
+        reserve(capacity);
+    }
+
+    template <typename... Ts>
+    soa_vec<Ts...>::soa_vec(const soa_vec& other)
+    {
+        reserve(other.length);
+        for_each_field_pair(other.arrays,
+                            [&](auto* dst, const auto* src) {
+                                std::uninitialized_copy(src, src + other.length, dst);
+                            },
+                            std::index_sequence_for<Ts...> {});
+        length = other.length;
+    }
+
+    template <typename... Ts>
+    soa_vec<Ts...>::soa_vec(soa_vec&& other) noexcept
+    {
+        swap(other);
+    }
+
+    template <typename... Ts>
+    soa_vec<Ts...>::~soa_vec()
+    {
+        clear();
+        if(memory)
+            free_aligned(memory);
+    }
+
+    template <typename... Ts>
+    soa_vec<Ts...>& soa_vec<Ts...>::operator=(const soa_vec& other)
+    {
+        if(this != &other) {
+            soa_vec copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    template <typename... Ts>
+    soa_vec<Ts...>& soa_vec<Ts...>::operator=(soa_vec&& other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    template <typename... Ts>
+    void soa_vec<Ts...>::swap(soa_vec& other) noexcept
+    {
+        std::swap(memory, other.memory);
+        std::swap(arrays, other.arrays);
+        std::swap(length, other.length);
+        std::swap(cap, other.cap);
+    }
+
+    template <typename... Ts>
+    void soa_vec<Ts...>::reserve(size_t new_capacity)
+    {
+        if(new_capacity <= cap)
+            return;
+
+        size_t offsets[FIELD_COUNT];
+        size_t bytes = 0;
+        const size_t sizes[FIELD_COUNT] = {sizeof(Ts)...};
+        for(size_t i = 0; i < FIELD_COUNT; ++i) {
+            offsets[i] = bytes;
+            bytes = align_up(bytes + sizes[i] * new_capacity);
+        }
+
+        void* new_memory = malloc_aligned(bytes, ALIGNMENT);
+        const std::tuple<Ts*...> new_arrays =
+            field_arrays(static_cast<u8*>(new_memory), offsets, std::index_sequence_for<Ts...> {});
+
+        for_each_field_pair(new_arrays,
+                            [&](auto* old_array, auto* new_array) {
+                                using T = std::remove_pointer_t<decltype(old_array)>;
+                                if constexpr(memory::is_trivially_relocatable_v<T>) {
+                                    if(length)
+                                        memcpy((void*)new_array, (const void*)old_array,
+                                               length * sizeof(T));
+                                } else {
+                                    for(size_t i = 0; i < length; ++i) {
+                                        new(new_array + i) T(std::move(old_array[i]));
+                                        old_array[i].~T();
+                                    }
+                                }
+                            },
+                            std::index_sequence_for<Ts...> {});
+
+        if(memory)
+            free_aligned(memory);
+        memory = new_memory;
+        arrays = new_arrays;
+        cap = new_capacity;
+    }
+
+    template <typename... Ts>
+    void soa_vec<Ts...>::resize(size_t new_size)
+    {
+        if(new_size > length)
+            append(new_size - length);
+        else
+            erase(new_size, length);
+    }
+
+    template <typename... Ts>
+    void soa_vec<Ts...>::clear()
+    {
+        erase(0, length);
+    }
+
+    template <typename... Ts>
+    template <typename... Args>
+    void soa_vec<Ts...>::emplace_back(Args&&... values)
+    {
+        static_assert(sizeof...(Args) == FIELD_COUNT, "emplace_back takes one value per field");
+        if(length == cap)
+            grow(length + 1);
+
+        std::apply([&](auto*... array) { (new(array + length) Ts(std::forward<Args>(values)), ...); },
+                   arrays);
+        ++length;
+    }
+
+    template <typename... Ts>
+    void soa_vec<Ts...>::pop_back()
+    {
+        erase(length - 1, length);
+    }
+
+    template <typename... Ts>
+    size_t soa_vec<Ts...>::append(size_t count)
+    {
+        const size_t first = length;
+        if(length + count > cap)
+            grow(length + count);
+
+        for_each_field([&](auto* array) {
+            using T = std::remove_pointer_t<decltype(array)>;
+            for(size_t i = first; i < first + count; ++i)
+                new(array + i) T();
+        });
+        length += count;
+        return first;
+    }
+
+    template <typename... Ts>
+    void soa_vec<Ts...>::append(size_t count, const Ts*... sources)
+    {
+        if(length + count > cap)
+            grow(length + count);
+
+        for_each_field_pair(std::tuple<const Ts*...>(sources...),
+                            [&](auto* dst, const auto* src) {
+                                std::uninitialized_copy(src, src + count, dst + length);
+                            },
+                            std::index_sequence_for<Ts...> {});
+        length += count;
+    }
+
+    template <typename... Ts>
+    void soa_vec<Ts...>::erase(size_t first, size_t last)
+    {
+        if(first >= last)
+            return;
+
+        for_each_field([&](auto* array) {
+            using T = std::remove_pointer_t<decltype(array)>;
+            std::move(array + last, array + length, array + first);
+            if constexpr(!std::is_trivially_destructible<T>::value) {
+                for(size_t i = length - (last - first); i < length; ++i)
+                    array[i].~T();
+            }
+        });
+        length -= last - first;
+    }
+
+    template <typename... Ts>
+    void soa_vec<Ts...>::swap_erase(size_t index)
+    {
+        const size_t back = length - 1;
+        for_each_field([&](auto* array) {
+            using T = std::remove_pointer_t<decltype(array)>;
+            if(index != back)
+                array[index] = std::move(array[back]);
+            array[back].~T();
+        });
+        --length;
+    }
+}
+
+#endif //SCARECROW2D_SOA_VEC_H
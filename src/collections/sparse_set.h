@@ -0,0 +1,278 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_SPARSE_SET_H
+#define SCARECROW2D_SPARSE_SET_H
+
+#include "core/dbg/dbg_asserts.h"
+#include "core/types.h"
+#include "memory/pool_handle.h"
+#include <utility>
+#include <vector>
+
+namespace sc2d
+{
+    /**
+     * Handle to dense position mapping of sparse_set, without the values.
+     * Lets type-erased storage (ECS component arrays) keep its own dense memory:
+     * the caller mirrors the swap-remove reported by erase().
+     */
+    class sparse_index
+    {
+    public:
+        /**
+         * Maps a new handle to dense position size()
+         */
+        memory::pool_handle insert();
+
+        /**
+         * Removes handle by moving the last dense position into its place.
+         * @return dense position of the erased handle, the caller moves its last element there
+         */
+        u32 erase(memory::pool_handle handle);
+        void clear();
+
+        bool contains(memory::pool_handle handle) const
+        {
+            const u32 index = handle.index();
+            return index < sparse.size() && sparse[index].dense != FREE
+                   && sparse[index].generation == handle.generation();
+        }
+
+        /**
+         * Handle must be alive
+         */
+        u32 dense_index(memory::pool_handle handle) const
+        {
+            return sparse[handle.index()].dense;
+        }
+
+        /**
+         * Handle of the element at dense position
+         */
+        memory::pool_handle handle_at(u32 dense_pos) const
+        {
+            const u32 index = dense_owners[dense_pos];
+            return memory::pool_handle(index, sparse[index].generation);
+        }
+
+        size_t size() const
+        {
+            return dense_owners.size();
+        }
+
+        bool empty() const
+        {
+            return dense_owners.empty();
+        }
+
+        void reserve(size_t capacity)
+        {
+            sparse.reserve(capacity);
+            dense_owners.reserve(capacity);
+        }
+
+    private:
+        static constexpr u32 FREE = 0xffffffff;
+
+        struct slot
+        {
+            u32 dense;
+            u32 generation;
+        };
+
+        // handle index -> dense position and generation
+        std::vector<slot> sparse;
+        // dense position -> handle index
+        std::vector<u32> dense_owners;
+        std::vector<u32> free_slots;
+    };
+
+    inline memory::pool_handle sparse_index::insert()
+    {
+        u32 index;
+        if(!free_slots.empty()) {
+            index = free_slots.back();
+            free_slots.pop_back();
+        } else {
+            index = (u32)sparse.size();
+            DBG_FAIL_IF(index > memory::pool_handle::INDEX_MASK - 1,
+                        "sparse_set handle index overflow")
+            sparse.push_back({FREE, 0});
+        }
+
+        sparse[index].dense = (u32)dense_owners.size();
+        dense_owners.push_back(index);
+        return memory::pool_handle(index, sparse[index].generation);
+    }
+
+    inline u32 sparse_index::erase(memory::pool_handle handle)
+    {
+        slot& s = sparse[handle.index()];
+        const u32 pos = s.dense;
+        const u32 last_owner = dense_owners.back();
+
+        dense_owners[pos] = last_owner;
+        sparse[last_owner].dense = pos;
+        dense_owners.pop_back();
+
+        s.dense = FREE;
+        s.generation = (s.generation + 1) & memory::pool_handle::GENERATION_MASK;
+        free_slots.push_back(handle.index());
+        return pos;
+    }
+
+    inline void sparse_index::clear()
+    {
+        for(u32 owner : dense_owners) {
+            slot& s = sparse[owner];
+            s.dense = FREE;
+            s.generation = (s.generation + 1) & memory::pool_handle::GENERATION_MASK;
+            free_slots.push_back(owner);
+        }
+        dense_owners.clear();
+    }
+
+    /**
+     * Values in one contiguous array, addressed with generational handles.
+     * Insert, erase and lookup are O(1): erase moves the last value into the hole,
+     * so iteration order changes but handles stay valid.
+     * @tparam T value type
+     */
+    template <typename T>
+    class sparse_set
+    {
+    public:
+        template <typename... Args>
+        memory::pool_handle emplace(Args&&... args);
+
+        memory::pool_handle insert(const T& value)
+        {
+            return emplace(value);
+        }
+
+        memory::pool_handle insert(T&& value)
+        {
+            return emplace(std::move(value));
+        }
+
+        /**
+         * Does nothing for dead handles
+         * @return true if a value was erased
+         */
+        bool erase(memory::pool_handle handle);
+        void clear();
+
+        bool contains(memory::pool_handle handle) const
+        {
+            return index.contains(handle);
+        }
+
+        /**
+         * @return value or nullptr for dead handles
+         */
+        T* get(memory::pool_handle handle);
+        const T* get(memory::pool_handle handle) const;
+
+        /**
+         * Handle of the value at dense position, for iterating with handles
+         */
+        memory::pool_handle handle_at(size_t dense_pos) const
+        {
+            return index.handle_at((u32)dense_pos);
+        }
+
+        size_t size() const
+        {
+            return dense.size();
+        }
+
+        bool empty() const
+        {
+            return dense.empty();
+        }
+
+        void reserve(size_t capacity)
+        {
+            index.reserve(capacity);
+            dense.reserve(capacity);
+        }
+
+        T* data()
+        {
+            return dense.data();
+        }
+
+        const T* data() const
+        {
+            return dense.data();
+        }
+
+        T* begin()
+        {
+            return dense.data();
+        }
+
+        T* end()
+        {
+            return dense.data() + dense.size();
+        }
+
+        const T* begin() const
+        {
+            return dense.data();
+        }
+
+        const T* end() const
+        {
+            return dense.data() + dense.size();
+        }
+
+    private:
+        sparse_index index;
+        std::vector<T> dense;
+    };
+
+    template <typename T>
+    template <typename... Args>
+    memory::pool_handle sparse_set<T>::emplace(Args&&... args)
+    {
+        dense.emplace_back(std::forward<Args>(args)...);
+        return index.insert();
+    }
+
+    template <typename T>
+    bool sparse_set<T>::erase(memory::pool_handle handle)
+    {
+        if(!index.contains(handle))
+            return false;
+
+        const u32 pos = index.erase(handle);
+        if(pos != dense.size() - 1)
+            dense[pos] = std::move(dense.back());
+        dense.pop_back();
+        return true;
+    }
+
+    template <typename T>
+    void sparse_set<T>::clear()
+    {
+        index.clear();
+        dense.clear();
+    }
+
+    template <typename T>
+    forceinline T* sparse_set<T>::get(memory::pool_handle handle)
+    {
+        return index.contains(handle) ? &dense[index.dense_index(handle)] : nullptr;
+    }
+
+    template <typename T>
+    forceinline const T* sparse_set<T>::get(memory::pool_handle handle) const
+    {
+        return index.contains(handle) ? &dense[index.dense_index(handle)] : nullptr;
+    }
+}
+
+#endif //SCARECROW2D_SPARSE_SET_H
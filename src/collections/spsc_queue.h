@@ -0,0 +1,226 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_SPSC_QUEUE_H
+#define SCARECROW2D_SPSC_QUEUE_H
+
+#include "core/compiler.h"
+#include "memory/memory.h"
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sc2d
+{
+
+    /**
+     * Fixed-capacity ring buffer for one producer and one consumer thread.
+     * Both sides are wait-free: every call finishes in a bounded number of steps
+     * and fails instead of blocking when the queue is full / empty.
+     * Each side keeps a cached copy of the other side's index on its own cache line,
+     * so the shared indices are read only when the cached one says full / empty.
+     * @tparam T element type
+     */
+    template <typename T>
+    class spsc_queue
+    {
+    public:
+        /**
+         * @param capacity rounded up to a power of two
+         */
+        explicit spsc_queue(size_t capacity);
+        ~spsc_queue();
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue& operator=(const spsc_queue&) = delete;
+
+        // Producer side
+
+        template <typename... Args>
+        bool try_emplace(Args&&... args);
+        bool try_push(const T& data);
+        bool try_push(T&& data);
+        /**
+         * @return number of pushed items, may be less than count when the queue fills up
+         */
+        size_t push_batch(const T* items, size_t count);
+
+        // Consumer side
+
+        bool try_pop(T& out);
+        /**
+         * @return number of items moved to out, up to max_count
+         */
+        size_t pop_batch(T* out, size_t max_count);
+
+        /**
+         * Approximate when called while the other thread is working on the queue
+         */
+        size_t size() const
+        {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        size_t capacity() const
+        {
+            return mask + 1;
+        }
+
+    private:
+        forceinline T* slot(size_t index) const
+        {
+            return buffer + (index & mask);
+        }
+
+        // Written by producer
+        alignas(COMPILER_CACHE_LINE_SIZE) std::atomic<size_t> tail {0};
+        size_t cached_head = 0;
+
+        // Written by consumer
+        alignas(COMPILER_CACHE_LINE_SIZE) std::atomic<size_t> head {0};
+        size_t cached_tail = 0;
+
+        // Read-only after construction
+        alignas(COMPILER_CACHE_LINE_SIZE) T* buffer;
+        size_t mask;
+    };
+
+    template <typename T>
+    spsc_queue<T>::spsc_queue(size_t capacity)
+    {
+        size_t rounded = 2;
+        while(rounded < capacity)
+            rounded <<= 1u;
+        mask = rounded - 1;
+
+        constexpr size_t alignment =
+            alignof(T) > COMPILER_CACHE_LINE_SIZE ? alignof(T) : COMPILER_CACHE_LINE_SIZE;
+        const size_t bytes = (rounded * sizeof(T) + alignment - 1) & ~(alignment - 1);
+        buffer = reinterpret_cast<T*>(malloc_aligned(bytes, alignment));
+    }
+
+    template <typename T>
+    spsc_queue<T>::~spsc_queue()
+    {
+        if constexpr(!std::is_trivially_destructible<T>::value) {
+            const size_t end = tail.load(std::memory_order_relaxed);
+            for(size_t i = head.load(std::memory_order_relaxed); i != end; ++i)
+                slot(i)->~T();
+        }
+        free_aligned(buffer);
+    }
+
+    template <typename T>
+    template <typename... Args>
+    bool spsc_queue<T>::try_emplace(Args&&... args)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if(t - cached_head > mask) {
+            cached_head = head.load(std::memory_order_acquire);
+            if(t - cached_head > mask)
+                return false;
+        }
+
+        new(slot(t)) T(std::forward<Args>(args)...);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename T>
+    forceinline bool spsc_queue<T>::try_push(const T& data)
+    {
+        return try_emplace(data);
+    }
+
+    template <typename T>
+    forceinline bool spsc_queue<T>::try_push(T&& data)
+    {
+        return try_emplace(std::move(data));
+    }
+
+    template <typename T>
+    size_t spsc_queue<T>::push_batch(const T* items, size_t count)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        size_t free_slots = capacity() - (t - cached_head);
+        if(free_slots < count) {
+            cached_head = head.load(std::memory_order_acquire);
+            free_slots = capacity() - (t - cached_head);
+        }
+
+        const size_t n = count < free_slots ? count : free_slots;
+        if(n == 0)
+            return 0;
+
+        if constexpr(std::is_trivially_copyable<T>::value) {
+            // At most two runs, before and after the end of the buffer
+            const size_t first = t & mask;
+            const size_t first_run = n < capacity() - first ? n : capacity() - first;
+            memcpy((void*)(buffer + first), (const void*)items, first_run * sizeof(T));
+            memcpy((void*)buffer, (const void*)(items + first_run), (n - first_run) * sizeof(T));
+        } else {
+            for(size_t i = 0; i < n; ++i)
+                new(slot(t + i)) T(items[i]);
+        }
+
+        tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    template <typename T>
+    bool spsc_queue<T>::try_pop(T& out)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if(h == cached_tail) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if(h == cached_tail)
+                return false;
+        }
+
+        T* item = slot(h);
+        out = std::move(*item);
+        item->~T();
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename T>
+    size_t spsc_queue<T>::pop_batch(T* out, size_t max_count)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        size_t available = cached_tail - h;
+        if(available < max_count) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            available = cached_tail - h;
+        }
+
+        const size_t n = max_count < available ? max_count : available;
+        if(n == 0)
+            return 0;
+
+        if constexpr(std::is_trivially_copyable<T>::value) {
+            const size_t first = h & mask;
+            const size_t first_run = n < capacity() - first ? n : capacity() - first;
+            memcpy((void*)out, (const void*)(buffer + first), first_run * sizeof(T));
+            memcpy((void*)(out + first_run), (const void*)buffer, (n - first_run) * sizeof(T));
+        } else {
+            for(size_t i = 0; i < n; ++i) {
+                T* item = slot(h + i);
+                out[i] = std::move(*item);
+                item->~T();
+            }
+        }
+
+        head.store(h + n, std::memory_order_release);
+        return n;
+    }
+}
+
+#endif //SCARECROW2D_SPSC_QUEUE_H
@@ -6,12 +6,14 @@
 #define INC_2D_GAME_VEC_H
 
 #include "memory/pool_allocator.h"
+#include "memory/relocatable.h"
 #include <cstring>
 #include <iterator>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 // TODO:  ------------------- Write tests and benchmarks -------------------
-// TODO: Support for non-POD types
 
 namespace sc2d
 {
@@ -32,6 +34,7 @@ namespace sc2d
         using difference_type = ptrdiff_t;
         using size_type = size_t;
         using IS_T_TRIVIAL = std::is_trivial<T>;
+        using IS_T_RELOCATABLE = memory::is_trivially_relocatable<T>;
 
         constexpr vec() noexcept;
         constexpr explicit vec(size_type n);
@@ -67,6 +70,16 @@ namespace sc2d
         void resize(size_type new_size);
         void resize(size_type new_size, const T& data);
         void reserve(size_type new_size);
+        /**
+         * Same as reserve(), but capacity becomes exactly new_size instead of growing
+         * geometrically.
+         */
+        void reserve_exact(size_type new_size);
+        /**
+         * Changes size without constructing new elements, caller must write all of them.
+         * Only for trivially copyable T.
+         */
+        void resize_uninitialized(size_type new_size);
         void shrink_to_fit();
 
         reference operator[](size_type index);
@@ -97,6 +110,11 @@ namespace sc2d
         iterator insert(const_iterator c_iter, std::initializer_list<T> ilist);
         iterator erase(const_iterator it);
         iterator erase(const_iterator fist, const_iterator last);
+        /**
+         * Copies count elements to the end, with a single memcpy for trivially copyable T.
+         * src may point into this vector.
+         */
+        void append(const T* src, size_type count);
         void swap(vec<T>& other);
         void clear() noexcept;
 
@@ -114,6 +132,21 @@ namespace sc2d
             array = (T*)pool_alloc->p_start;
         }
 
+        /**
+         * Pool without blocks, shared by all moved-from vectors of T,
+         * so moving never allocates. It is replaced with a real pool on the first growth.
+         */
+        static memory::pool_allocator* empty_pool() noexcept
+        {
+            static memory::pool_allocator empty;
+            return &empty;
+        }
+
+        void grow(size_type min_capacity);
+        void reallocate(size_type new_capacity);
+        void destroy_range(T* first, T* last) noexcept;
+        iterator make_gap(const_iterator c_iter, size_type count);
+
         size_type initial_size = 1;
         T* array;
         memory::pool_allocator* pool_alloc;
@@ -124,9 +157,6 @@ namespace sc2d
     {
         pool_alloc = new memory::pool_allocator;
         pool_alloc->create(sizeof(T), initial_size << 1u, alignof(T));
-        //        if constexpr(!IS_T_TRIVIAL::value) {
-        //            array = new(pool_alloc->p_start) T();
-        //        }
         update_array_address();
     }
 
@@ -157,8 +187,7 @@ namespace sc2d
         : initial_size((last - first) >> 1u)
     {
         allocate();
-        for(; first != last; ++first)
-            push_back(*first);
+        append(first, last - first);
     }
 
     template <typename T>
@@ -166,8 +195,7 @@ namespace sc2d
         : initial_size(ilist.size())
     {
         allocate();
-        for(const auto& i : ilist)
-            push_back(i);
+        append(ilist.begin(), ilist.size());
     }
 
     template <typename T>
@@ -175,96 +203,87 @@ namespace sc2d
         : initial_size(v.capacity() >> 1u)
     {
         allocate();
-        for(size_t i = 0; i < v.initial_size; ++i)
-            array[i] = v.array[i];
+        append(v.array, v.size());
     }
 
     template <typename T>
     constexpr vec<T>::vec(vec<T>&& v) noexcept
-        : initial_size(v.capacity() >> 1u)
+        : initial_size(v.initial_size)
+        , array(v.array)
+        , pool_alloc(v.pool_alloc)
     {
-        allocate();
-        for(size_t i = 0; i < v.size(); ++i)
-            array[i] = std::move(v.array[i]);
+        // Stealing the buffer, 'v' is left empty and owns nothing
+        v.pool_alloc = empty_pool();
+        v.update_array_address();
     }
 
     template <typename T>
     vec<T>::~vec()
     {
-        //        if constexpr(!IS_T_TRIVIAL::value) {
-        //            array->~T();
-        //        }
-        pool_alloc->destroy();
-        delete pool_alloc;
+        destroy_range(array, array + pool_alloc->num_of_initialized);
+        if(pool_alloc != empty_pool())
+            delete pool_alloc;
         array = nullptr;
     }
 
     template <typename T>
     vec<T>& vec<T>::operator=(const vec<T>& other)
     {
-        if(size_t other_capacity = other.pool_alloc->num_of_blocks;
-           other_capacity > pool_alloc->num_of_blocks) {
-            pool_alloc->resize(other_capacity);
-            update_array_address();
-        }
-
-        for(size_t i = 0; i < other.pool_alloc->num_of_initialized; ++i)
-            array[i] = other[i];
+        if(this == &other)
+            return *this;
 
+        clear();
+        if(other.capacity() > capacity())
+            reserve_exact(other.capacity());
+        append(other.array, other.size());
         return *this;
     }
 
     template <typename T>
     vec<T>& vec<T>::operator=(vec<T>&& other)
     {
-        if(size_t other_capacity = other.pool_alloc->num_of_blocks;
-           other_capacity > pool_alloc->num_of_blocks) {
-            pool_alloc->resize(other_capacity);
-            update_array_address();
-        }
-
-        for(size_t i = 0; i < other.initial_size; ++i)
-            array[i] = std::move(other[i]);
-
+        // Old elements are released by the destructor of 'other'
+        swap(other);
         return *this;
     }
 
     template <typename T>
     vec<T>& vec<T>::operator=(std::initializer_list<T> ilist)
     {
-        if(size_t ilist_size = ilist.size(); ilist_size > pool_alloc->num_of_blocks) {
-            pool_alloc->resize(ilist_size << 1u);
-            update_array_address();
-        }
-
-        size_t i = 0;
-        for(auto j = ilist.begin(); j != ilist.end(); ++j, ++i) {
-            array[i] = *j;
-        }
-
+        clear();
+        if(size_t ilist_size = ilist.size(); ilist_size > capacity())
+            reserve_exact(ilist_size << 1u);
+        append(ilist.begin(), ilist.size());
         return *this;
     }
 
     template <typename T>
     void vec<T>::assign(vec::size_type size, const T& data)
     {
+        clear();
+        if(size == 0)
+            return;
+
+        reserve(size);
         for(size_t i = 0; i < size; ++i)
-            push_back(data);
+            new(array + i) T(data);
+        pool_alloc->num_of_initialized = size;
     }
 
     template <typename T>
     void vec<T>::assign(vec::iterator first, vec::iterator last)
     {
-        size_t count = last - first;
-        for(size_t i = 0; i < count; ++i, ++first)
-            push_back(*first);
+        clear();
+        reserve(last - first);
+        append(first, last - first);
     }
 
     template <typename T>
     void vec<T>::assign(std::initializer_list<T> ilist)
     {
-        for(const auto& i : ilist)
-            push_back(i);
+        clear();
+        reserve(ilist.size());
+        append(ilist.begin(), ilist.size());
     }
 
     template <typename T>
@@ -324,7 +343,7 @@ namespace sc2d
     template <typename T>
     bool vec<T>::empty() const noexcept
     {
-        return initial_size == 0;
+        return pool_alloc->num_of_initialized == 0;
     }
 
     template <typename T>
@@ -343,21 +362,17 @@ namespace sc2d
     void vec<T>::resize(vec::size_type new_size)
     {
         const size_t current_size = pool_alloc->num_of_initialized;
+        if(new_size == current_size)
+            return;
 
         // If new size is bigger than current size of vector
         if(new_size > current_size) {
-            // If new size if bigger than current capacity of vector
-            if(new_size > pool_alloc->num_of_blocks) {
-                //                pool_alloc->num_of_free_blocks = new_size - pool_alloc->num_of_initialized;
-                pool_alloc->resize(new_size);
-                update_array_address();
-            }
+            reserve_exact(new_size);
+            for(size_t i = current_size; i < new_size; ++i)
+                new(array + i) T();
         } else {
             //  Reduce size to its first count elements
-            for(size_t i = current_size - 1; i >= new_size; --i)
-                pool_alloc->deallocate((void*)&array[i]);
-
-            pool_alloc->num_of_blocks = new_size;
+            destroy_range(array + new_size, array + current_size);
         }
         pool_alloc->num_of_initialized = new_size;
     }
@@ -366,37 +381,51 @@ namespace sc2d
     void vec<T>::resize(vec::size_type new_size, const T& data)
     {
         const size_t current_size = pool_alloc->num_of_initialized;
+        if(new_size == current_size)
+            return;
         if(new_size > current_size) {
-            if(new_size > pool_alloc->num_of_blocks) {
-                pool_alloc->resize(new_size);
-                update_array_address();
-            }
-
+            // 'data' may point into this vector
+            const T copy(data);
+            reserve_exact(new_size);
             for(size_t i = current_size; i < new_size; ++i)
-                array[i] = data;
-
+                new(array + i) T(copy);
         } else {
-            for(size_t i = current_size - 1; i >= new_size; --i)
-                pool_alloc->deallocate((void*)&array[i]);
-
-            pool_alloc->num_of_blocks = new_size;
+            destroy_range(array + new_size, array + current_size);
         }
         pool_alloc->num_of_initialized = new_size;
     }
 
     template <typename T>
-    void vec<T>::reserve(vec::size_type new_size)
+    void vec<T>::resize_uninitialized(vec::size_type new_size)
     {
-        if(new_size > pool_alloc->num_of_blocks) {
-            pool_alloc->resize(new_size);
-            update_array_address();
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "resize_uninitialized() leaves elements unconstructed");
+        if(new_size != pool_alloc->num_of_initialized) {
+            reserve_exact(new_size);
+            pool_alloc->num_of_initialized = new_size;
         }
     }
 
+    template <typename T>
+    void vec<T>::reserve(vec::size_type new_size)
+    {
+        if(new_size > pool_alloc->num_of_blocks)
+            grow(new_size);
+    }
+
+    template <typename T>
+    void vec<T>::reserve_exact(vec::size_type new_size)
+    {
+        if(new_size > pool_alloc->num_of_blocks)
+            reallocate(new_size);
+    }
+
     template <typename T>
     void vec<T>::shrink_to_fit()
     {
-        resize(pool_alloc->num_of_initialized);
+        const size_t current_size = pool_alloc->num_of_initialized;
+        if(current_size > 0 && current_size < pool_alloc->num_of_blocks)
+            reallocate(current_size);
     }
 
     template <typename T>
@@ -470,102 +499,67 @@ namespace sc2d
     template <typename T>
     forceinline void vec<T>::push_back(const T& cref_data)
     {
-        const memory::alloc_result res = pool_alloc->allocate();
-        T& item = *(T*)res.ptr;
-        item = cref_data;
-
-        if(res.resized == memory::is_resized::YES)
-            update_array_address();
+        size_t& size = pool_alloc->num_of_initialized;
+        if(size == pool_alloc->num_of_blocks) {
+            // 'cref_data' may point into this vector
+            T copy(cref_data);
+            grow(size + 1);
+            new(array + pool_alloc->num_of_initialized++) T(std::move(copy));
+            return;
+        }
+        new(array + size++) T(cref_data);
     }
 
     template <typename T>
-    void vec<T>::push_back(T&& lvref_data)
+    forceinline void vec<T>::push_back(T&& lvref_data)
     {
-        memory::alloc_result res = pool_alloc->allocate();
-        T& item = *(T*)res.ptr;
-        item = std::move(lvref_data);
-
-        if(res.resized == memory::is_resized::YES)
-            update_array_address();
+        emplace_back(std::move(lvref_data));
     }
 
     template <typename T>
     template <typename... Args>
     void vec<T>::emplace_back(Args&&... args)
     {
-        memory::alloc_result res = pool_alloc->allocate();
-        T& item = *(T*)res.ptr;
-        item = std::move(T(std::forward<Args>(args)...));
-
-        if(res.resized == memory::is_resized::YES)
-            update_array_address();
+        if(pool_alloc->num_of_initialized == pool_alloc->num_of_blocks) {
+            T item(std::forward<Args>(args)...);
+            grow(pool_alloc->num_of_initialized + 1);
+            new(array + pool_alloc->num_of_initialized++) T(std::move(item));
+            return;
+        }
+        new(array + pool_alloc->num_of_initialized++) T(std::forward<Args>(args)...);
     }
 
     template <typename T>
     void vec<T>::pop_back()
     {
-        pool_alloc->deallocate((void*)&array[pool_alloc->num_of_initialized - 1]);
+        array[--pool_alloc->num_of_initialized].~T();
     }
 
     template <typename T>
     template <typename... Args>
     typename vec<T>::iterator vec<T>::emplace(vec::const_iterator c_iter, Args&&... args)
     {
-        const ptrdiff_t pos = c_iter - array;
-        if((ptrdiff_t)(pool_alloc->num_of_blocks - pool_alloc->num_of_initialized) <= 0) {
-            pool_alloc->resize(pool_alloc->num_of_blocks << 1u);
-            update_array_address();
-        }
-
-        iterator iter = &array[pos];
-        // Bug for non-POD types
-        const size_t sz = (pool_alloc->num_of_initialized - pos) * sizeof(T);
-        if(sz > 0) {
-            memmove(iter + 1, iter, sz);
-        }
-        *iter = std::move(T(std::forward<Args>(args)...));
-        ++pool_alloc->num_of_initialized;
+        T item(std::forward<Args>(args)...);
+        iterator iter = make_gap(c_iter, 1);
+        new(iter) T(std::move(item));
         return iter;
     }
 
     template <typename T>
     typename vec<T>::iterator vec<T>::insert(vec::const_iterator c_iter, const T& cref_type)
     {
-        const ptrdiff_t pos = c_iter - array;
-        if((ptrdiff_t)(pool_alloc->num_of_blocks - pool_alloc->num_of_initialized) <= 0) {
-            pool_alloc->resize(pool_alloc->num_of_blocks << 1u);
-            update_array_address();
-        }
-
-        iterator iter = &array[pos];
-        // Bug for non-POD types
-        const size_t sz = (pool_alloc->num_of_initialized - pos) * sizeof(T);
-        if(sz > 0) {
-            memmove(iter + 1, iter, sz);
-        }
-        *iter = cref_type;
-        ++pool_alloc->num_of_initialized;
+        T item(cref_type);
+        iterator iter = make_gap(c_iter, 1);
+        new(iter) T(std::move(item));
         return iter;
     }
 
     template <typename T>
     typename vec<T>::iterator vec<T>::insert(vec::const_iterator c_iter, T&& uref_type)
     {
-        const ptrdiff_t pos = c_iter - array;
-        if((ptrdiff_t)(pool_alloc->num_of_blocks - pool_alloc->num_of_initialized) <= 0) {
-
-            pool_alloc->resize(pool_alloc->num_of_blocks << 1u);
-            update_array_address();
-        }
-
-        iterator iter = &array[pos];
-        // Bug for non-POD types
-        size_t sz = (pool_alloc->num_of_initialized - pos) * sizeof(T);
-        if(sz > 0) {
-            memmove(iter + 1, iter, sz);
-        }
-        *iter = std::move(uref_type);
-        ++pool_alloc->num_of_initialized;
+        T item(std::move(uref_type));
+        iterator iter = make_gap(c_iter, 1);
+        new(iter) T(std::move(item));
         return iter;
     }
 
@@ -573,26 +567,13 @@ namespace sc2d
     typename vec<T>::iterator vec<T>::insert(vec::const_iterator c_iter, vec::size_type count,
                                              const T& value)
     {
-        const ptrdiff_t pos = c_iter - array;
-        if(count <= 0) {
-            return &array[pos];
-        }
-
-        if(pool_alloc->num_of_initialized + count > pool_alloc->num_of_blocks) {
-            pool_alloc->resize(pool_alloc->num_of_blocks << 1u);
-            update_array_address();
-        }
+        if(count == 0)
+            return &array[c_iter - array];
 
-        iterator iter = &array[pos];
-        // Bug for non-POD types
-        const size_t sz = (pool_alloc->num_of_initialized - pos) * sizeof(T);
-        if(sz > 0) {
-            memmove(iter + count, iter, sz);
-        }
-        pool_alloc->num_of_initialized += count;
-        for(iterator i = iter; count > 0; --count, ++i) {
-            *i = value;
-        }
+        const T item(value);
+        iterator iter = make_gap(c_iter, count);
+        for(iterator i = iter; count > 0; --count, ++i)
+            new(i) T(item);
         return iter;
     }
 
@@ -603,26 +584,21 @@ namespace sc2d
     {
         const ptrdiff_t pos = c_iter - array;
         const ptrdiff_t count = last - first;
-        if(count <= 0) {
+        if(count <= 0)
             return &array[pos];
-        }
 
-        if((ptrdiff_t)(pool_alloc->num_of_blocks - pool_alloc->num_of_initialized - count) <= 0) {
-            pool_alloc->resize(pool_alloc->num_of_blocks << 1u);
-            update_array_address();
+        if constexpr(std::is_pointer<InputIter>::value) {
+            // Range from this vector is moved or freed by make_gap(), inserting a copy of it
+            if((const T*)first >= array && (const T*)first < array + size()) {
+                vec<T> copy;
+                copy.append(first, count);
+                return insert(c_iter, copy.begin(), copy.end());
+            }
         }
 
-        iterator iter = &array[pos];
-        // Bug for non-POD types
-        const size_t sz = (pool_alloc->num_of_initialized - pos) * sizeof(T);
-        if(sz > 0) {
-            memmove(iter + count, iter, sz);
-        }
-        size_t j = 0;
-        for(iterator i = iter; first != last; ++i, ++first, ++j) {
-            *i = *first;
-        }
-        pool_alloc->num_of_initialized += count;
+        iterator iter = make_gap(c_iter, count);
+        for(iterator i = iter; first != last; ++i, ++first)
+            new(i) T(*first);
         return iter;
     }
 
@@ -630,42 +606,13 @@ namespace sc2d
     typename vec<T>::iterator vec<T>::insert(vec::const_iterator c_iter,
                                              std::initializer_list<T> ilist)
     {
-        const size_t count = ilist.size();
-        const ptrdiff_t pos = c_iter - array;
-        if(count <= 0) {
-            return &array[pos];
-        }
-
-        if((ptrdiff_t)(pool_alloc->num_of_blocks - pool_alloc->num_of_initialized - count) <= 0) {
-            pool_alloc->resize(pool_alloc->num_of_blocks << 1u);
-            update_array_address();
-        }
-
-        const iterator iter = &array[pos];
-        // Bug for non-POD types
-        const size_t sz = (pool_alloc->num_of_initialized - pos) * sizeof(T);
-        if(sz > 0) {
-            memmove(iter + count, iter, sz);
-        }
-        iterator i = iter;
-        for(auto& item : ilist) {
-            *i = item;
-            ++i;
-        }
-        pool_alloc->num_of_initialized += count;
-        return i;
+        return insert(c_iter, ilist.begin(), ilist.end());
     }
 
     template <typename T>
     typename vec<T>::iterator vec<T>::erase(vec::const_iterator it)
     {
-        iterator iter = &array[it - array];
-        //        (*iter).~T();
-        pool_alloc->deallocate(iter);
-        //        memmove(iter, iter + 1, (pool_alloc->num_of_initialized - (it - array) - 1) * sizeof(T));
-        //        pool_alloc->num_of_initialized--;
-        //        pool_alloc->num_of_free_blocks++;
-        return iter;
+        return erase(it, it + 1);
     }
 
     template <typename T>
@@ -675,22 +622,52 @@ namespace sc2d
         if(first == last)
             return iter;
 
-        while(first != last) {
-            //            (*first).~T();
-            pool_alloc->deallocate((iterator)first);
-            ++first;
+        const size_t count = last - first;
+        iterator tail = iter + count;
+        iterator end_iter = end();
+        destroy_range(iter, tail);
+
+        if constexpr(IS_T_RELOCATABLE::value) {
+            memmove((void*)iter, (const void*)tail, (end_iter - tail) * sizeof(T));
+        } else {
+            for(iterator i = iter; tail != end_iter; ++i, ++tail) {
+                new(i) T(std::move(*tail));
+                tail->~T();
+            }
         }
+        pool_alloc->num_of_initialized -= count;
+        return iter;
+    }
 
-        //        memmove(iter, last, (pool_alloc->num_of_initialized - (last - array)) * sizeof(T));
-        //        pool_alloc->num_of_initialized -= last - first;
-        //        pool_alloc->num_of_free_blocks -= last - first;
+    template <typename T>
+    void vec<T>::append(const T* src, vec::size_type count)
+    {
+        if(count == 0)
+            return;
 
-        return iter;
+        const size_t current_size = pool_alloc->num_of_initialized;
+        if(current_size + count > pool_alloc->num_of_blocks) {
+            // 'src' is invalidated by reallocation if it points into this vector
+            const bool is_inner = src >= array && src < array + current_size;
+            const ptrdiff_t offset = src - array;
+            grow(current_size + count);
+            if(is_inner)
+                src = array + offset;
+        }
+
+        if constexpr(std::is_trivially_copyable<T>::value) {
+            memcpy((void*)(array + current_size), (const void*)src, count * sizeof(T));
+        } else {
+            for(size_t i = 0; i < count; ++i)
+                new(array + current_size + i) T(src[i]);
+        }
+        pool_alloc->num_of_initialized += count;
     }
 
     template <typename T>
     void vec<T>::swap(vec<T>& other)
     {
+        std::swap(initial_size, other.initial_size);
         std::swap(array, other.array);
         std::swap(pool_alloc, other.pool_alloc);
     }
@@ -698,9 +675,79 @@ namespace sc2d
     template <typename T>
     void vec<T>::clear() noexcept
     {
-        while(pool_alloc->num_of_initialized) {
-            pool_alloc->deallocate(&array[pool_alloc->num_of_initialized]);
+        // Moved-from vectors share one empty pool, which is never written
+        if(pool_alloc->num_of_initialized) {
+            destroy_range(array, array + pool_alloc->num_of_initialized);
+            pool_alloc->num_of_initialized = 0;
+        }
+    }
+
+    template <typename T>
+    void vec<T>::grow(vec::size_type min_capacity)
+    {
+        const size_t doubled = pool_alloc->num_of_blocks << 1u;
+        reallocate(doubled > min_capacity ? doubled : min_capacity);
+    }
+
+    template <typename T>
+    void vec<T>::reallocate(vec::size_type new_capacity)
+    {
+        const size_t current_size = pool_alloc->num_of_initialized;
+
+        if constexpr(IS_T_RELOCATABLE::value) {
+            if(pool_alloc != empty_pool()) {
+                // realloc / memcpy of the whole block
+                pool_alloc->resize(new_capacity);
+                update_array_address();
+                return;
+            }
+        }
+
+        auto* grown = new memory::pool_allocator;
+        grown->create(sizeof(T), new_capacity, alignof(T));
+        T* grown_array = (T*)grown->p_start;
+        for(size_t i = 0; i < current_size; ++i) {
+            new(grown_array + i) T(std::move(array[i]));
+            array[i].~T();
         }
+        grown->num_of_initialized = current_size;
+
+        if(pool_alloc != empty_pool())
+            delete pool_alloc;
+        pool_alloc = grown;
+        update_array_address();
+    }
+
+    template <typename T>
+    forceinline void vec<T>::destroy_range(T* first, T* last) noexcept
+    {
+        if constexpr(!std::is_trivially_destructible<T>::value) {
+            for(; first != last; ++first)
+                first->~T();
+        }
+    }
+
+    template <typename T>
+    typename vec<T>::iterator vec<T>::make_gap(vec::const_iterator c_iter, vec::size_type count)
+    {
+        const size_t pos = c_iter - array;
+        const size_t current_size = pool_alloc->num_of_initialized;
+        if(current_size + count > pool_alloc->num_of_blocks)
+            grow(current_size + count);
+
+        iterator iter = array + pos;
+        if constexpr(IS_T_RELOCATABLE::value) {
+            memmove((void*)(iter + count), (const void*)iter, (current_size - pos) * sizeof(T));
+        } else {
+            // Relocating from the back, so every destination is already free
+            for(iterator i = array + current_size; i != iter;) {
+                --i;
+                new(i + count) T(std::move(*i));
+                i->~T();
+            }
+        }
+        pool_alloc->num_of_initialized += count;
+        return iter;
     }
 
     template <typename T>
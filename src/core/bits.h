@@ -0,0 +1,115 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_BITS_H
+#define SCARECROW2D_BITS_H
+
+#include "compiler.h"
+#include "types.h"
+
+#if COMPILER_MVC
+#    include <intrin.h>
+#endif
+
+namespace sc2d::bits
+{
+
+    /**
+     * Index of the lowest set bit, x must not be 0
+     */
+    forceinline u32 ctz32(u32 x)
+    {
+#if COMPILER_MVC
+        unsigned long index;
+        _BitScanForward(&index, x);
+        return (u32)index;
+#else
+        return (u32)__builtin_ctz(x);
+#endif
+    }
+
+    /**
+     * Index of the lowest set bit, x must not be 0
+     */
+    forceinline u32 ctz64(u64 x)
+    {
+#if COMPILER_MVC
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return (u32)index;
+#else
+        return (u32)__builtin_ctzll(x);
+#endif
+    }
+
+    /**
+     * Index of the highest set bit, x must not be 0
+     */
+    forceinline u32 msb32(u32 x)
+    {
+#if COMPILER_MVC
+        unsigned long index;
+        _BitScanReverse(&index, x);
+        return (u32)index;
+#else
+        return 31u - (u32)__builtin_clz(x);
+#endif
+    }
+
+    forceinline u32 popcount64(u64 x)
+    {
+#if COMPILER_MVC
+        return (u32)__popcnt64(x);
+#else
+        return (u32)__builtin_popcountll(x);
+#endif
+    }
+
+    /**
+     * Smallest power of two >= x, 1 for 0
+     */
+    forceinline constexpr size_t next_pow2(size_t x)
+    {
+        size_t result = 1;
+        while(result < x)
+            result <<= 1u;
+        return result;
+    }
+
+    /**
+     * Spreads the low 16 bits of x to the even bit positions
+     */
+    forceinline constexpr u32 part1by1(u32 x)
+    {
+        x &= 0x0000ffffu;
+        x = (x | (x << 8u)) & 0x00ff00ffu;
+        x = (x | (x << 4u)) & 0x0f0f0f0fu;
+        x = (x | (x << 2u)) & 0x33333333u;
+        x = (x | (x << 1u)) & 0x55555555u;
+        return x;
+    }
+
+    /**
+     * Inverse of part1by1, gathers the even bits of x
+     */
+    forceinline constexpr u32 compact1by1(u32 x)
+    {
+        x &= 0x55555555u;
+        x = (x | (x >> 1u)) & 0x33333333u;
+        x = (x | (x >> 2u)) & 0x0f0f0f0fu;
+        x = (x | (x >> 4u)) & 0x00ff00ffu;
+        x = (x | (x >> 8u)) & 0x0000ffffu;
+        return x;
+    }
+
+    /**
+     * Z-order index of 16-bit coordinates, x in the even bits
+     */
+    forceinline constexpr u32 morton2(u32 x, u32 y)
+    {
+        return part1by1(x) | (part1by1(y) << 1u);
+    }
+}
+
+#endif //SCARECROW2D_BITS_H
@@ -3,11 +3,31 @@
 //
 
 #include "camera.h"
+#include "core/dbg/dbg_asserts.h"
+#include "core/rendering/gl_state.h"
 #include "math/transform.h"
+#include <cstddef>
 
 namespace sc2d
 {
 
+    void Camera::init()
+    {
+        update_view();
+        glGenBuffers(1, &ubo);
+        GLState::bind_buffer(GL_UNIFORM_BUFFER, ubo);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(camera_block), nullptr, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BLOCK_BINDING, ubo);
+        matrices_dirty = true;
+    }
+
+    void Camera::destroy()
+    {
+        GLState::forget_buffer(ubo);
+        glDeleteBuffers(1, &ubo);
+        ubo = 0;
+    }
+
     void Camera::make_orthographic(f32 width, f32 height, f32 near, f32 far)
     {
         this->width = width;
@@ -15,5 +35,47 @@ namespace sc2d
         this->near = near;
         this->far = far;
         proj = math::ortho(0.0, width, height, 0.0, near, far);
+        matrices_dirty = true;
+    }
+
+    void Camera::set_position(const math::vec2& position)
+    {
+        this->position = position;
+        update_view();
+    }
+
+    void Camera::set_zoom(f32 zoom)
+    {
+        DBG_FAIL_IF(zoom <= 0.0f, "camera zoom must be positive")
+        this->zoom = zoom;
+        update_view();
+    }
+
+    void Camera::update_view()
+    {
+        // Moves position to the origin, then scales, points are row vectors
+        view = math::translation(-position.x, -position.y, 0.0f)
+               * math::scale(zoom, zoom, 1.0f);
+        matrices_dirty = true;
+    }
+
+    void Camera::update(f32 time)
+    {
+        camera_block block;
+        block.time = time;
+        block.delta_time = time - last_time;
+        last_time = time;
+
+        GLState::bind_buffer(GL_UNIFORM_BUFFER, ubo);
+        if(matrices_dirty) {
+            block.view = view;
+            block.projection = proj;
+            block.view_projection = view * proj;
+            glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(camera_block), &block);
+            matrices_dirty = false;
+        } else {
+            glBufferSubData(GL_UNIFORM_BUFFER, offsetof(camera_block, time),
+                            sizeof(f32) * 2, &block.time);
+        }
     }
 }
@@ -6,27 +6,103 @@
 #define SCARECROW2D_CAMERA_H
 
 #include "core/types.h"
+#include "math/geometry2d.h"
 #include "math/matrix4.h"
+#include "math/vector2.h"
+#include <glad/glad.h>
 
 namespace sc2d
 {
+    /**
+     * Uniform block binding point of the camera, set for every shader when it is linked
+     */
+    constexpr GLuint CAMERA_BLOCK_BINDING = 0;
+    constexpr const char* CAMERA_BLOCK_NAME = "Camera";
+
+    /**
+     * std140 layout of the Camera uniform block declared by the built-in shaders
+     */
+    struct camera_block
+    {
+        math::mat4 view;
+        math::mat4 projection;
+        math::mat4 view_projection;
+        f32 time;
+        f32 delta_time;
+        f32 padding[2];
+    };
+    static_assert(sizeof(camera_block) == 208, "camera_block must match std140 layout");
 
     class Camera
     {
     public:
+        /**
+         * Creates the uniform buffer and binds it to CAMERA_BLOCK_BINDING
+         */
+        void init();
+        void destroy();
+
         void make_orthographic(f32 width, f32 height, f32 near, f32 far);
+
+        /**
+         * World point shown at the top left corner of the viewport
+         */
+        void set_position(const math::vec2& position);
+
+        /**
+         * Screen pixels per world unit, above 1 magnifies
+         */
+        void set_zoom(f32 zoom);
+
+        const math::vec2& get_position() const
+        {
+            return position;
+        }
+
+        f32 get_zoom() const
+        {
+            return zoom;
+        }
+
+        /**
+         * World area covered by the viewport, for culling
+         */
+        math::rect2d get_view_rect() const
+        {
+            return {position, {width / zoom, height / zoom}};
+        }
+
         math::mat4 get_proj() const
         {
             return proj;
         }
 
+        math::mat4 get_view() const
+        {
+            return view;
+        }
+
+        /**
+         * Uploads the block, once per frame. Matrices are sent only after they changed.
+         * @param time seconds since start
+         */
+        void update(f32 time);
+
     private:
-        f32 width;
-        f32 height;
+        void update_view();
+
+        f32 width = 0.0f;
+        f32 height = 0.0f;
         f32 near;
         f32 far;
         f32 aspect;
+        math::vec2 position {0.0f, 0.0f};
+        f32 zoom = 1.0f;
         math::mat4 proj;
+        math::mat4 view;
+        f32 last_time = 0.0f;
+        GLuint ubo = 0;
+        bool matrices_dirty = true;
     };
 }
 
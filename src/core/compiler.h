@@ -49,6 +49,21 @@
 #    define COMPILER_ARCH_x64_32 1
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define COMPILER_SSE2 1
+#endif
+
+#if defined(__AVX2__)
+#    define COMPILER_AVX2 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define COMPILER_NEON 1
+#endif
+
+// Padding for data written by different threads, to avoid false sharing
+#define COMPILER_CACHE_LINE_SIZE 64
+
 #ifdef COMPILER_MVC
 #    define forceinline __forceinline
 #elif defined(COMPILER_GCC)
@@ -17,8 +17,9 @@ ECS::~ECS()
     for(const auto& component : components) {
         size_t type_size = BaseECSComponent::get_type_size(component.first);
         ECSComponentFreeFunction freefn = BaseECSComponent::get_type_freefn(component.first);
-        for(size_t i = 0; i < component.second.size(); i += type_size) {
-            freefn((BaseECSComponent*)&component.second[i]);
+        const std::vector<uint8_t>& memory = component.second.memory;
+        for(size_t i = 0; i < memory.size(); i += type_size) {
+            freefn((BaseECSComponent*)&memory[i]);
         }
     }
 }
@@ -26,7 +27,7 @@ ECS::~ECS()
 EntityHandle ECS::make_entity(BaseECSComponent* entity_components, const compId_t* component_ids,
                               size_t num_components)
 {
-    auto* new_entity = new std::pair<uint32_t, std::vector<std::pair<compId_t, uint32_t>>>();
+    auto* new_entity = new Entity();
     auto handle = (EntityHandle)new_entity;
 
     for(size_t i = 0; i < num_components; ++i) {
@@ -36,10 +37,11 @@ EntityHandle ECS::make_entity(BaseECSComponent* entity_components, const compId_
             delete new_entity;
             return nullptr;
         }
-        add_component_internal(handle, new_entity->second, component_ids[i], &entity_components[i]);
+        add_component_internal(handle, new_entity->components, component_ids[i],
+                               &entity_components[i]);
     }
 
-    new_entity->first = entities.size();
+    new_entity->index = entities.size();
     entities.emplace_back(new_entity);
 
     return handle;
@@ -57,51 +59,43 @@ void ECS::remove_entity(EntityHandle handle)
     delete entities[dest_index];
     // Removing entity from vector
     entities[dest_index] = entities[src_index];
+    entities[dest_index]->index = dest_index;
     entities.pop_back();
 }
 
 void ECS::add_component_internal(EntityHandle handle,
-                                 std::vector<std::pair<compId_t, uint32_t>>& entity,
+                                 std::vector<std::pair<compId_t, compHandle_t>>& entity,
                                  compId_t component_id, BaseECSComponent* component)
 {
     ECSComponentCreateFunction createfn = BaseECSComponent::get_type_createfn(component_id);
-    std::pair<compId_t, uint32_t> new_pair;
+    ComponentArray& array = components[component_id];
+    // Component is appended, its dense position is index.size()
+    createfn(array.memory, handle, component);
+    std::pair<compId_t, compHandle_t> new_pair;
     new_pair.first = component_id;
-    new_pair.second = createfn(components[component_id], handle, component);
+    new_pair.second = array.index.insert();
     entity.emplace_back(new_pair);
+    handle_to_raw_type(handle)->signature.set(component_id);
 }
 
-void ECS::delete_component_internal(compId_t component_id, uint32_t index)
+void ECS::delete_component_internal(compId_t component_id, compHandle_t handle)
 {
-    std::vector<uint8_t>& array = components[component_id];
+    ComponentArray& array = components[component_id];
     ECSComponentFreeFunction freefn = BaseECSComponent::get_type_freefn(component_id);
     size_t type_size = BaseECSComponent::get_type_size(component_id);
 
-
-    uint32_t src_index = array.size() - type_size;
-    auto* dest_component = (BaseECSComponent*)&array[index];
-    auto* src_component = (BaseECSComponent*)&array[src_index];
+    size_t dest_index = array.index.dense_index(handle) * type_size;
+    size_t src_index = array.memory.size() - type_size;
+    auto* dest_component = (BaseECSComponent*)&array.memory[dest_index];
+    auto* src_component = (BaseECSComponent*)&array.memory[src_index];
     freefn(dest_component);
 
-    // If 'index' is last element
-    if(index == src_index) {
-        array.resize(src_index);
-        return;
-    }
-
-    memcpy(dest_component, src_component, type_size);
-    auto& src_components = handle_to_entity(src_component->entity);
-    // update the entities that refer to the component that we are moving,
-    // so they are pointing to the new index
-    for(auto& c : src_components) {
-        // if component types are the same && indices form components vector and index of component in components array
-        if(component_id == c.first && src_index == c.second) {
-            c.second = index;
-            break;
-        }
-    }
-
-    array.resize(src_index);
+    // Last component fills the hole, index updates its handle, so the owner entity
+    // doesn't have to be searched
+    if(dest_index != src_index)
+        memcpy(dest_component, src_component, type_size);
+    array.index.erase(handle);
+    array.memory.resize(src_index);
 }
 
 void ECS::remove_component_internal(EntityHandle handle, uint32_t component_id)
@@ -114,18 +108,20 @@ void ECS::remove_component_internal(EntityHandle handle, uint32_t component_id)
             uint32_t dest_index = i;
             entity_components[dest_index] = entity_components[src_index];
             entity_components.pop_back();
+            handle_to_raw_type(handle)->signature.reset(component_id);
             return;
         }
     }
 }
 
 BaseECSComponent*
-ECS::get_component_internal(std::vector<std::pair<uint32_t, uint32_t>>& entity_components,
-                            std::vector<uint8_t>& array, uint32_t component_id) const
+ECS::get_component_internal(std::vector<std::pair<compId_t, compHandle_t>>& entity_components,
+                            const ComponentArray& array, uint32_t component_id) const
 {
     for(auto& c : entity_components) {
         if(component_id == c.first) {
-            return (BaseECSComponent*)&array[c.second];
+            size_t type_size = BaseECSComponent::get_type_size(component_id);
+            return (BaseECSComponent*)&array.memory[array.index.dense_index(c.second) * type_size];
         }
     }
     return nullptr;
@@ -142,12 +138,12 @@ void ECS::remove_system(BaseECSSystem& system)
 void ECS::update_systems(float delta)
 {
     std::vector<BaseECSComponent*> component_param;
-    std::vector<std::vector<uint8_t>*> component_array;
+    std::vector<ComponentArray*> component_array;
     for(size_t i = 0; i < systems.size(); ++i) {
         const std::vector<uint32_t>& component_types = systems[i]->get_component_types();
         if(component_types.size() == 1) {
             size_t type_size = BaseECSComponent::get_type_size(component_types[0]);
-            std::vector<uint8_t>& comps_array = components[component_types[0]];
+            std::vector<uint8_t>& comps_array = components[component_types[0]].memory;
             for(size_t j = 0; j < comps_array.size(); j += type_size) {
                 auto component = (BaseECSComponent*)&comps_array[j];
                 systems[i]->update_components(delta, &component);
@@ -161,48 +157,47 @@ void ECS::update_systems(float delta)
 void ECS::update_system_components(size_t index, float delta,
                                    const std::vector<uint32_t>& component_types,
                                    std::vector<BaseECSComponent*>& component_param,
-                                   std::vector<std::vector<uint8_t>*>& component_array)
+                                   std::vector<ComponentArray*>& component_array)
 {
     component_param.resize(math::utils::max(component_param.size(), component_types.size()));
     component_array.resize(math::utils::max(component_param.size(), component_array.size()));
 
-    for(size_t i = 0; i < component_param.size(); ++i) {
+    // Inserting may move the arrays, so every type is added before taking pointers
+    for(uint32_t type : component_types)
+        components.try_emplace(type);
+    for(size_t i = 0; i < component_types.size(); ++i) {
         component_array[i] = &components[component_types[i]];
     }
     uint32_t min_size_index = find_least_common_component(component_types);
-    size_t type_size = BaseECSComponent::get_type_size(component_types[0]);
+    size_t type_size = BaseECSComponent::get_type_size(component_types[min_size_index]);
 
-    std::vector<uint8_t>& min_comp_array = *component_array[min_size_index];
+    const ComponentSignature& system_signature = systems[index]->get_signature();
+    std::vector<uint8_t>& min_comp_array = component_array[min_size_index]->memory;
     for(size_t i = 0; i < min_comp_array.size(); i += type_size) {
         component_param[min_size_index] = (BaseECSComponent*)&min_comp_array[i];
-        auto& entity_components = handle_to_entity(component_param[min_size_index]->entity);
+        Entity* entity = handle_to_raw_type(component_param[min_size_index]->entity);
+        // Entities without every component of the system are skipped without lookups
+        if(!entity->signature.contains(system_signature))
+            continue;
 
-        bool is_valid = true;
         for(size_t j = 0; j < component_types.size(); j++) {
             if(j == min_size_index)
                 continue;
 
-            component_param[j] =
-                get_component_internal(entity_components, *component_array[j], component_types[j]);
-            if(component_param[j] == nullptr) {
-                is_valid = false;
-                break;
-            }
+            component_param[j] = get_component_internal(entity->components, *component_array[j],
+                                                        component_types[j]);
         }
-        if(is_valid)
-            systems[index]->update_components(delta, &component_param[0]);
+        systems[index]->update_components(delta, &component_param[0]);
     }
 }
 
 uint32_t ECS::find_least_common_component(const std::vector<uint32_t>& component_types)
 {
-    size_t min_size =
-        components[component_types[0]].size() / BaseECSComponent::get_type_size(component_types[0]);
-    size_t min_index = 1;
+    size_t min_size = components[component_types[0]].index.size();
+    size_t min_index = 0;
 
     for(size_t i = 0; i < component_types.size(); ++i) {
-        size_t type_size = BaseECSComponent::get_type_size(component_types[i]);
-        uint32_t size = components[component_types[i]].size() / type_size;
+        size_t size = components[component_types[i]].index.size();
         if(size < min_size) {
             min_size = size;
             min_index = i;
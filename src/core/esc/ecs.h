@@ -7,9 +7,10 @@
 #ifndef SCARECROW2D_ECS_H
 #define SCARECROW2D_ECS_H
 
+#include "collections/flat_map.h"
+#include "collections/sparse_set.h"
 #include "ecs_component.h"
 #include "ecs_system.h"
-#include <map>
 
 /**
  * Main class for Entity Component System
@@ -40,7 +41,7 @@ public:
     template <typename Component>
     void add_component(EntityHandle entity, Component* component)
     {
-        add_component_internal(entity, handle_to_entity(entity), Component::id, Component::size);
+        add_component_internal(entity, handle_to_entity(entity), Component::id, component);
     }
 
     template <typename Component>
@@ -52,8 +53,11 @@ public:
     template <typename Component>
     Component* get_component(EntityHandle entity) const
     {
-        return get_component_internal(handle_to_entity(entity), components[Component::id],
-                                      Component::id);
+        auto it = components.find(Component::id);
+        if(it == components.end())
+            return nullptr;
+        return (Component*)get_component_internal(handle_to_entity(entity), it->second,
+                                                  Component::id);
     }
 
     // System methods
@@ -66,21 +70,41 @@ public:
     void update_systems(float delta);
 
 private:
+    using compHandle_t = sc2d::memory::pool_handle;
+
+    /**
+     * Components of one type packed in memory, index maps component handles to positions
+     * so removing a component moves the last one without touching other entities
+     */
+    struct ComponentArray
+    {
+        std::vector<uint8_t> memory;
+        sc2d::sparse_index index;
+    };
+
+    struct Entity
+    {
+        // index in entities vector
+        uint32_t index = 0;
+        // bit per attached component type
+        ComponentSignature signature;
+        // [vector]<[pair]< component id, handle of component in components array>>
+        std::vector<std::pair<compId_t, compHandle_t>> components;
+    };
+
     std::vector<BaseECSSystem*> systems;
     // contains: component id, component's memory
-    std::map<compId_t, std::vector<uint8_t>> components;
-    // [vector]<[pair]<index in array it self,[vector]<[pair]< component id, index of component in components array>>>>
-    std::vector<std::pair<uint32_t, std::vector<std::pair<compId_t, uint32_t>>>*> entities;
+    sc2d::flat_map<compId_t, ComponentArray> components;
+    std::vector<Entity*> entities;
 
     /**
      * Utility method: casts Entity handle to raw entity type
      * @param handle Entity handle
      * @return
      */
-    auto handle_to_raw_type(EntityHandle handle) const
+    Entity* handle_to_raw_type(EntityHandle handle) const
     {
-        return static_cast<std::pair<uint32_t, std::vector<std::pair<compId_t, uint32_t>>>*>(
-            handle);
+        return static_cast<Entity*>(handle);
     }
 
     /**
@@ -90,7 +114,7 @@ private:
      */
     uint32_t handle_to_entity_index(EntityHandle handle) const
     {
-        return handle_to_raw_type(handle)->first;
+        return handle_to_raw_type(handle)->index;
     }
 
     /**
@@ -98,23 +122,23 @@ private:
      * @param handle Entity handle
      * @return
      */
-    std::vector<std::pair<compId_t, uint32_t>>& handle_to_entity(EntityHandle handle) const
+    std::vector<std::pair<compId_t, compHandle_t>>& handle_to_entity(EntityHandle handle) const
     {
-        return handle_to_raw_type(handle)->second;
+        return handle_to_raw_type(handle)->components;
     }
 
     void update_system_components(size_t index, float delta,
                                   const std::vector<uint32_t>& component_types,
                                   std::vector<BaseECSComponent*>& component_param,
-                                  std::vector<std::vector<uint8_t>*>& component_array);
+                                  std::vector<ComponentArray*>& component_array);
     void add_component_internal(EntityHandle handle,
-                                std::vector<std::pair<compId_t, uint32_t>>& entity,
+                                std::vector<std::pair<compId_t, compHandle_t>>& entity,
                                 compId_t component_id, BaseECSComponent* component);
     void remove_component_internal(EntityHandle handle, compId_t component_id);
-    void delete_component_internal(compId_t component_id, uint32_t index);
+    void delete_component_internal(compId_t component_id, compHandle_t handle);
     BaseECSComponent*
-    get_component_internal(std::vector<std::pair<compId_t, uint32_t>>& entity_components,
-                           std::vector<uint8_t>& array, uint32_t component_id) const;
+    get_component_internal(std::vector<std::pair<compId_t, compHandle_t>>& entity_components,
+                           const ComponentArray& array, uint32_t component_id) const;
     uint32_t find_least_common_component(const std::vector<uint32_t>& component_types);
 };
 
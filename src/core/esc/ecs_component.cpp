@@ -5,14 +5,20 @@
 // https://raw.githubusercontent.com/BennyQBD/3DGameProgrammingTutorial/master/LICENSE
 
 #include "ecs_component.h"
+#include "core/dbg/dbg_asserts.h"
 
-std::vector<std::tuple<ECSComponentCreateFunction, ECSComponentFreeFunction, size_t>>
-    BaseECSComponent::component_types;
+BaseECSComponent::ComponentTypes& BaseECSComponent::get_component_types()
+{
+    static ComponentTypes component_types;
+    return component_types;
+}
 
 size_t BaseECSComponent::register_component_type(ECSComponentCreateFunction createfn,
                                                  ECSComponentFreeFunction freefn, size_t size)
 {
+    ComponentTypes& component_types = get_component_types();
     size_t component_id = component_types.size();
+    DBG_FAIL_IF(component_id >= MAX_COMPONENT_TYPES, "too many component types")
     component_types.emplace_back((std::forward_as_tuple(createfn, freefn, size)));
     return component_id;
 }
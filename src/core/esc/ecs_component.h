@@ -7,6 +7,10 @@
 #ifndef SCARECROW2D_ECS_COMPONENT_H
 #define SCARECROW2D_ECS_COMPONENT_H
 
+#include "collections/bitset.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
 #include <tuple>
 #include <vector>
 
@@ -14,6 +18,10 @@ struct BaseECSComponent;
 using EntityHandle = void*;
 using compId_t = uint32_t;
 
+// Component ids index signature bits
+constexpr size_t MAX_COMPONENT_TYPES = 64;
+using ComponentSignature = sc2d::fixed_bitset<MAX_COMPONENT_TYPES>;
+
 // Define function pointers
 using ECSComponentFreeFunction = void (*)(BaseECSComponent* comp);
 using ECSComponentCreateFunction = compId_t (*)(std::vector<uint8_t>& memory, EntityHandle entity,
@@ -28,27 +36,30 @@ public:
 
     static ECSComponentCreateFunction get_type_createfn(compId_t id)
     {
-        return std::get<0>(component_types[id]);
+        return std::get<0>(get_component_types()[id]);
     }
 
     static ECSComponentFreeFunction get_type_freefn(compId_t id)
     {
-        return std::get<1>(component_types[id]);
+        return std::get<1>(get_component_types()[id]);
     }
 
     static size_t get_type_size(compId_t id)
     {
-        return std::get<2>(component_types[id]);
+        return std::get<2>(get_component_types()[id]);
     }
 
     static bool is_type_valid(compId_t id)
     {
-        return id >= component_types.size();
+        return id < get_component_types().size();
     }
 
 private:
-    static std::vector<std::tuple<ECSComponentCreateFunction, ECSComponentFreeFunction, size_t>>
-        component_types;
+    using ComponentTypes =
+        std::vector<std::tuple<ECSComponentCreateFunction, ECSComponentFreeFunction, size_t>>;
+
+    // Component ids are registered during static initialization of other translation units
+    static ComponentTypes& get_component_types();
 };
 
 /**
@@ -19,7 +19,11 @@ public:
      * @param component_types component types ids
      */
     explicit BaseECSSystem(const std::vector<uint32_t>& component_types)
-        : component_types(component_types) {};
+        : component_types(component_types)
+    {
+        for(compId_t id : component_types)
+            signature.set(id);
+    }
 
     virtual ~BaseECSSystem() = default;
 
@@ -30,9 +34,15 @@ public:
         return component_types;
     }
 
+    [[nodiscard]] const ComponentSignature& get_signature() const
+    {
+        return signature;
+    }
+
 private:
     // Stores component types ids
     std::vector<compId_t> component_types;
+    ComponentSignature signature;
 };
 
 #endif //SCARECROW2D_ECS_SYSTEM_H
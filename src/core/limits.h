@@ -16,6 +16,13 @@ namespace sc2d::limits
     constexpr u32 DRAWCALL_VERTICES = DRAWCALL_QUADS * 4;
     constexpr u32 DRAWCALL_INDICES = DRAWCALL_QUADS * 6;
     constexpr u32 SPRITE_INSTANCES = 2048;
+    // Sprites per draw call of the instanced batch
+    constexpr u32 DRAWCALL_SPRITE_INSTANCES = 16384;
+    // Size of the sampler array in the batched sprite shader
+    constexpr u32 BATCH_TEXTURES = 16;
+    // Tiles per side of a tile map chunk, chunk shaders derive the cell from it
+    constexpr u32 TILE_CHUNK_SIZE = 32;
+    constexpr u32 TILE_CHUNK_TILES = TILE_CHUNK_SIZE * TILE_CHUNK_SIZE;
 }
 
 #endif //SCARECROW2D_LIMITS_H
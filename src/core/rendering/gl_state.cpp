@@ -0,0 +1,204 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "gl_state.h"
+#include <algorithm>
+
+namespace sc2d
+{
+    namespace
+    {
+        constexpr GLuint UNKNOWN = 0xffffffff;
+        constexpr GLint MAX_TEXTURE_UNITS = 16;
+
+        struct texture_unit
+        {
+            GLenum target;
+            GLuint texture;
+            u64 last_use;
+        };
+
+        struct gl_state
+        {
+            GLuint program;
+            GLuint vertex_array;
+            GLuint array_buffer;
+            GLuint uniform_buffer;
+            GLint active_unit;
+            GLint unit_count;
+            texture_unit units[MAX_TEXTURE_UNITS];
+            u64 use_counter;
+            int blend_enabled;
+            GLenum blend_src;
+            GLenum blend_dst;
+        };
+
+        gl_state state;
+        gl_bind_stats stats;
+
+        /**
+         * @return true if 'cached' already holds 'value', otherwise stores it
+         */
+        template <typename T>
+        bool check_cached(T& cached, T value, gl_bind bind)
+        {
+            if(cached == value) {
+                ++stats.skipped[(size_t)bind];
+                return true;
+            }
+            cached = value;
+            ++stats.issued[(size_t)bind];
+            return false;
+        }
+
+        void activate_unit(GLint unit)
+        {
+            if(!check_cached(state.active_unit, unit, gl_bind::ACTIVE_TEXTURE))
+                glActiveTexture(GL_TEXTURE0 + unit);
+        }
+    }
+
+    u32 gl_bind_stats::total_issued() const
+    {
+        u32 result = 0;
+        for(u32 count : issued)
+            result += count;
+        return result;
+    }
+
+    u32 gl_bind_stats::total_skipped() const
+    {
+        u32 result = 0;
+        for(u32 count : skipped)
+            result += count;
+        return result;
+    }
+
+    void GLState::init()
+    {
+        GLint units = 0;
+        glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &units);
+        state.unit_count = std::clamp(units, 1, MAX_TEXTURE_UNITS);
+        invalidate();
+        reset_stats();
+    }
+
+    void GLState::invalidate()
+    {
+        state.program = UNKNOWN;
+        state.vertex_array = UNKNOWN;
+        state.array_buffer = UNKNOWN;
+        state.uniform_buffer = UNKNOWN;
+        state.active_unit = -1;
+        for(texture_unit& unit : state.units)
+            unit = {GL_NONE, UNKNOWN, 0};
+        state.use_counter = 0;
+        state.blend_enabled = -1;
+        state.blend_src = GL_NONE;
+        state.blend_dst = GL_NONE;
+    }
+
+    void GLState::use_program(GLuint program)
+    {
+        if(!check_cached(state.program, program, gl_bind::PROGRAM))
+            glUseProgram(program);
+    }
+
+    void GLState::bind_vertex_array(GLuint vao)
+    {
+        if(!check_cached(state.vertex_array, vao, gl_bind::VERTEX_ARRAY))
+            glBindVertexArray(vao);
+    }
+
+    void GLState::bind_buffer(GLenum target, GLuint buffer)
+    {
+        GLuint* cached = nullptr;
+        if(target == GL_ARRAY_BUFFER)
+            cached = &state.array_buffer;
+        else if(target == GL_UNIFORM_BUFFER)
+            cached = &state.uniform_buffer;
+
+        if(cached && check_cached(*cached, buffer, gl_bind::BUFFER))
+            return;
+        if(!cached)
+            ++stats.issued[(size_t)gl_bind::BUFFER];
+        glBindBuffer(target, buffer);
+    }
+
+    GLint GLState::bind_texture(GLenum target, GLuint texture)
+    {
+        ++state.use_counter;
+        GLint lru = 0;
+        for(GLint i = 0; i < state.unit_count; ++i) {
+            texture_unit& unit = state.units[i];
+            if(unit.texture == texture && unit.target == target) {
+                unit.last_use = state.use_counter;
+                ++stats.skipped[(size_t)gl_bind::TEXTURE];
+                return i;
+            }
+            if(unit.last_use < state.units[lru].last_use)
+                lru = i;
+        }
+
+        activate_unit(lru);
+        state.units[lru] = {target, texture, state.use_counter};
+        ++stats.issued[(size_t)gl_bind::TEXTURE];
+        glBindTexture(target, texture);
+        return lru;
+    }
+
+    void GLState::forget_texture(GLuint texture)
+    {
+        for(texture_unit& unit : state.units) {
+            if(unit.texture == texture)
+                unit = {GL_NONE, UNKNOWN, 0};
+        }
+    }
+
+    void GLState::forget_buffer(GLuint buffer)
+    {
+        if(state.array_buffer == buffer)
+            state.array_buffer = UNKNOWN;
+        if(state.uniform_buffer == buffer)
+            state.uniform_buffer = UNKNOWN;
+    }
+
+    void GLState::forget_vertex_array(GLuint vao)
+    {
+        if(state.vertex_array == vao)
+            state.vertex_array = UNKNOWN;
+    }
+
+    void GLState::set_blend(bool enabled)
+    {
+        if(check_cached(state.blend_enabled, (int)enabled, gl_bind::BLEND))
+            return;
+        if(enabled)
+            glEnable(GL_BLEND);
+        else
+            glDisable(GL_BLEND);
+    }
+
+    void GLState::blend_func(GLenum src_factor, GLenum dst_factor)
+    {
+        if(state.blend_src == src_factor && state.blend_dst == dst_factor) {
+            ++stats.skipped[(size_t)gl_bind::BLEND];
+            return;
+        }
+        state.blend_src = src_factor;
+        state.blend_dst = dst_factor;
+        ++stats.issued[(size_t)gl_bind::BLEND];
+        glBlendFunc(src_factor, dst_factor);
+    }
+
+    const gl_bind_stats& GLState::get_stats()
+    {
+        return stats;
+    }
+
+    void GLState::reset_stats()
+    {
+        stats = {};
+    }
+}
@@ -0,0 +1,85 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_GL_STATE_H
+#define SCARECROW2D_GL_STATE_H
+
+#include "core/types.h"
+#include <glad/glad.h>
+
+namespace sc2d
+{
+    enum class gl_bind
+    {
+        PROGRAM,
+        VERTEX_ARRAY,
+        BUFFER,
+        TEXTURE,
+        ACTIVE_TEXTURE,
+        BLEND,
+        COUNT
+    };
+
+    /**
+     * Binds issued to GL and binds skipped because the state was already set
+     */
+    struct gl_bind_stats
+    {
+        u32 issued[(size_t)gl_bind::COUNT];
+        u32 skipped[(size_t)gl_bind::COUNT];
+
+        u32 total_issued() const;
+        u32 total_skipped() const;
+    };
+
+    /**
+     * Shadow copy of the GL binding state, drops binds that would not change anything.
+     * All binds of programs, VAOs, array / uniform buffers, textures and blending should go
+     * through it, otherwise call invalidate() after binding directly.
+     * Textures are given texture units by bind_texture, so samplers must be set to the
+     * returned unit instead of the texture name.
+     * Rendering is single threaded.
+     */
+    class GLState
+    {
+    public:
+        /**
+         * Call once the context is current, forgets all cached state
+         */
+        static void init();
+        static void invalidate();
+
+        static void use_program(GLuint program);
+        static void bind_vertex_array(GLuint vao);
+
+        /**
+         * GL_ELEMENT_ARRAY_BUFFER belongs to the bound VAO and is never skipped
+         */
+        static void bind_buffer(GLenum target, GLuint buffer);
+
+        /**
+         * Binds texture to a unit, reusing the unit it is already bound to,
+         * otherwise the least recently used one
+         * @return texture unit index for sampler uniforms
+         */
+        static GLint bind_texture(GLenum target, GLuint texture);
+
+        /**
+         * Forget deleted objects before glDelete*, GL reuses names
+         */
+        static void forget_texture(GLuint texture);
+        static void forget_buffer(GLuint buffer);
+        static void forget_vertex_array(GLuint vao);
+
+        static void set_blend(bool enabled);
+        static void blend_func(GLenum src_factor, GLenum dst_factor);
+
+        static const gl_bind_stats& get_stats();
+        static void reset_stats();
+
+        GLState() = delete;
+    };
+}
+
+#endif //SCARECROW2D_GL_STATE_H
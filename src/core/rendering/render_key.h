@@ -0,0 +1,75 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_RENDER_KEY_H
+#define SCARECROW2D_RENDER_KEY_H
+
+#include "core/types.h"
+
+namespace sc2d
+{
+    /**
+     * Bit range of one value inside a render key
+     */
+    struct render_key_field
+    {
+        u8 offset;
+        u8 bits;
+
+        constexpr u64 mask() const
+        {
+            return bits == 64 ? ~0ull : ((1ull << bits) - 1) << offset;
+        }
+
+        constexpr u64 encode(u32 value) const
+        {
+            return bits == 0 ? 0 : ((u64)value << offset) & mask();
+        }
+
+        constexpr u32 decode(u64 key) const
+        {
+            return bits == 0 ? 0 : (u32)((key & mask()) >> offset);
+        }
+    };
+
+    /**
+     * How layer, shader, texture and depth are packed into a 64-bit sort key.
+     * Items are drawn in ascending key order, so the field with the highest offset decides
+     * first. Values wider than their field are truncated, a field with 0 bits is ignored.
+     * Games with e.g. a single shader can give its bits to depth or texture.
+     */
+    struct render_key_layout
+    {
+        render_key_field layer {56, 8};
+        render_key_field shader {44, 12};
+        render_key_field texture {28, 16};
+        render_key_field depth {0, 28};
+
+        constexpr u64 encode(u32 layer_value, u32 shader_value, u32 texture_value,
+                             u32 depth_value) const
+        {
+            return layer.encode(layer_value) | shader.encode(shader_value)
+                   | texture.encode(texture_value) | depth.encode(depth_value);
+        }
+
+        /**
+         * Fields fit in 64 bits and do not overlap
+         */
+        constexpr bool is_valid() const
+        {
+            const render_key_field fields[] = {layer, shader, texture, depth};
+            u64 used = 0;
+            for(const render_key_field& field : fields) {
+                if(field.bits > 32 || field.offset + field.bits > 64)
+                    return false;
+                if(used & field.mask())
+                    return false;
+                used |= field.mask();
+            }
+            return true;
+        }
+    };
+}
+
+#endif //SCARECROW2D_RENDER_KEY_H
@@ -4,27 +4,25 @@
 
 #include "renderable.h"
 #include "math/transform.h"
+#include "math/utils.h"
+#include <cmath>
 
 namespace sc2d
 {
     void renderable_2d::set_texture(GLuint texid)
     {
+        // sampler is set to the texture unit on draw
         this->texid = texid;
-        shader.run();
-        shader.set_int(shader_const::IMG, texid);
     }
 
     void renderable_2d::set_texture_array(const GLuint texid)
     {
         this->texid = texid;
-        shader.run();
-        shader.set_int(shader_const::IMG_ARRAY, texid);
     }
 
     void renderable_2d::set_color(const colorRGB& color)
     {
-        shader.run();
-        shader.set_vec3(shader_const::IMG_COLOR, color);
+        this->color = color;
     }
 
     void transformable_2d::set_pos(const math::vec2& pos)
@@ -46,27 +44,28 @@ namespace sc2d
     }
 
     void transformable_2d::set_transfdata(const math::vec2& pos, const math::vec2& size,
-                                                     const float rot, const math::mat4& projection)
+                                          const float rot)
     {
         this->pos = pos;
         this->size = size;
         this->rot = rot;
-        this->projection = projection;
         update_transform();
     }
 
     void transformable_2d::set_transform(const math::mat4& transform)
     {
         this->transform = transform;
-        this->shader.run();
-        this->shader.set_mat4(shader_const::MVP, transform * projection);
     }
 
-    void transformable_2d::set_projection(const math::mat4& projection)
+    math::rect2d transformable_2d::get_bounds() const
     {
-        this->projection = projection;
-        this->shader.run();
-        this->shader.set_mat4(shader_const::MVP, transform * projection);
+        // rot is in degrees, see math::axis_angle
+        const float radians = math::utils::deg2rad(rot);
+        const float c = std::fabs(std::cos(radians));
+        const float s = std::fabs(std::sin(radians));
+        const math::vec2 half(0.5f * (size.x * c + size.y * s), 0.5f * (size.x * s + size.y * c));
+        const math::vec2 center = pos + size * 0.5f;
+        return math::rect2d::from_min_max(center - half, center + half);
     }
 
     void transformable_2d::update_transform()
@@ -74,8 +73,5 @@ namespace sc2d
         transform =
             math::transform(math::vec3(size.x, size.y, 1.0f), math::vec3(0.0f, 0.0f, 1.0f), rot,
                             math::vec3(0.5f * size.x + pos.x, 0.5f * size.y + pos.y, 0.0f));
-
-        this->shader.run();
-        this->shader.set_mat4(shader_const::MVP, transform * projection);
     }
 }
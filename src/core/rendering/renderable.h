@@ -5,6 +5,7 @@
 #ifndef SCARECROW2D_RENDERABLE_H
 #define SCARECROW2D_RENDERABLE_H
 
+#include "math/geometry2d.h"
 #include "rendering_types.h"
 #include "shader.h"
 
@@ -16,8 +17,13 @@ namespace sc2d
         Shader shader;
         GLuint texid;
         GLuint quad_vao;
-        u32 layer;
+        u32 layer = 0;
+        // order inside layer, shader and texture, lower is drawn first
+        u32 depth = 0;
         u32 instances_count;
+        // Per sprite values RenderQueue streams when it merges sprites into one draw
+        math::mat4 transform;
+        colorRGB color = Color::WHITE;
     };
 
     struct renderable_2d : rend_data2d
@@ -32,16 +38,18 @@ namespace sc2d
         void set_pos(const math::vec2& pos);
         void set_size(const math::vec2& size);
         void set_rot(const float rot);
-        void set_transfdata(const math::vec2& pos, const math::vec2& size, const float rot, const math::mat4& projection);
+        void set_transfdata(const math::vec2& pos, const math::vec2& size, const float rot);
         void set_transform(const math::mat4& transform);
-        void set_projection(const math::mat4& projection);
         void update_transform();
 
+        /**
+         * Axis-aligned box around the rotated quad, in world units
+         */
+        math::rect2d get_bounds() const;
+
         math::vec2 size;
         math::vec2 pos;
         float rot;
-        math::mat4 transform;
-        math::mat4 projection;
     };
 
     struct obj2d : transformable_2d
@@ -3,16 +3,636 @@
 //
 
 #include "rendering_types.h"
+#include "core/compiler.h"
+#include <cmath>
+#include <utility>
+
+#if COMPILER_AVX2
+#    include <immintrin.h>
+#elif COMPILER_SSE2
+#    include <emmintrin.h>
+#    include <xmmintrin.h>
+#endif
 
 namespace sc2d
 {
+    namespace
+    {
+        constexpr f32 INV_255 = 1.0f / 255.0f;
+
+        /**
+         * Corners of a sprite relative to its origin, before rotation
+         */
+        struct quad_extent
+        {
+            f32 left;
+            f32 bottom;
+            f32 right;
+            f32 top;
+        };
+
+        quad_extent extent_of(const math::vec2& size, const math::vec2& origin)
+        {
+            const f32 left = -origin.x * size.x;
+            const f32 bottom = -origin.y * size.y;
+            return {left, bottom, left + size.x, bottom + size.y};
+        }
+
+        colorRGBA unpack_rgba8(u32 color)
+        {
+            return {(f32)(color & 0xffu) * INV_255, (f32)((color >> 8u) & 0xffu) * INV_255,
+                    (f32)((color >> 16u) & 0xffu) * INV_255, (f32)(color >> 24u) * INV_255};
+        }
+
+        u16 pack_unorm16(f32 value)
+        {
+            return (u16)(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+        }
+
+        /**
+         * Builds vertices of QuadT, colors are converted to its format
+         */
+        template <typename QuadT>
+        struct quad_traits;
+
+        template <>
+        struct quad_traits<QuadColored>
+        {
+            using color_type = colorRGBA;
+
+            static colorRGBA color(const colorRGBA& color)
+            {
+                return color;
+            }
+
+            static colorRGBA color(u32 color)
+            {
+                return unpack_rgba8(color);
+            }
+
+            static VertexColored vertex(f32 x, f32 y, f32 u, f32 v, const colorRGBA& color,
+                                        u32 tex_index)
+            {
+                return {math::vec2(x, y), math::vec2(u, v), color, tex_index};
+            }
+        };
+
+        template <>
+        struct quad_traits<QuadPacked>
+        {
+            using color_type = u32;
+
+            static u32 color(const colorRGBA& color)
+            {
+                return pack_rgba8(color);
+            }
+
+            static u32 color(u32 color)
+            {
+                return color;
+            }
+
+            static VertexPacked vertex(f32 x, f32 y, f32 u, f32 v, u32 color, u32 tex_index)
+            {
+                return {math::vec2(x, y), {pack_unorm16(u), pack_unorm16(v)}, color, tex_index};
+            }
+        };
+
+        template <typename QuadT, typename Color>
+        void write_quad(QuadT& quad, const math::vec2& pos, const quad_extent& ext, f32 sin_r,
+                        f32 cos_r, const uv_rect& uv, const Color& color, u32 tex_index)
+        {
+            using traits = quad_traits<QuadT>;
+            const typename traits::color_type vertex_color = traits::color(color);
+            const auto corner = [&](f32 x, f32 y, f32 u, f32 v) {
+                return traits::vertex(pos.x + x * cos_r - y * sin_r, pos.y + x * sin_r + y * cos_r,
+                                      u, v, vertex_color, tex_index);
+            };
+            // Same corner order and uv orientation as the axis-aligned add
+            quad.tr = corner(ext.left, ext.top, uv.min.x, uv.max.y);
+            quad.br = corner(ext.right, ext.top, uv.max.x, uv.max.y);
+            quad.bl = corner(ext.right, ext.bottom, uv.max.x, uv.min.y);
+            quad.tl = corner(ext.left, ext.bottom, uv.min.x, uv.min.y);
+        }
+
+        template <typename QuadT>
+        void write_quad(QuadT& quad, const sprite_arrays& sprites, size_t i, u32 tex_index)
+        {
+            const f32 rotation = sprites.rotation ? sprites.rotation[i] : 0.0f;
+            write_quad(quad, {sprites.x[i], sprites.y[i]},
+                       extent_of({sprites.width[i], sprites.height[i]}, sprites.origin),
+                       std::sin(rotation), std::cos(rotation),
+                       sprites.uv ? sprites.uv[i] : uv_rect {}, sprites.color[i], tex_index);
+        }
+
+#if COMPILER_SSE2
+        constexpr f32 PI = 3.14159265f;
+        constexpr f32 HALF_PI = 1.57079633f;
+        constexpr f32 INV_TWO_PI = 0.159154943f;
+        // 2 * pi split so that k * TWO_PI_HI is exact for the multiples used in reduction
+        constexpr f32 TWO_PI_HI = 6.28125f;
+        constexpr f32 TWO_PI_LO = 1.93530718e-3f;
+
+        // Arithmetic on SIMD lanes, overloaded so the kernel is written once for every width
+        forceinline __m128 add(__m128 a, __m128 b)
+        {
+            return _mm_add_ps(a, b);
+        }
+
+        forceinline __m128 sub(__m128 a, __m128 b)
+        {
+            return _mm_sub_ps(a, b);
+        }
+
+        forceinline __m128 mul(__m128 a, __m128 b)
+        {
+            return _mm_mul_ps(a, b);
+        }
+
+        forceinline __m128 min(__m128 a, __m128 b)
+        {
+            return _mm_min_ps(a, b);
+        }
+
+        forceinline __m128 max(__m128 a, __m128 b)
+        {
+            return _mm_max_ps(a, b);
+        }
+
+        forceinline __m128 round_nearest(__m128 a)
+        {
+            return _mm_cvtepi32_ps(_mm_cvtps_epi32(a));
+        }
+
+        template <typename V>
+        V splat(f32 value);
+
+        template <typename V>
+        V load(const f32* src);
+
+        template <>
+        forceinline __m128 splat<__m128>(f32 value)
+        {
+            return _mm_set1_ps(value);
+        }
+
+        template <>
+        forceinline __m128 load<__m128>(const f32* src)
+        {
+            return _mm_loadu_ps(src);
+        }
+
+#    if COMPILER_AVX2
+        forceinline __m256 add(__m256 a, __m256 b)
+        {
+            return _mm256_add_ps(a, b);
+        }
+
+        forceinline __m256 sub(__m256 a, __m256 b)
+        {
+            return _mm256_sub_ps(a, b);
+        }
+
+        forceinline __m256 mul(__m256 a, __m256 b)
+        {
+            return _mm256_mul_ps(a, b);
+        }
+
+        forceinline __m256 min(__m256 a, __m256 b)
+        {
+            return _mm256_min_ps(a, b);
+        }
+
+        forceinline __m256 max(__m256 a, __m256 b)
+        {
+            return _mm256_max_ps(a, b);
+        }
+
+        forceinline __m256 round_nearest(__m256 a)
+        {
+            return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        }
+
+        template <>
+        forceinline __m256 splat<__m256>(f32 value)
+        {
+            return _mm256_set1_ps(value);
+        }
+
+        template <>
+        forceinline __m256 load<__m256>(const f32* src)
+        {
+            return _mm256_loadu_ps(src);
+        }
+#    endif
+
+        /**
+         * sin of every lane: reduced to [-pi, pi], folded to [-pi/2, pi/2]
+         * with sin(x) = sin(+-pi - x), then Taylor series to x^11 (error below 1e-7)
+         */
+        template <typename V>
+        forceinline V sin_lanes(V x)
+        {
+            const V turns = round_nearest(mul(x, splat<V>(INV_TWO_PI)));
+            x = sub(sub(x, mul(turns, splat<V>(TWO_PI_HI))), mul(turns, splat<V>(TWO_PI_LO)));
+            x = min(x, sub(splat<V>(PI), x));
+            x = max(x, sub(splat<V>(-PI), x));
+
+            const V x2 = mul(x, x);
+            V p = splat<V>(-2.50521084e-8f);
+            p = add(mul(p, x2), splat<V>(2.75573192e-6f));
+            p = add(mul(p, x2), splat<V>(-1.98412698e-4f));
+            p = add(mul(p, x2), splat<V>(8.33333333e-3f));
+            p = add(mul(p, x2), splat<V>(-1.66666667e-1f));
+            p = add(mul(p, x2), splat<V>(1.0f));
+            return mul(x, p);
+        }
+
+        /**
+         * Positions of the tr, br, bl, tl corners of LANES sprites starting at i
+         */
+        template <typename V>
+        forceinline void corner_lanes(const sprite_arrays& sprites, size_t i, V (&cx)[4],
+                                      V (&cy)[4])
+        {
+            const V width = load<V>(sprites.width + i);
+            const V height = load<V>(sprites.height + i);
+            const V left = mul(splat<V>(-sprites.origin.x), width);
+            const V bottom = mul(splat<V>(-sprites.origin.y), height);
+            const V right = add(left, width);
+            const V top = add(bottom, height);
+            const V x = load<V>(sprites.x + i);
+            const V y = load<V>(sprites.y + i);
+
+            if(!sprites.rotation) {
+                cx[0] = add(x, left);
+                cx[1] = add(x, right);
+                cx[2] = cx[1];
+                cx[3] = cx[0];
+                cy[0] = add(y, top);
+                cy[1] = cy[0];
+                cy[2] = add(y, bottom);
+                cy[3] = cy[2];
+                return;
+            }
+
+            const V angle = load<V>(sprites.rotation + i);
+            const V sin_r = sin_lanes(angle);
+            const V cos_r = sin_lanes(add(angle, splat<V>(HALF_PI)));
+            const V left_cos = mul(left, cos_r);
+            const V left_sin = mul(left, sin_r);
+            const V right_cos = mul(right, cos_r);
+            const V right_sin = mul(right, sin_r);
+            const V bottom_cos = mul(bottom, cos_r);
+            const V bottom_sin = mul(bottom, sin_r);
+            const V top_cos = mul(top, cos_r);
+            const V top_sin = mul(top, sin_r);
+            // pos + (x * cos - y * sin, x * sin + y * cos)
+            cx[0] = add(x, sub(left_cos, top_sin));
+            cy[0] = add(y, add(left_sin, top_cos));
+            cx[1] = add(x, sub(right_cos, top_sin));
+            cy[1] = add(y, add(right_sin, top_cos));
+            cx[2] = add(x, sub(right_cos, bottom_sin));
+            cy[2] = add(y, add(right_sin, bottom_cos));
+            cx[3] = add(x, sub(left_cos, bottom_sin));
+            cy[3] = add(y, add(left_sin, bottom_cos));
+        }
+
+        forceinline void store_vertex(VertexColored& vertex, __m128 pos_uv, __m128 color,
+                                      u32 tex_index)
+        {
+            _mm_storeu_ps(&vertex.pos.x, pos_uv);
+            _mm_storeu_ps(&vertex.color.x, color);
+            vertex.tex_index = tex_index;
+        }
+
+        /**
+         * Writes one corner of 4 quads from lanes of x, y, u, v
+         */
+        forceinline void store_corner(QuadColored* out, VertexColored QuadColored::*corner,
+                                      __m128 x, __m128 y, __m128 u, __m128 v, __m128 rgba0,
+                                      __m128 rgba1, __m128 rgba2, __m128 rgba3, u32 tex_index)
+        {
+            _MM_TRANSPOSE4_PS(x, y, u, v);
+            store_vertex(out[0].*corner, x, rgba0, tex_index);
+            store_vertex(out[1].*corner, y, rgba1, tex_index);
+            store_vertex(out[2].*corner, u, rgba2, tex_index);
+            store_vertex(out[3].*corner, v, rgba3, tex_index);
+        }
+
+        /**
+         * uv rects of 4 sprites as lanes, whole textures if uv is nullptr
+         */
+        forceinline void load_uv(const uv_rect* uv, __m128& u_min, __m128& v_min, __m128& u_max,
+                                 __m128& v_max)
+        {
+            if(!uv) {
+                u_min = _mm_setzero_ps();
+                v_min = _mm_setzero_ps();
+                u_max = _mm_set1_ps(1.0f);
+                v_max = _mm_set1_ps(1.0f);
+                return;
+            }
+            // Rows of {min.x, min.y, max.x, max.y} become columns
+            u_min = _mm_loadu_ps(&uv[0].min.x);
+            v_min = _mm_loadu_ps(&uv[1].min.x);
+            u_max = _mm_loadu_ps(&uv[2].min.x);
+            v_max = _mm_loadu_ps(&uv[3].min.x);
+            _MM_TRANSPOSE4_PS(u_min, v_min, u_max, v_max);
+        }
+
+        /**
+         * Interleaves corners, uvs and colors of 4 sprites into vertices
+         */
+        void store_quads(QuadColored* out, const __m128 (&cx)[4], const __m128 (&cy)[4],
+                         const uv_rect* uv, const u32* color, u32 tex_index)
+        {
+            __m128 u_min, v_min, u_max, v_max;
+            load_uv(uv, u_min, v_min, u_max, v_max);
+
+            const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(color));
+            const __m128i byte_mask = _mm_set1_epi32(0xff);
+            const __m128 scale = _mm_set1_ps(INV_255);
+            __m128 r = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(packed, byte_mask)), scale);
+            __m128 g = _mm_mul_ps(
+                _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 8), byte_mask)), scale);
+            __m128 b = _mm_mul_ps(
+                _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 16), byte_mask)), scale);
+            __m128 a = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(packed, 24)), scale);
+            // Now one color per register
+            _MM_TRANSPOSE4_PS(r, g, b, a);
 
-    void QuadBuffer::add(const math::vec2& pos, const math::vec2& size, const colorRGBA& color)
+            store_corner(out, &QuadColored::tr, cx[0], cy[0], u_min, v_max, r, g, b, a, tex_index);
+            store_corner(out, &QuadColored::br, cx[1], cy[1], u_max, v_max, r, g, b, a, tex_index);
+            store_corner(out, &QuadColored::bl, cx[2], cy[2], u_max, v_min, r, g, b, a, tex_index);
+            store_corner(out, &QuadColored::tl, cx[3], cy[3], u_min, v_min, r, g, b, a, tex_index);
+        }
+
+        forceinline void store_vertex(VertexPacked& vertex, __m128 pos_uv_color, u32 tex_index)
+        {
+            _mm_storeu_ps(&vertex.pos.x, pos_uv_color);
+            vertex.tex_index = tex_index;
+        }
+
+        /**
+         * Writes one corner of 4 packed quads, uv and color lanes are already packed
+         */
+        forceinline void store_corner(QuadPacked* out, VertexPacked QuadPacked::*corner,
+                                      __m128 x, __m128 y, __m128i uv, __m128i color,
+                                      u32 tex_index)
+        {
+            __m128 uv_lanes = _mm_castsi128_ps(uv);
+            __m128 color_lanes = _mm_castsi128_ps(color);
+            // {x, y, uv, color} of the corner for each sprite, 16 bytes like the vertex
+            _MM_TRANSPOSE4_PS(x, y, uv_lanes, color_lanes);
+            store_vertex(out[0].*corner, x, tex_index);
+            store_vertex(out[1].*corner, y, tex_index);
+            store_vertex(out[2].*corner, uv_lanes, tex_index);
+            store_vertex(out[3].*corner, color_lanes, tex_index);
+        }
+
+        /**
+         * Same as pack_unorm16 for 4 lanes
+         */
+        forceinline __m128i pack_unorm16_lanes(__m128 value)
+        {
+            value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+            return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, _mm_set1_ps(65535.0f)),
+                                               _mm_set1_ps(0.5f)));
+        }
+
+        void store_quads(QuadPacked* out, const __m128 (&cx)[4], const __m128 (&cy)[4],
+                         const uv_rect* uv, const u32* color, u32 tex_index)
+        {
+            __m128 u_min, v_min, u_max, v_max;
+            load_uv(uv, u_min, v_min, u_max, v_max);
+            const __m128i low_u = pack_unorm16_lanes(u_min);
+            const __m128i high_u = pack_unorm16_lanes(u_max);
+            const __m128i low_v = _mm_slli_epi32(pack_unorm16_lanes(v_min), 16);
+            const __m128i high_v = _mm_slli_epi32(pack_unorm16_lanes(v_max), 16);
+            const __m128i colors = _mm_loadu_si128(reinterpret_cast<const __m128i*>(color));
+
+            store_corner(out, &QuadPacked::tr, cx[0], cy[0], _mm_or_si128(low_u, high_v), colors,
+                         tex_index);
+            store_corner(out, &QuadPacked::br, cx[1], cy[1], _mm_or_si128(high_u, high_v), colors,
+                         tex_index);
+            store_corner(out, &QuadPacked::bl, cx[2], cy[2], _mm_or_si128(high_u, low_v), colors,
+                         tex_index);
+            store_corner(out, &QuadPacked::tl, cx[3], cy[3], _mm_or_si128(low_u, low_v), colors,
+                         tex_index);
+        }
+
+#    if COMPILER_AVX2
+        template <typename QuadT>
+        void store_quads(QuadT* out, const __m256 (&cx)[4], const __m256 (&cy)[4],
+                         const uv_rect* uv, const u32* color, u32 tex_index)
+        {
+            __m128 low_x[4], low_y[4], high_x[4], high_y[4];
+            for(size_t c = 0; c < 4; ++c) {
+                low_x[c] = _mm256_castps256_ps128(cx[c]);
+                low_y[c] = _mm256_castps256_ps128(cy[c]);
+                high_x[c] = _mm256_extractf128_ps(cx[c], 1);
+                high_y[c] = _mm256_extractf128_ps(cy[c], 1);
+            }
+            store_quads(out, low_x, low_y, uv, color, tex_index);
+            store_quads(out + 4, high_x, high_y, uv ? uv + 4 : nullptr, color + 4, tex_index);
+        }
+#    endif
+
+        /**
+         * Writes whole groups of LANES sprites from 'first' on
+         * @return index of the first sprite that was not written
+         */
+        template <typename V, typename QuadT>
+        size_t add_lanes(QuadT* out, const sprite_arrays& sprites, size_t first,
+                         size_t count, u32 tex_index)
+        {
+            constexpr size_t LANES = sizeof(V) / sizeof(f32);
+            size_t i = first;
+            for(; i + LANES <= count; i += LANES) {
+                V cx[4], cy[4];
+                corner_lanes(sprites, i, cx, cy);
+                store_quads(out + i, cx, cy, sprites.uv ? sprites.uv + i : nullptr,
+                            sprites.color + i, tex_index);
+            }
+            return i;
+        }
+#endif
+    }
+
+    template <typename QuadT>
+    void quad_buffer<QuadT>::add(const math::vec2& pos, const math::vec2& size,
+                                 const colorRGBA& color, u32 tex_index)
     {
-        data[index].tr = {math::vec2(pos.x, pos.y + size.y), math::vec2(0, 1), color};
-        data[index].br = {math::vec2(pos.x + size.x, pos.y + size.y), math::vec2(1, 1), color};
-        data[index].bl = {math::vec2(pos.x + size.x, pos.y), math::vec2(1, 0), color};
-        data[index].tl = {math::vec2(pos.x, pos.y), math::vec2(0, 0), color};
+        using traits = quad_traits<QuadT>;
+        const typename traits::color_type vertex_color = traits::color(color);
+        QuadT& quad = data[index];
+        quad.tr = traits::vertex(pos.x, pos.y + size.y, 0, 1, vertex_color, tex_index);
+        quad.br = traits::vertex(pos.x + size.x, pos.y + size.y, 1, 1, vertex_color, tex_index);
+        quad.bl = traits::vertex(pos.x + size.x, pos.y, 1, 0, vertex_color, tex_index);
+        quad.tl = traits::vertex(pos.x, pos.y, 0, 0, vertex_color, tex_index);
         ++index;
     }
-}
\ No newline at end of file
+
+    template <typename QuadT>
+    void quad_buffer<QuadT>::add(const batch_sprite& sprite, u32 tex_index)
+    {
+        uv_rect uv = sprite.uv;
+        if(sprite.flip & FLIP_X)
+            std::swap(uv.min.x, uv.max.x);
+        if(sprite.flip & FLIP_Y)
+            std::swap(uv.min.y, uv.max.y);
+
+        write_quad(data[index], sprite.pos, extent_of(sprite.size, sprite.origin),
+                   std::sin(sprite.rotation), std::cos(sprite.rotation), uv, sprite.color,
+                   tex_index);
+        ++index;
+    }
+
+    template <typename QuadT>
+    size_t quad_buffer<QuadT>::add_many(const sprite_arrays& sprites, size_t count,
+                                        u32 tex_index)
+    {
+        count = std::min(count, limits::DRAWCALL_QUADS - index);
+        QuadT* out = data + index;
+        size_t i = 0;
+#if COMPILER_AVX2
+        i = add_lanes<__m256>(out, sprites, i, count, tex_index);
+#endif
+#if COMPILER_SSE2
+        i = add_lanes<__m128>(out, sprites, i, count, tex_index);
+#endif
+        for(; i < count; ++i)
+            write_quad(out[i], sprites, i, tex_index);
+
+        index += count;
+        return count;
+    }
+
+    template class quad_buffer<QuadColored>;
+    template class quad_buffer<QuadPacked>;
+
+    math::rect2d sprite_bounds(const batch_sprite& sprite)
+    {
+        const quad_extent ext = extent_of(sprite.size, sprite.origin);
+        if(sprite.rotation == 0.0f) {
+            return math::rect2d::from_min_max({sprite.pos.x + ext.left, sprite.pos.y + ext.bottom},
+                                              {sprite.pos.x + ext.right, sprite.pos.y + ext.top});
+        }
+
+        const f32 reach_x = std::max(std::fabs(ext.left), std::fabs(ext.right));
+        const f32 reach_y = std::max(std::fabs(ext.bottom), std::fabs(ext.top));
+        const f32 radius = std::sqrt(reach_x * reach_x + reach_y * reach_y);
+        return math::rect2d::from_min_max({sprite.pos.x - radius, sprite.pos.y - radius},
+                                          {sprite.pos.x + radius, sprite.pos.y + radius});
+    }
+
+    math::rect2d sprite_bounds(const sprite_arrays& sprites, size_t i)
+    {
+        batch_sprite sprite;
+        sprite.pos = {sprites.x[i], sprites.y[i]};
+        sprite.size = {sprites.width[i], sprites.height[i]};
+        sprite.origin = sprites.origin;
+        sprite.rotation = sprites.rotation ? sprites.rotation[i] : 0.0f;
+        return sprite_bounds(sprite);
+    }
+
+    std::pair<size_t, size_t> visible_sprite_run(const sprite_arrays& sprites, size_t first,
+                                                 size_t count, const math::rect2d& view)
+    {
+        size_t begin = first;
+        while(begin < count && !math::rect2d::overlap(view, sprite_bounds(sprites, begin)))
+            ++begin;
+        size_t end = begin;
+        while(end < count && math::rect2d::overlap(view, sprite_bounds(sprites, end)))
+            ++end;
+        return {begin, end};
+    }
+
+    sprite_instance make_sprite_instance(const batch_sprite& sprite, u32 tex_index)
+    {
+        uv_rect uv = sprite.uv;
+        if(sprite.flip & FLIP_X)
+            std::swap(uv.min.x, uv.max.x);
+        if(sprite.flip & FLIP_Y)
+            std::swap(uv.min.y, uv.max.y);
+
+        return {sprite.pos,
+                sprite.size,
+                sprite.rotation,
+                {pack_unorm16(sprite.origin.x), pack_unorm16(sprite.origin.y)},
+                {pack_unorm16(uv.min.x), pack_unorm16(uv.min.y), pack_unorm16(uv.max.x),
+                 pack_unorm16(uv.max.y)},
+                pack_rgba8(sprite.color),
+                tex_index};
+    }
+
+    void make_sprite_instances(const sprite_arrays& sprites, size_t count, u32 tex_index,
+                               sprite_instance* out)
+    {
+        const u16 origin_x = pack_unorm16(sprites.origin.x);
+        const u16 origin_y = pack_unorm16(sprites.origin.y);
+        for(size_t i = 0; i < count; ++i) {
+            sprite_instance& instance = out[i];
+            instance.pos = {sprites.x[i], sprites.y[i]};
+            instance.size = {sprites.width[i], sprites.height[i]};
+            instance.rotation = sprites.rotation ? sprites.rotation[i] : 0.0f;
+            instance.origin[0] = origin_x;
+            instance.origin[1] = origin_y;
+            if(sprites.uv) {
+                const uv_rect& uv = sprites.uv[i];
+                instance.uv[0] = pack_unorm16(uv.min.x);
+                instance.uv[1] = pack_unorm16(uv.min.y);
+                instance.uv[2] = pack_unorm16(uv.max.x);
+                instance.uv[3] = pack_unorm16(uv.max.y);
+            } else {
+                instance.uv[0] = instance.uv[1] = 0;
+                instance.uv[2] = instance.uv[3] = 65535;
+            }
+            instance.color = sprites.color[i];
+            instance.tex_index = tex_index;
+        }
+    }
+
+    chunk_tile pack_chunk_tile(u32 gid)
+    {
+        // Tiled keeps the flags in bits 31..29, the same order as the chunk tile bits 15..13
+        const u32 id = gid & 0x1fffffffu;
+        // Truncating would wrap the tile index and spill its high bits into the flip flags
+        if(id > CHUNK_TILE_GID_MASK)
+            return 0;
+        return (chunk_tile)((gid >> 16u) & ~(u32)CHUNK_TILE_GID_MASK) | (chunk_tile)id;
+    }
+
+    bool chunk_tiles_fit(const grid2d<u32>& gids)
+    {
+        for(u32 y = 0; y < gids.height(); ++y) {
+            for(u32 x = 0; x < gids.width(); ++x) {
+                if((gids(x, y) & 0x1fffffffu) > CHUNK_TILE_GID_MASK)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    u32 fill_tile_chunk(const grid2d<u32>& gids, u32 chunk_x, u32 chunk_y, chunk_tile* out)
+    {
+        constexpr u32 SIZE = limits::TILE_CHUNK_SIZE;
+        const u32 first_x = chunk_x * SIZE;
+        const u32 first_y = chunk_y * SIZE;
+        const u32 width = std::min(SIZE, gids.width() - std::min(first_x, gids.width()));
+        const u32 height = std::min(SIZE, gids.height() - std::min(first_y, gids.height()));
+
+        std::fill_n(out, limits::TILE_CHUNK_TILES, chunk_tile(0));
+        u32 used = 0;
+        for(u32 y = 0; y < height; ++y) {
+            for(u32 x = 0; x < width; ++x) {
+                const chunk_tile tile = pack_chunk_tile(gids(first_x + x, first_y + y));
+                out[y * SIZE + x] = tile;
+                if(tile & CHUNK_TILE_GID_MASK)
+                    used = y * SIZE + x + 1;
+            }
+        }
+        return used;
+    }
+}
@@ -3,36 +3,165 @@
 //
 
 #include "renderqueue.h"
+#include "collections/radix_sort.h"
+#include "core/dbg/dbg_asserts.h"
+#include "gl_state.h"
+#include "unit_quad.h"
 #include <algorithm>
+#include <cstddef>
 
 namespace sc2d
 {
-    void sc2d::RenderQueue::pop()
+    namespace
     {
-        rendq.pop_back();
+        // Sprites per instanced draw
+        constexpr size_t RUN_SPRITES = limits::SPRITE_INSTANCES;
+        constexpr size_t STREAM_FLUSHES = 4;
+
+        /**
+         * Instance record of a merged sprite, read by sprite_default as l_model and l_color
+         */
+        struct sprite_instance_data
+        {
+            math::mat4 model;
+            colorRGB color;
+        };
+
+        bool is_mergeable(const rend_data2d& item, GLuint quad_vao)
+        {
+            return item.instances_count == 0 && item.quad_vao == quad_vao;
+        }
+    }
+
+    RenderQueue::RenderQueue(const render_key_layout& layout)
+    {
+        set_key_layout(layout);
+    }
+
+    void RenderQueue::init()
+    {
+        const unit_quad& quad = unit_quad::get();
+        glGenVertexArrays(1, &instance_vao);
+        GLState::bind_vertex_array(instance_vao);
+        quad.attach();
+        instance_stream.init(GL_ARRAY_BUFFER,
+                             sizeof(sprite_instance_data) * RUN_SPRITES * STREAM_FLUSHES);
+        // Pointers are set by every merged draw, their offset moves along the stream
+        for(GLuint column = 0; column < 4; ++column) {
+            glEnableVertexAttribArray(SPRITE_MODEL_LOCATION + column);
+            glVertexAttribDivisor(SPRITE_MODEL_LOCATION + column, 1);
+        }
+        glEnableVertexAttribArray(SPRITE_COLOR_LOCATION);
+        glVertexAttribDivisor(SPRITE_COLOR_LOCATION, 1);
+        DBG_WARN_ON_RENDER_ERR
+    }
+
+    void RenderQueue::destroy()
+    {
+        instance_stream.destroy();
+        GLState::forget_vertex_array(instance_vao);
+        glDeleteVertexArrays(1, &instance_vao);
+        instance_vao = 0;
+    }
+
+    void RenderQueue::pop()
+    {
+        sort();
+        items.pop_back();
     }
 
-    void sc2d::RenderQueue::sort()
+    void RenderQueue::clear()
     {
-        std::stable_sort(rendq.begin(), rendq.end(), rendqitem_compare());
+        items.clear();
+        sorted = true;
     }
 
-    // TODO: check for the same shader & texture ids
-    void sc2d::RenderQueue::draw()
+    void RenderQueue::set_key_layout(const render_key_layout& layout)
     {
-        for(const rend_data2d* i : rendq) {
+        DBG_FAIL_IF(!layout.is_valid(), "render key fields overlap or exceed 64 bits")
+        key_layout = layout;
+        for(queue_item& item : items)
+            item.key = make_key(*item.data);
+        sorted = items.size() < 2;
+    }
+
+    void RenderQueue::sort()
+    {
+        if(sorted)
+            return;
+
+        scratch.resize(items.size());
+        radix_sort64(items.data(), scratch.data(), items.size(),
+                     [](const queue_item& item) { return item.key; });
+        sorted = true;
+    }
+
+    void RenderQueue::draw()
+    {
+        DBG_FAIL_IF(!instance_vao, "RenderQueue::init was not called")
+        sort();
+        draw_calls = 0;
+        const GLuint quad_vao = unit_quad::get().vao;
+        for(size_t index = 0; index < items.size(); ++draw_calls) {
+            const rend_data2d* i = items[index].data;
+            if(is_mergeable(*i, quad_vao)) {
+                index = draw_sprites(index);
+                continue;
+            }
+
             i->shader.run();
-            glActiveTexture(GL_TEXTURE0 + i->texid);
-            glBindVertexArray(i->quad_vao);
+            GLState::bind_vertex_array(i->quad_vao);
             if(i->instances_count == 0) {
-                glBindTexture(GL_TEXTURE_2D, i->texid);
+                i->shader.set(uniforms::IMG, GLState::bind_texture(GL_TEXTURE_2D, i->texid));
                 glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
             } else {
-                glBindTexture(GL_TEXTURE_2D_ARRAY, i->texid);
+                i->shader.set(uniforms::IMG_ARRAY,
+                              GLState::bind_texture(GL_TEXTURE_2D_ARRAY, i->texid));
                 glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr,
                                         i->instances_count);
             }
+            ++index;
         }
     }
 
-}
\ No newline at end of file
+    size_t RenderQueue::draw_sprites(size_t first)
+    {
+        const rend_data2d& head = *items[first].data;
+        const GLuint program = head.shader.get_program();
+        const size_t end = std::min(items.size(), first + RUN_SPRITES);
+        size_t last = first + 1;
+        while(last < end) {
+            const rend_data2d& item = *items[last].data;
+            if(!is_mergeable(item, head.quad_vao) || item.shader.get_program() != program
+               || item.texid != head.texid)
+                break;
+            ++last;
+        }
+
+        const size_t count = last - first;
+        const size_t size = count * sizeof(sprite_instance_data);
+        const auto [data, offset] = instance_stream.map(size, sizeof(sprite_instance_data));
+        auto* instances = static_cast<sprite_instance_data*>(data);
+        for(size_t i = 0; i < count; ++i) {
+            const rend_data2d& item = *items[first + i].data;
+            instances[i] = {item.transform, item.color};
+        }
+        instance_stream.commit(size);
+
+        head.shader.run();
+        head.shader.set(uniforms::IMG, GLState::bind_texture(GL_TEXTURE_2D, head.texid));
+        GLState::bind_vertex_array(instance_vao);
+        // GL 3.3 has no base instance, the attributes point at this run's instances instead
+        constexpr GLsizei stride = sizeof(sprite_instance_data);
+        for(GLuint column = 0; column < 4; ++column) {
+            const size_t column_offset = offsetof(sprite_instance_data, model)
+                                         + column * sizeof(math::vec4);
+            glVertexAttribPointer(SPRITE_MODEL_LOCATION + column, 4, GL_FLOAT, GL_FALSE, stride,
+                                  (GLvoid*)(offset + column_offset));
+        }
+        glVertexAttribPointer(SPRITE_COLOR_LOCATION, 3, GL_FLOAT, GL_FALSE, stride,
+                              (GLvoid*)(offset + offsetof(sprite_instance_data, color)));
+        glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, (GLsizei)count);
+        return last;
+    }
+}
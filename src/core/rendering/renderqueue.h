@@ -5,50 +5,96 @@
 #ifndef SCARECROW2D_RENDERQUEUE_H
 #define SCARECROW2D_RENDERQUEUE_H
 
+#include "render_key.h"
 #include "renderable.h"
+#include "stream_buffer.h"
 #include <core/log2.h>
 #include <vector>
 
 namespace sc2d
 {
 
+    /**
+     * Items are drawn in order of their packed render key (layer > shader > texture > depth
+     * with the default layout). Keys are taken on push, push only appends and the queue is
+     * radix sorted once before drawing.
+     * Runs of Sprites with the same shader and texture, adjacent after sorting, become one
+     * instanced draw of the shared unit quad with transform and color streamed per sprite.
+     */
     class RenderQueue
     {
-
-        struct rendqitem_compare
-        {
-            // Priority: layer > shader_id > tex_id
-            bool operator()(const rend_data2d* first, const rend_data2d* second)
-            {
-                const auto f_ls = first->layer + first->shader;
-                const auto s_ls = second->layer + second->shader;
-
-                if(first->layer > second->layer) {
-                    return true;
-                } else if(first->shader > second->shader && first->layer >= second->layer) {
-                    return true;
-                } else if(first->texid > second->texid && f_ls >= s_ls) {
-                    return true;
-                }
-                return false;
-            }
-        };
-
     public:
+        RenderQueue() = default;
+        explicit RenderQueue(const render_key_layout& layout);
+
+        /**
+         * Creates the instance stream, needs a current context
+         */
+        void init();
+        void destroy();
         void draw();
+
+        /**
+         * Removes the item drawn last
+         */
         void pop();
+        void clear();
 
         void push(const rend_data2d& item)
         {
-            rendq.emplace_back(&item);
-            if(rendq.size() > 1) {
-                sort();
-            }
+            items.push_back({make_key(item), &item});
+            sorted = false;
         }
 
-    private:
+        /**
+         * Re-keys queued items with the new layout
+         */
+        void set_key_layout(const render_key_layout& layout);
+
+        const render_key_layout& get_key_layout() const
+        {
+            return key_layout;
+        }
+
+        /**
+         * Sorts pushed items, called by draw()
+         */
         void sort();
-        std::vector<const rend_data2d*> rendq;
+
+        /**
+         * Draw calls issued by the last draw()
+         */
+        u32 get_draw_calls() const
+        {
+            return draw_calls;
+        }
+
+    private:
+        struct queue_item
+        {
+            u64 key;
+            const rend_data2d* data;
+        };
+
+        /**
+         * Draws the run of mergeable sprites starting at 'first'
+         * @return index of the first item after the run
+         */
+        size_t draw_sprites(size_t first);
+
+        u64 make_key(const rend_data2d& item) const
+        {
+            return key_layout.encode(item.layer, item.shader.get_program(), item.texid,
+                                     item.depth);
+        }
+
+        render_key_layout key_layout;
+        std::vector<queue_item> items;
+        std::vector<queue_item> scratch;
+        bool sorted = true;
+        StreamBuffer instance_stream;
+        GLuint instance_vao = 0;
+        u32 draw_calls = 0;
     };
 }
 #endif //SCARECROW2D_RENDERQUEUE_H
@@ -0,0 +1,114 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "chunked_tilemap.h"
+#include "core/dbg/dbg_asserts.h"
+#include "core/rendering/gl_state.h"
+#include <algorithm>
+#include <cmath>
+
+namespace sc2d
+{
+    void ChunkedTilemap::init(const Shader& shader, const grid2d<u32>& gids,
+                              const math::vec2& tile_size)
+    {
+        constexpr u32 SIZE = limits::TILE_CHUNK_SIZE;
+        this->shader = shader;
+        this->tile_size = tile_size;
+        chunks_x = (gids.width() + SIZE - 1) / SIZE;
+        chunks_y = (gids.height() + SIZE - 1) / SIZE;
+        chunks.assign((size_t)chunks_x * chunks_y, {0, 0});
+
+        // Chunks with tiles are stored back to back, each one keeps its whole 32x32 layout
+        std::vector<chunk_tile> tiles;
+        chunk_tile chunk[limits::TILE_CHUNK_TILES];
+        for(u32 y = 0; y < chunks_y; ++y) {
+            for(u32 x = 0; x < chunks_x; ++x) {
+                const u32 count = fill_tile_chunk(gids, x, y, chunk);
+                if(count == 0)
+                    continue;
+                chunks[(size_t)y * chunks_x + x] = {(u32)tiles.size(), count};
+                tiles.insert(tiles.end(), chunk, chunk + count);
+            }
+        }
+
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &tile_vbo);
+        GLState::bind_vertex_array(vao);
+        GLState::bind_buffer(GL_ARRAY_BUFFER, tile_vbo);
+        glBufferData(GL_ARRAY_BUFFER, tiles.size() * sizeof(chunk_tile), tiles.data(),
+                     GL_STATIC_DRAW);
+        // Pointer is set for every chunk, its offset moves along tile_vbo
+        glEnableVertexAttribArray(0);
+        glVertexAttribDivisor(0, 1);
+
+        DBG_WARN_ON_RENDER_ERR
+    }
+
+    void ChunkedTilemap::set_texture_array(GLuint texid)
+    {
+        this->texid = texid;
+    }
+
+    void ChunkedTilemap::draw() const
+    {
+        draw_chunks(0, 0, chunks_x, chunks_y);
+    }
+
+    void ChunkedTilemap::draw(const math::rect2d& view) const
+    {
+        // Visible chunks as [x0, x1) x [y0, y1), chunk x covers [x, x + 1) * chunk width
+        const math::vec2 min = math::rect2d::get_min(view);
+        const math::vec2 max = math::rect2d::get_max(view);
+        const auto visible_range = [](f32 from, f32 to, f32 chunk_size, u32 count) {
+            const auto first = (i64)std::floor(from / chunk_size);
+            const auto last = (i64)std::floor(to / chunk_size) + 1;
+            return std::make_pair((u32)std::clamp<i64>(first, 0, count),
+                                  (u32)std::clamp<i64>(last, 0, count));
+        };
+        constexpr auto SIZE = (f32)limits::TILE_CHUNK_SIZE;
+        const auto [x0, x1] = visible_range(min.x, max.x, tile_size.x * SIZE, chunks_x);
+        const auto [y0, y1] = visible_range(min.y, max.y, tile_size.y * SIZE, chunks_y);
+        draw_chunks(x0, y0, x1, y1);
+    }
+
+    void ChunkedTilemap::draw_chunks(u32 x0, u32 y0, u32 x1, u32 y1) const
+    {
+        if(x0 >= x1 || y0 >= y1)
+            return;
+
+        shader.run();
+        shader.set(uniforms::IMG_ARRAY, GLState::bind_texture(GL_TEXTURE_2D_ARRAY, texid));
+        shader.set(uniforms::TILE_SIZE, tile_size);
+        GLState::bind_vertex_array(vao);
+        GLState::bind_buffer(GL_ARRAY_BUFFER, tile_vbo);
+
+        const math::vec2 chunk_size = tile_size * (f32)limits::TILE_CHUNK_SIZE;
+        for(u32 y = y0; y < y1; ++y) {
+            for(u32 x = x0; x < x1; ++x) {
+                const chunk_range& chunk = chunks[(size_t)y * chunks_x + x];
+                if(chunk.count == 0)
+                    continue;
+                // GL 3.3 has no base instance, the attribute points at the chunk instead
+                glVertexAttribIPointer(0, 1, GL_UNSIGNED_SHORT, sizeof(chunk_tile),
+                                       (GLvoid*)(chunk.first * sizeof(chunk_tile)));
+                shader.set(uniforms::CHUNK_ORIGIN,
+                           math::vec2((f32)x * chunk_size.x, (f32)y * chunk_size.y));
+                glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)chunk.count);
+            }
+        }
+        DBG_WARN_ON_RENDER_ERR
+    }
+
+    void ChunkedTilemap::destroy()
+    {
+        GLState::forget_buffer(tile_vbo);
+        glDeleteBuffers(1, &tile_vbo);
+        GLState::forget_vertex_array(vao);
+        glDeleteVertexArrays(1, &vao);
+        tile_vbo = 0;
+        vao = 0;
+        chunks.clear();
+    }
+}
@@ -0,0 +1,65 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_CHUNKED_TILEMAP_H
+#define SCARECROW2D_CHUNKED_TILEMAP_H
+
+#include "collections/grid2d.h"
+#include "core/rendering/rendering_types.h"
+#include "core/rendering/shader.h"
+#include <vector>
+
+namespace sc2d
+{
+    /**
+     * Tile layer split in chunks of limits::TILE_CHUNK_SIZE^2 tiles. Chunks keep up to 2 KB of
+     * chunk_tile in one static buffer and the tilemap_chunk shader makes tile positions from
+     * the instance index, so a chunk is one instanced draw and a tile costs 2 bytes.
+     * Chunks without tiles take no storage and chunks off the view are skipped.
+     */
+    class ChunkedTilemap
+    {
+    public:
+        /**
+         * @param gids Tiled GIDs of the layer, x to the right and y growing with world y
+         * @param tile_size tile size in world units
+         */
+        void init(const Shader& shader, const grid2d<u32>& gids, const math::vec2& tile_size);
+        void set_texture_array(GLuint texid);
+        void draw() const;
+
+        /**
+         * Draws the chunks intersecting view (world units)
+         */
+        void draw(const math::rect2d& view) const;
+        void destroy();
+
+        size_t get_chunk_count() const
+        {
+            return chunks.size();
+        }
+
+    private:
+        // Tiles [first, first + count) of tile_vbo, count is 0 for a chunk without tiles
+        struct chunk_range
+        {
+            u32 first;
+            u32 count;
+        };
+
+        void draw_chunks(u32 x0, u32 y0, u32 x1, u32 y1) const;
+
+        Shader shader;
+        GLuint vao = 0;
+        GLuint tile_vbo = 0;
+        GLuint texid = 0;
+        math::vec2 tile_size;
+        u32 chunks_x = 0;
+        u32 chunks_y = 0;
+        // Row-major, chunks_x * chunks_y
+        std::vector<chunk_range> chunks;
+    };
+}
+
+#endif //SCARECROW2D_CHUNKED_TILEMAP_H
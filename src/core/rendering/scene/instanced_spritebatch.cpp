@@ -0,0 +1,127 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "instanced_spritebatch.h"
+#include "core/dbg/dbg_asserts.h"
+#include "core/rendering/gl_state.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace sc2d
+{
+    void InstancedSpriteBatch::init(const Shader& shader)
+    {
+        this->shader = shader;
+        instances = std::make_unique<sprite_instance[]>(limits::DRAWCALL_SPRITE_INSTANCES);
+        instance_count = 0;
+        texture_count = 0;
+
+        GLint image_units = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &image_units);
+        max_textures = std::clamp<u32>((u32)image_units, 1, limits::BATCH_TEXTURES);
+
+        glGenVertexArrays(1, &vao);
+        GLState::bind_vertex_array(vao);
+        instance_stream.init(GL_ARRAY_BUFFER, sizeof(sprite_instance)
+                                                  * limits::DRAWCALL_SPRITE_INSTANCES
+                                                  * STREAM_FLUSHES);
+        // Pointers are set by every flush, their offset moves along the stream
+        for(GLuint location = 0; location < 6; ++location) {
+            glEnableVertexAttribArray(location);
+            glVertexAttribDivisor(location, 1);
+        }
+
+        DBG_WARN_ON_RENDER_ERR
+    }
+
+    void InstancedSpriteBatch::draw(GLuint texture, const batch_sprite& sprite)
+    {
+        if(culling && !math::rect2d::overlap(view, sprite_bounds(sprite)))
+            return;
+        if(instance_count == limits::DRAWCALL_SPRITE_INSTANCES)
+            flush();
+        const u32 slot = texture_slot(texture);
+        instances[instance_count++] = make_sprite_instance(sprite, slot);
+    }
+
+    void InstancedSpriteBatch::draw_many(GLuint texture, const sprite_arrays& sprites,
+                                         size_t count)
+    {
+        for(size_t drawn = 0; drawn < count;) {
+            if(instance_count == limits::DRAWCALL_SPRITE_INSTANCES)
+                flush();
+            const u32 slot = texture_slot(texture);
+            const size_t added = std::min<size_t>(count - drawn,
+                                                  limits::DRAWCALL_SPRITE_INSTANCES
+                                                      - instance_count);
+            make_sprite_instances(sprites.from(drawn), added, slot, &instances[instance_count]);
+            instance_count += (u32)added;
+            drawn += added;
+        }
+    }
+
+    u32 InstancedSpriteBatch::texture_slot(GLuint texture)
+    {
+        for(u32 slot = 0; slot < texture_count; ++slot) {
+            if(textures[slot] == texture)
+                return slot;
+        }
+
+        if(texture_count == max_textures)
+            flush();
+        textures[texture_count] = texture;
+        return texture_count++;
+    }
+
+    void InstancedSpriteBatch::flush()
+    {
+        if(instance_count == 0)
+            return;
+
+        shader.run();
+        const size_t instances_size = instance_count * sizeof(sprite_instance);
+        const auto [data, offset] = instance_stream.map(instances_size, sizeof(sprite_instance));
+        memcpy(data, instances.get(), instances_size);
+        instance_stream.commit(instances_size);
+
+        // GL 3.3 has no base instance, the attributes point at this flush's instances instead
+        GLState::bind_vertex_array(vao);
+        const auto at = [offset = offset](size_t member) {
+            return (GLvoid*)(offset + member);
+        };
+        constexpr GLsizei stride = sizeof(sprite_instance);
+        // position and size
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride,
+                              at(offsetof(sprite_instance, pos)));
+        glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, stride,
+                              at(offsetof(sprite_instance, rotation)));
+        glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, GL_TRUE, stride,
+                              at(offsetof(sprite_instance, origin)));
+        glVertexAttribPointer(3, 4, GL_UNSIGNED_SHORT, GL_TRUE, stride,
+                              at(offsetof(sprite_instance, uv)));
+        glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                              at(offsetof(sprite_instance, color)));
+        glVertexAttribIPointer(5, 1, GL_UNSIGNED_INT, stride,
+                               at(offsetof(sprite_instance, tex_index)));
+
+        GLint units[limits::BATCH_TEXTURES];
+        for(u32 slot = 0; slot < texture_count; ++slot)
+            units[slot] = GLState::bind_texture(GL_TEXTURE_2D, textures[slot]);
+        shader.set(uniforms::IMGS, units, (GLsizei)texture_count);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)instance_count);
+
+        instance_count = 0;
+        texture_count = 0;
+        DBG_WARN_ON_RENDER_ERR
+    }
+
+    void InstancedSpriteBatch::destroy()
+    {
+        instance_stream.destroy();
+        GLState::forget_vertex_array(vao);
+        glDeleteVertexArrays(1, &vao);
+        instances.reset();
+    }
+}
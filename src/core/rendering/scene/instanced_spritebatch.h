@@ -0,0 +1,66 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_INSTANCED_SPRITEBATCH_H
+#define SCARECROW2D_INSTANCED_SPRITEBATCH_H
+
+#include "core/rendering/rendering_types.h"
+#include "core/rendering/shader.h"
+#include "core/rendering/stream_buffer.h"
+#include <memory>
+
+namespace sc2d
+{
+    /**
+     * SpriteBatch that uploads one sprite_instance (40 bytes) per sprite instead of 4 vertices.
+     * Sprites are instances of a triangle strip the sprite_instanced shader builds from
+     * gl_VertexID, so there is no vertex or index buffer and one draw call takes up to
+     * limits::DRAWCALL_SPRITE_INSTANCES sprites. Texture slots work as in SpriteBatch.
+     * uv is limited to [0, 1].
+     */
+    class InstancedSpriteBatch
+    {
+    public:
+        void init(const Shader& shader);
+        void draw(GLuint texture, const batch_sprite& sprite);
+        void draw_many(GLuint texture, const sprite_arrays& sprites, size_t count);
+        void flush();
+        void destroy();
+
+        /**
+         * Sprites given to draw() that miss the view are skipped, draw_many is not culled
+         */
+        void set_view(const math::rect2d& view)
+        {
+            this->view = view;
+            culling = true;
+        }
+
+        void clear_view()
+        {
+            culling = false;
+        }
+
+    private:
+        static constexpr size_t STREAM_FLUSHES = 2;
+
+        /**
+         * Slot of texture in the current batch, flushes when all slots are taken
+         */
+        u32 texture_slot(GLuint texture);
+
+        std::unique_ptr<sprite_instance[]> instances;
+        u32 instance_count;
+        StreamBuffer instance_stream;
+        GLuint vao;
+        GLuint textures[limits::BATCH_TEXTURES];
+        u32 texture_count;
+        u32 max_textures;
+        Shader shader;
+        math::rect2d view;
+        bool culling = false;
+    };
+}
+
+#endif //SCARECROW2D_INSTANCED_SPRITEBATCH_H
@@ -5,7 +5,9 @@
 #include "sprite.h"
 #include "core/dbg/ogl_errors.h"
 #include "core/log2.h"
+#include "core/rendering/gl_state.h"
 #include "core/rendering/texture.h"
+#include "core/rendering/unit_quad.h"
 #include "math/transform.h"
 
 namespace sc2d
@@ -14,41 +16,19 @@ namespace sc2d
     void Sprite::draw()
     {
         shader.run();
-        glActiveTexture(GL_TEXTURE0 + texid);
-        glBindTexture(GL_TEXTURE_2D, texid);
-        glBindVertexArray(quad_vao);
+        shader.set(uniforms::IMG, GLState::bind_texture(GL_TEXTURE_2D, texid));
+        GLState::bind_vertex_array(quad_vao);
+        // Instance attributes are disabled in the shared VAO, the draw reads these values
+        for(GLuint column = 0; column < 4; ++column)
+            glVertexAttrib4fv(SPRITE_MODEL_LOCATION + column, transform.n[column]);
+        glVertexAttrib3f(SPRITE_COLOR_LOCATION, color.x, color.y, color.z);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
     }
 
     void Sprite::init(const Shader& shader)
     {
         this->shader = shader;
-
-        GLuint vbo;
-        GLuint ebo;
-
-        glGenVertexArrays(1, &quad_vao);
-
-        glGenBuffers(1, &vbo);
-        glGenBuffers(1, &ebo);
-
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * VERTICES_PER_QUAD, QUAD_VERTICES,
-                     GL_STATIC_DRAW);
-        glBindVertexArray(quad_vao);
-
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(QUAD_INDICES), QUAD_INDICES, GL_STATIC_DRAW);
-
-        // position attribute
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)nullptr);
-        glEnableVertexAttribArray(0);
-        //        // texture coord attribute
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                              (GLvoid*)(sizeof(math::vec2)));
-        glEnableVertexAttribArray(1);
-        // color attribute
-        //        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)(sizeof(Vertex) * 2));
-        //        glEnableVertexAttribArray(2);
+        quad_vao = unit_quad::get().vao;
+        instances_count = 0;
     }
 }
@@ -10,6 +10,10 @@
 namespace sc2d
 {
 
+    /**
+     * Textured quad of the sprite_default shader. All sprites share the unit_quad VAO, so
+     * RenderQueue can draw consecutive sprites with the same shader and texture at once.
+     */
     struct Sprite : public obj2d
     {
         void init(const Shader& shader);
@@ -3,16 +3,29 @@
 //
 
 #include "spritebatch.h"
+#include "core/rendering/gl_state.h"
 #include <math/transform.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 
 namespace sc2d
 {
-    void SpriteBatch::init(const Shader& shader, const math::mat4& proj)
+    void SpriteBatch::init(const Shader& shader, batch_format format)
     {
         this->shader = shader;
-        GLuint ebo;
-        quadbuff.index = 0;
+        float_quads.reset();
+        packed_quads.reset();
+        if(format == batch_format::PACKED)
+            packed_quads = std::make_unique<PackedQuadBuffer>();
+        else
+            float_quads = std::make_unique<QuadBuffer>();
         indices_count = 0;
+        texture_count = 0;
+
+        GLint image_units = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &image_units);
+        max_textures = std::clamp<u32>((u32)image_units, 1, limits::BATCH_TEXTURES);
 
         u32 indices[limits::DRAWCALL_INDICES];
         for(u32 offset = 0, i = 0; i < limits::DRAWCALL_INDICES; i += 6) {
@@ -26,73 +39,171 @@ namespace sc2d
         }
 
         glGenVertexArrays(1, &quadvao);
-        glGenBuffers(1, &vbo);
         glGenBuffers(1, &ebo);
-        glBindVertexArray(quadvao);
+        GLState::bind_vertex_array(quadvao);
 
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(VertexColored) * limits::DRAWCALL_VERTICES, nullptr,
-                     GL_DYNAMIC_DRAW);
+        // Room for STREAM_FLUSHES full draw calls per region
+        const size_t quad_size = format == batch_format::PACKED ? sizeof(QuadPacked)
+                                                                : sizeof(QuadColored);
+        vertex_stream.init(GL_ARRAY_BUFFER, quad_size * limits::DRAWCALL_QUADS * STREAM_FLUSHES);
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        GLState::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
 
-        // position attribute
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(VertexColored), (GLvoid*)nullptr);
-        // texture coord attribute
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(VertexColored),
-                              (GLvoid*)(sizeof(math::vec2)));
-        // color attribute
-        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(VertexColored),
-                              (GLvoid*)(sizeof(math::vec2) * 2));
+        if(format == batch_format::PACKED) {
+            // position attribute
+            glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(VertexPacked),
+                                  (GLvoid*)offsetof(VertexPacked, pos));
+            // texture coord attribute, normalized to [0, 1]
+            glVertexAttribPointer(1, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(VertexPacked),
+                                  (GLvoid*)offsetof(VertexPacked, uv));
+            // color attribute, normalized to [0, 1]
+            glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(VertexPacked),
+                                  (GLvoid*)offsetof(VertexPacked, color));
+            // texture slot attribute
+            glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(VertexPacked),
+                                   (GLvoid*)offsetof(VertexPacked, tex_index));
+        } else {
+            // position attribute
+            glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(VertexColored),
+                                  (GLvoid*)offsetof(VertexColored, pos));
+            // texture coord attribute
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(VertexColored),
+                                  (GLvoid*)offsetof(VertexColored, uv));
+            // color attribute
+            glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(VertexColored),
+                                  (GLvoid*)offsetof(VertexColored, color));
+            // texture slot attribute
+            glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(VertexColored),
+                                   (GLvoid*)offsetof(VertexColored, tex_index));
+        }
 
         glEnableVertexAttribArray(0);
         glEnableVertexAttribArray(1);
         glEnableVertexAttribArray(2);
+        glEnableVertexAttribArray(3);
 
         // Generating texture
         const u32 white = 0xffffffff;
         glGenTextures(1, &texid);
-        glBindTexture(GL_TEXTURE_2D, texid);
+        GLState::bind_texture(GL_TEXTURE_2D, texid);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &white);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-        shader.run();
-        shader.set_mat4(shader_const::PROJ, proj);
-        shader.set_int("img", texid);
-
         DBG_WARN_ON_RENDER_ERR
     }
 
     void SpriteBatch::draw(const math::vec2& pos, const math::vec2& size, const colorRGBA& color)
     {
+        if(culling && !math::rect2d::overlap(view, {pos, size}))
+            return;
         // If max indices per draw call reached we should split draw calls
-        if(indices_count >= limits::DRAWCALL_INDICES) {
+        if(indices_count >= limits::DRAWCALL_INDICES)
             flush();
-        }
-        quadbuff.add(pos, size, color);
+        const u32 slot = texture_slot(texid);
+        visit_quads([&](auto& quads) { quads.add(pos, size, color, slot); });
         indices_count += 6;
+    }
 
-        DBG_WARN_ON_RENDER_ERR
+    void SpriteBatch::draw(GLuint texture, const batch_sprite& sprite)
+    {
+        if(culling && !math::rect2d::overlap(view, sprite_bounds(sprite)))
+            return;
+        if(indices_count >= limits::DRAWCALL_INDICES)
+            flush();
+        const u32 slot = texture_slot(texture);
+        visit_quads([&](auto& quads) { quads.add(sprite, slot); });
+        indices_count += 6;
+    }
+
+    void SpriteBatch::draw_many(GLuint texture, const sprite_arrays& sprites, size_t count)
+    {
+        if(!culling) {
+            add_many(texture, sprites, 0, count);
+            return;
+        }
+        // Visible runs keep the SIMD path, sprites are not copied
+        for(size_t first = 0; first < count;) {
+            const auto [begin, end] = visible_sprite_run(sprites, first, count, view);
+            add_many(texture, sprites, begin, end);
+            first = end;
+        }
     }
+
+    void SpriteBatch::add_many(GLuint texture, const sprite_arrays& sprites, size_t begin,
+                               size_t end)
+    {
+        for(size_t drawn = begin; drawn < end;) {
+            if(indices_count >= limits::DRAWCALL_INDICES)
+                flush();
+            const u32 slot = texture_slot(texture);
+            size_t added = 0;
+            visit_quads([&](auto& quads) {
+                added = quads.add_many(sprites.from(drawn), end - drawn, slot);
+            });
+            indices_count += (GLuint)added * 6;
+            drawn += added;
+        }
+    }
+
+    u32 SpriteBatch::texture_slot(GLuint texture)
+    {
+        for(u32 slot = 0; slot < texture_count; ++slot) {
+            if(textures[slot] == texture)
+                return slot;
+        }
+
+        if(texture_count == max_textures)
+            flush();
+        textures[texture_count] = texture;
+        return texture_count++;
+    }
+
     void SpriteBatch::flush()
     {
+        if(indices_count == 0)
+            return;
+
         shader.run();
-        // num_of_objects * sizeof(Vertex) * 4_indices_per_quad
-        const GLsizei vertices_size = quadbuff.index * sizeof(VertexColored) * 4;
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, vertices_size, quadbuff.data);
-        glActiveTexture(GL_TEXTURE0 + texid);
-        glBindTexture(GL_TEXTURE_2D, texid);
-        glBindVertexArray(quadvao);
-        glDrawElements(GL_TRIANGLES, indices_count, GL_UNSIGNED_INT, nullptr);
+        GLint base_vertex = 0;
+        visit_quads([&](auto& quads) {
+            const size_t vertex_size = sizeof(quads.data[0].tr);
+            const size_t vertices_size = quads.size() * sizeof(quads.data[0]);
+            const auto [data, offset] = vertex_stream.map(vertices_size, vertex_size);
+            memcpy(data, quads.data, vertices_size);
+            vertex_stream.commit(vertices_size);
+            base_vertex = (GLint)(offset / vertex_size);
+            quads.clear();
+        });
+
+        GLint units[limits::BATCH_TEXTURES];
+        for(u32 slot = 0; slot < texture_count; ++slot)
+            units[slot] = GLState::bind_texture(GL_TEXTURE_2D, textures[slot]);
+        shader.set(uniforms::IMGS, units, (GLsizei)texture_count);
+        GLState::bind_vertex_array(quadvao);
+        // Indices start from 0 for every flush, base vertex points them at this flush's quads
+        glDrawElementsBaseVertex(GL_TRIANGLES, indices_count, GL_UNSIGNED_INT, nullptr,
+                                 base_vertex);
 
         // Resetting
         indices_count = 0;
-        quadbuff.index = 0;
+        texture_count = 0;
         DBG_WARN_ON_RENDER_ERR
     }
-}
\ No newline at end of file
+
+    void SpriteBatch::destroy()
+    {
+        vertex_stream.destroy();
+        GLState::forget_texture(texid);
+        glDeleteTextures(1, &texid);
+        GLState::forget_vertex_array(quadvao);
+        glDeleteVertexArrays(1, &quadvao);
+        GLState::forget_buffer(ebo);
+        glDeleteBuffers(1, &ebo);
+        float_quads.reset();
+        packed_quads.reset();
+    }
+}
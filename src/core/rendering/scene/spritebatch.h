@@ -6,22 +6,99 @@
 #define SCARECROW2D_SPRITEBATCH_H
 
 #include "core/rendering/renderable.h"
+#include "core/rendering/stream_buffer.h"
 #include "core/dbg/dbg_asserts.h"
+#include <memory>
 
 namespace sc2d
 {
+    /**
+     * Vertex layout of a SpriteBatch, both work with the sprite_batched shader
+     */
+    enum class batch_format
+    {
+        // VertexPacked, 20 bytes per vertex, uv limited to [0, 1]
+        PACKED,
+        // VertexColored, 36 bytes per vertex, for repeating textures
+        FLOAT
+    };
+
+    /**
+     * Collects quads into one vertex stream and draws them with as few calls as possible.
+     * Up to GL_MAX_TEXTURE_IMAGE_UNITS (at most limits::BATCH_TEXTURES) different 2D textures
+     * go into one draw call, each vertex selects its texture by slot. The batch is flushed
+     * when it runs out of quads or texture slots.
+     */
     class SpriteBatch
     {
     public:
-        void init(const Shader& shader, const math::mat4& proj);
+        void init(const Shader& shader, batch_format format = batch_format::PACKED);
+
+        /**
+         * Untextured axis-aligned quad, pos is its bottom left corner
+         */
         void draw(const math::vec2& pos, const math::vec2& size, const colorRGBA& color);
+        void draw(GLuint texture, const batch_sprite& sprite);
+
+        /**
+         * Adds many sprites sharing one texture through the SIMD path of quad_buffer
+         */
+        void draw_many(GLuint texture, const sprite_arrays& sprites, size_t count);
         void flush();
+        void destroy();
+
+        /**
+         * Sprites given to draw() or draw_many() that miss the view are skipped
+         */
+        void set_view(const math::rect2d& view)
+        {
+            this->view = view;
+            culling = true;
+        }
+
+        void clear_view()
+        {
+            culling = false;
+        }
+
     private:
-        QuadBuffer quadbuff;
-        GLuint vbo, quadvao;
+        static constexpr size_t STREAM_FLUSHES = 4;
+
+        /**
+         * Adds sprites [begin, end) of sprites through quad_buffer::add_many
+         */
+        void add_many(GLuint texture, const sprite_arrays& sprites, size_t begin, size_t end);
+
+        /**
+         * Slot of texture in the current batch, flushes when all slots are taken
+         */
+        u32 texture_slot(GLuint texture);
+
+        /**
+         * Calls fn with the quad buffer of the batch format
+         */
+        template <typename Fn>
+        void visit_quads(Fn&& fn)
+        {
+            if(packed_quads)
+                fn(*packed_quads);
+            else
+                fn(*float_quads);
+        }
+
+        // Only the buffer of the chosen format is allocated
+        std::unique_ptr<QuadBuffer> float_quads;
+        std::unique_ptr<PackedQuadBuffer> packed_quads;
+        StreamBuffer vertex_stream;
+        GLuint quadvao, ebo;
         GLuint indices_count;
         GLuint texid;
+        GLuint textures[limits::BATCH_TEXTURES];
+        u32 texture_count;
+        u32 max_textures;
         Shader shader;
+        math::rect2d view;
+        bool culling = false;
     };
 }
 
@@ -5,9 +5,12 @@
 #include "text_ft2.h"
 #include "core/dbg/dbg_asserts.h"
 #include "core/log2.h"
+#include "core/rendering/gl_state.h"
 #include "math/utils.h"
 #include <math/transform.h>
 #include "collections/vec.h"
+#include <algorithm>
+#include <cmath>
 
 namespace sc2d
 {
@@ -73,7 +76,7 @@ namespace sc2d
         font = &fnt;
 
         glGenTextures(1, &texid);
-        glBindTexture(GL_TEXTURE_2D_ARRAY, texid);
+        GLState::bind_texture(GL_TEXTURE_2D_ARRAY, texid);
 
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
         glPixelStorei(GL_UNPACK_ROW_LENGTH, font->texture_width);
@@ -104,13 +107,13 @@ namespace sc2d
         glGenVertexArrays(1, &quad_vao);
         glGenBuffers(1, &vbo);
         glGenBuffers(1, &ebo);
-        glBindVertexArray(quad_vao);
+        GLState::bind_vertex_array(quad_vao);
 
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        GLState::bind_buffer(GL_ARRAY_BUFFER, vbo);
         glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * VERTICES_PER_QUAD, QUAD_VERTICES,
                      GL_STATIC_DRAW);
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        GLState::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(QUAD_INDICES), QUAD_INDICES, GL_STATIC_DRAW);
 
         // position attribute
@@ -146,6 +149,10 @@ namespace sc2d
         vec<u32> char_indices(instances_count);
         vec<math::mat4> model_matrices(instances_count);
         vec<math::vec3> poss(instances_count);
+        // Every element is written below
+        char_indices.resize_uninitialized(instances_count);
+        model_matrices.resize_uninitialized(instances_count);
+        poss.resize_uninitialized(instances_count);
         GLuint glyph_vbo;
         GLuint model_vbo;
         size_t i = 1;
@@ -158,6 +165,11 @@ namespace sc2d
         poss[0] = math::vec3(pos.x, pos.y - font->glyph[*txt_chars].bearing_y + font->ascender, 0.f);
         model_matrices[0] = math::transform(math::vec3(48, 48, 1.0f), math::vec3(0.f, 0.f, 1.0f),
                                             rotation, poss[0]);
+        // Glyph quads are centered on poss (the first one is 48 wide), grown by the rotation
+        const float radians = math::utils::deg2rad(rotation);
+        const float spread = std::fabs(std::cos(radians)) + std::fabs(std::sin(radians));
+        math::vec2 bounds_min(poss[0].x - 24.0f * spread, poss[0].y - 24.0f * spread);
+        math::vec2 bounds_max(poss[0].x + 24.0f * spread, poss[0].y + 24.0f * spread);
 
         // Setting up position for the rest characters.
         for(const auto* ch = txt_chars + 1; i < instances_count; ++ch, ++i) {
@@ -173,11 +185,17 @@ namespace sc2d
             prev_x += advance_x + bearing_x;
             model_matrices[i] = math::transform(math::vec3(font->height, font->height, 1.0f),
                                                 math::vec3(0.0f, 0.0f, 1.0f), rotation, poss[i]);
+            const float half = 0.5f * (float)font->height * spread;
+            bounds_min.x = std::min(bounds_min.x, poss[i].x - half);
+            bounds_min.y = std::min(bounds_min.y, poss[i].y - half);
+            bounds_max.x = std::max(bounds_max.x, poss[i].x + half);
+            bounds_max.y = std::max(bounds_max.y, poss[i].y + half);
         }
+        bounds = math::rect2d::from_min_max(bounds_min, bounds_max);
 
         // setting 'l_glyphid' attribute located in 'glyph_vbo' buffer
         glGenBuffers(1, &glyph_vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, glyph_vbo);
+        GLState::bind_buffer(GL_ARRAY_BUFFER, glyph_vbo);
         glBufferData(GL_ARRAY_BUFFER, sizeof(u32) * instances_count, char_indices.data(), GL_STATIC_DRAW);
         glVertexAttribIPointer(2, 1, GL_UNSIGNED_INT, sizeof(u32), (GLvoid*)nullptr);
         glEnableVertexAttribArray(2);
@@ -185,7 +203,7 @@ namespace sc2d
 
         // setting 'l_model' attribute, located in 'model_vbo' buffer
         glGenBuffers(1, &model_vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, model_vbo);
+        GLState::bind_buffer(GL_ARRAY_BUFFER, model_vbo);
         glBufferData(GL_ARRAY_BUFFER, sizeof(math::mat4) * instances_count, model_matrices.data(), GL_STATIC_DRAW);
 
         // FIXME: copied from "sprite_sheet_inst.cpp : 67"
@@ -214,9 +232,15 @@ namespace sc2d
     void TextFt2::draw()
     {
         shader.run();
-        glActiveTexture(GL_TEXTURE0 + texid);
-        glBindTexture(GL_TEXTURE_2D_ARRAY, texid);
-        glBindVertexArray(quad_vao);
+        shader.set(uniforms::IMG_ARRAY, GLState::bind_texture(GL_TEXTURE_2D_ARRAY, texid));
+        shader.set(uniforms::IMG_COLOR, color);
+        GLState::bind_vertex_array(quad_vao);
         glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, instances_count);
     }
-}
\ No newline at end of file
+
+    void TextFt2::destroy() const
+    {
+        GLState::forget_texture(texid);
+        glDeleteTextures(1, &texid);
+    }
+}
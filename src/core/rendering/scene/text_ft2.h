@@ -70,15 +70,22 @@ namespace sc2d
             return text;
         }
         void set_pos(const math::vec2& pos, float rotation);
-        void draw();
-        void destroy() const
+
+        /**
+         * World box around the glyphs placed by the last set_pos
+         */
+        const math::rect2d& get_bounds() const
         {
-            glDeleteTextures(1, &texid);
-        };
+            return bounds;
+        }
+
+        void draw();
+        void destroy() const;
 
     private:
         const Ft2Font128* font;
         std::string text;
+        math::rect2d bounds;
     };
 }
 #endif //SCARECROW2D_TEXT_FT2_H
@@ -0,0 +1,87 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "tile_index_map.h"
+#include "core/dbg/dbg_asserts.h"
+#include "core/rendering/gl_state.h"
+#include <vector>
+
+namespace sc2d
+{
+    void TileIndexMap::init(const Shader& shader, const grid2d<u32>& gids,
+                            const math::vec2& tile_size)
+    {
+        this->shader = shader;
+        this->tile_size = tile_size;
+        width = gids.width();
+        height = gids.height();
+
+        GLint max_size = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_size);
+        DBG_FAIL_IF(width > (u32)max_size || height > (u32)max_size,
+                    "tile map is larger than the maximum texture size")
+
+        std::vector<chunk_tile> tiles((size_t)width * height);
+        for(u32 y = 0; y < height; ++y) {
+            for(u32 x = 0; x < width; ++x)
+                tiles[(size_t)y * width + x] = pack_chunk_tile(gids(x, y));
+        }
+
+        glGenTextures(1, &tile_texture);
+        GLState::bind_texture(GL_TEXTURE_2D, tile_texture);
+        // Rows of 2 byte texels, other uploads leave their row length behind
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R16UI, width, height, 0, GL_RED_INTEGER,
+                     GL_UNSIGNED_SHORT, tiles.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        // Integer textures are incomplete with filtering or mipmaps
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+        glGenVertexArrays(1, &vao);
+        DBG_WARN_ON_RENDER_ERR
+    }
+
+    void TileIndexMap::set_texture_array(GLuint texid)
+    {
+        this->texid = texid;
+    }
+
+    void TileIndexMap::set_tile(u32 x, u32 y, u32 gid)
+    {
+        DBG_FAIL_IF(x >= width || y >= height, "tile is outside of the map")
+        if(x >= width || y >= height)
+            return;
+        const chunk_tile tile = pack_chunk_tile(gid);
+        GLState::bind_texture(GL_TEXTURE_2D, tile_texture);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_SHORT, &tile);
+    }
+
+    void TileIndexMap::draw() const
+    {
+        if(width == 0 || height == 0)
+            return;
+
+        shader.run();
+        shader.set(uniforms::TILES, GLState::bind_texture(GL_TEXTURE_2D, tile_texture));
+        shader.set(uniforms::IMG_ARRAY, GLState::bind_texture(GL_TEXTURE_2D_ARRAY, texid));
+        shader.set(uniforms::TILE_SIZE, tile_size);
+        GLState::bind_vertex_array(vao);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        DBG_WARN_ON_RENDER_ERR
+    }
+
+    void TileIndexMap::destroy()
+    {
+        GLState::forget_vertex_array(vao);
+        glDeleteVertexArrays(1, &vao);
+        GLState::forget_texture(tile_texture);
+        glDeleteTextures(1, &tile_texture);
+        vao = 0;
+        tile_texture = 0;
+    }
+}
@@ -0,0 +1,54 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_TILE_INDEX_MAP_H
+#define SCARECROW2D_TILE_INDEX_MAP_H
+
+#include "collections/grid2d.h"
+#include "core/rendering/rendering_types.h"
+#include "core/rendering/shader.h"
+
+namespace sc2d
+{
+    /**
+     * Tile layer kept as a R16UI texture of chunk_tile, one texel per tile. It is drawn as one
+     * screen covering quad, the tilemap_lookup shader fetches the tile under every fragment
+     * and samples its atlas layer. Cost is one draw and the screen fill whatever the map
+     * size, so it suits dense layers. Empty tiles are discarded.
+     */
+    class TileIndexMap
+    {
+    public:
+        /**
+         * @param gids Tiled GIDs of the layer, GIDs must fit CHUNK_TILE_GID_MASK
+         * @param tile_size tile size in world units
+         */
+        void init(const Shader& shader, const grid2d<u32>& gids, const math::vec2& tile_size);
+        void set_texture_array(GLuint texid);
+
+        /**
+         * Replaces the tile at x, y with a Tiled GID, uploads a single texel
+         */
+        void set_tile(u32 x, u32 y, u32 gid);
+        void draw() const;
+        void destroy();
+
+        math::rect2d get_bounds() const
+        {
+            return {{0.0f, 0.0f}, {(f32)width * tile_size.x, (f32)height * tile_size.y}};
+        }
+
+    private:
+        Shader shader;
+        // Attribute-less, the shader makes the quad from gl_VertexID
+        GLuint vao = 0;
+        GLuint tile_texture = 0;
+        GLuint texid = 0;
+        math::vec2 tile_size;
+        u32 width = 0;
+        u32 height = 0;
+    };
+}
+
+#endif //SCARECROW2D_TILE_INDEX_MAP_H
@@ -5,8 +5,8 @@
 #include "tiled_map.h"
 #include "../../../../deps/base64/base64.h"
 #include "../../../../deps/miniz/miniz.h"
+#include "core/dbg/dbg_asserts.h"
 #include "core/log2.h"
-#include "collections/arr.h"
 
 namespace sc2d::tiled
 {
@@ -15,74 +15,120 @@ namespace sc2d::tiled
         : tiled_data {tiled_data}
     { }
 
-    void Map::init(const sc2d::Shader& map_shader, const math::mat4& projection)
+    namespace
     {
-        shader = map_shader;
-
-        // cracking layer data
-        // TODO: Move zlib / miniz stuff to another class and wrap it for C++
-        const std::string decoded_data = base64_decode(tiled_data.layers[0].get_data());
-        log_info_cmd("DECODED_DATA: %s", decoded_data.c_str());
-        unsigned* out = nullptr;
-
-        uLongf outlen = tiled_data.width * tiled_data.height * 4;
-        out = (unsigned*)malloc(outlen);
-        int uncmp_status = uncompress((Bytef*)out, &outlen, (const Bytef*)decoded_data.c_str(),
-                                      decoded_data.size());
+        /**
+         * @return false if the layer could not be decompressed or its GIDs do not fit a
+         * chunk_tile, gids is left empty then
+         */
+        bool decode_layer(Layer& layer, u32 width, u32 height, grid2d<u32>& gids)
+        {
+            // cracking layer data
+            // TODO: Move zlib / miniz stuff to another class and wrap it for C++
+            const std::string decoded_data = base64_decode(layer.get_data());
+            uLongf outlen = (uLongf)width * height * sizeof(u32);
+            auto* out = (unsigned*)malloc(outlen);
+            const int uncmp_status = uncompress(
+                (Bytef*)out, &outlen, (const Bytef*)decoded_data.c_str(), decoded_data.size());
 
-        if(uncmp_status != Z_OK) {
-            log_err_cmd("ERROR!");
+            if(uncmp_status != Z_OK) {
+                log_err_cmd("Tile layer %s could not be decompressed", layer.get_name().c_str());
+            } else {
+                gids.assign_row_major(out, width, height);
+            }
             free(out);
-        } else {
-            map_gids.resize(tiled_data.width * tiled_data.height);
-            SpriteSheetInstData sids;
-            u32 sid_idx = 0;
 
-            for(int x = 0; x < tiled_data.width; ++x) {
-                for(int y = 0; y < tiled_data.height; ++y) {
-                    u32 gid = out[y * tiled_data.width + x];
-                    u32 tileset_index = gid;
+            if(!gids.empty() && !chunk_tiles_fit(gids)) {
+                log_err_cmd("Tile layer %s uses GIDs above %u, it is not drawn",
+                            layer.get_name().c_str(), (u32)CHUNK_TILE_GID_MASK);
+                gids = {};
+            }
+            return !gids.empty();
+        }
+    }
+
+    void Map::init(const sc2d::Shader& map_shader, tile_renderer map_renderer)
+    {
+        shader = map_shader;
+        renderer = map_renderer;
 
-                    // Get tileset index
-                    tileset_index &= ~(FLIPPED_HORIZONTALLY_FLAG | FLIPPED_VERTICALLY_FLAG |
-                                       FLIPPED_DIAGONALLY_FLAG);
+        // Layers that fail to decode keep their slot, so layer indices match Tiled's
+        const size_t layer_count = tiled_data.layers.size();
+        layer_gids.assign(layer_count, {});
+        if(renderer == tile_renderer::INDEX_TEXTURE)
+            index_layers.assign(layer_count, {});
+        else
+            chunk_layers.assign(layer_count, {});
 
-                    for(int i = tiled_data.tilesets.size() - 1; i > -1; --i) {
-                        if(tileset_index >= 1)
-                            tileset_index = i;
-                        else
-                            tileset_index = -1;
-                    }
+        const math::vec2 tile_size(tiled_data.tile_width, tiled_data.tile_height);
+        for(size_t i = 0; i < layer_count; ++i) {
+            Layer& layer = tiled_data.layers[i];
+            grid2d<u32>& gids = layer_gids[i];
+            if(!decode_layer(layer, tiled_data.width, tiled_data.height, gids))
+                continue;
 
-                    if(tileset_index != -1) {
-                        map_gids[y * tiled_data.width + x] = gid;
-                        if(gid > 0) {
-                            sids.pos[sid_idx].x = x * tiled_data.tile_width;
-                            sids.pos[sid_idx].y = y * tiled_data.tile_height;
-                            sids.gid[sid_idx] = gid - 1;
-                            ++sid_idx;
-                        }
-                        log_info_cmd("GID: %d", gid);
-                    }
-                }
+            if(renderer == tile_renderer::INDEX_TEXTURE) {
+                index_layers[i].init(shader, gids, tile_size);
+            } else {
+                chunk_layers[i].init(shader, gids, tile_size);
+                log_info_cmd("Tile layer %s: %zu chunks", layer.get_name().c_str(),
+                             chunk_layers[i].get_chunk_count());
             }
-//            log_gl_error_cmd();
-            sprite_sheet.init(shader, math::vec2(tiled_data.tile_width, tiled_data.tile_height),
-                              tiled_data.content_count, projection, sids);
-//            sprite_sheet.set_size(math::vec2(tiled_data.tile_width, tiled_data.tile_height));
-            sprite_sheet.set_color(Color::WHITE);
-            log_info_cmd("VECSIZE: %d", map_gids.size());
         }
-        free(out);
     }
 
     void Map::set_sheet_texture(GLuint texid)
     {
-        sprite_sheet.set_texture_array(texid);
+        for(ChunkedTilemap& chunks : chunk_layers)
+            chunks.set_texture_array(texid);
+        for(TileIndexMap& tile_index : index_layers)
+            tile_index.set_texture_array(texid);
+    }
+
+    void Map::set_tile(u32 layer, u32 x, u32 y, u32 gid)
+    {
+        if(renderer != tile_renderer::INDEX_TEXTURE) {
+            log_err_cmd("Chunked tile maps are static, only INDEX_TEXTURE maps can be edited");
+            return;
+        }
+        if(layer >= layer_gids.size() || !layer_gids[layer].in_bounds((int)x, (int)y)) {
+            log_err_cmd("Tile %u, %u of layer %u is outside of the map", x, y, layer);
+            return;
+        }
+        if((gid & 0x1fffffffu) > CHUNK_TILE_GID_MASK) {
+            log_err_cmd("Tile GID %u is above %u", gid & 0x1fffffffu, (u32)CHUNK_TILE_GID_MASK);
+            return;
+        }
+        layer_gids[layer](x, y) = gid;
+        index_layers[layer].set_tile(x, y, gid);
     }
 
     void Map::draw_map() const
     {
-        sprite_sheet.draw();
+        for(const TileIndexMap& tile_index : index_layers)
+            tile_index.draw();
+        for(const ChunkedTilemap& chunks : chunk_layers)
+            chunks.draw();
+    }
+
+    void Map::draw_map(const math::rect2d& view) const
+    {
+        for(const TileIndexMap& tile_index : index_layers) {
+            if(math::rect2d::overlap(view, tile_index.get_bounds()))
+                tile_index.draw();
+        }
+        for(const ChunkedTilemap& chunks : chunk_layers)
+            chunks.draw(view);
+    }
+
+    void Map::destroy()
+    {
+        for(TileIndexMap& tile_index : index_layers)
+            tile_index.destroy();
+        for(ChunkedTilemap& chunks : chunk_layers)
+            chunks.destroy();
+        index_layers.clear();
+        chunk_layers.clear();
+        layer_gids.clear();
     }
 }
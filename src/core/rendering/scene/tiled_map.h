@@ -5,12 +5,14 @@
 #ifndef INC_2D_GAME_TILED_MAP_H
 #define INC_2D_GAME_TILED_MAP_H
 
-#include "core/rendering/scene/sprite_sheet_inst.h"
+#include "core/rendering/scene/chunked_tilemap.h"
+#include "core/rendering/scene/tile_index_map.h"
 #include "core/rendering/shader.h"
 #include "core/rendering/texture_atlas.h"
 #include "core/types.h"
 #include <string>
-#include "collections/vec.h"
+#include <vector>
+#include "collections/grid2d.h"
 
 namespace sc2d::tiled
 {
@@ -97,20 +99,50 @@ namespace sc2d::tiled
         std::vector<Set> tilesets;
     };
 
+    /**
+     * How a Map draws its tiles, the shader given to Map::init must match
+     */
+    enum class tile_renderer
+    {
+        // ChunkedTilemap with the "tilemap_chunk" shader, sparse layers only pay for their tiles
+        CHUNKED,
+        // TileIndexMap with the "tilemap_lookup" shader, fixed cost for dense layers
+        INDEX_TEXTURE
+    };
+
     class Map
     {
     public:
         Map() = default;
         explicit Map(const Data& tiled_data);
-        void init(const Shader& map_shader, const math::mat4& projection);
+        void init(const Shader& map_shader, tile_renderer map_renderer = tile_renderer::CHUNKED);
         void set_sheet_texture(GLuint texid);
+
+        /**
+         * Replaces a tile of a layer with a Tiled GID, INDEX_TEXTURE maps only,
+         * other maps, tiles outside the map and too large GIDs are logged and ignored
+         */
+        void set_tile(u32 layer, u32 x, u32 y, u32 gid);
+
+        /**
+         * Draws every tile layer, in Tiled's order
+         */
         void draw_map() const;
 
+        /**
+         * Draws only what intersects view (world units)
+         */
+        void draw_map(const math::rect2d& view) const;
+        void destroy();
+
     private:
         Data tiled_data;
         Shader shader;
-        vec<u32> map_gids;
-        SpriteSheetInstanced sprite_sheet;
+        tile_renderer renderer = tile_renderer::CHUNKED;
+        // One entry per Tiled layer, only the vector of the map's renderer is filled
+        std::vector<grid2d<u32>> layer_gids;
+        std::vector<ChunkedTilemap> chunk_layers;
+        std::vector<TileIndexMap> index_layers;
     };
 }
 
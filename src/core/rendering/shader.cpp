@@ -3,10 +3,17 @@
 //
 
 #include "shader.h"
+#include "core/camera.h"
 #include "core/log2.h"
+#include "core/rendering/gl_state.h"
 
 namespace sc2d
 {
+    Shader::Shader()
+    {
+        for(GLint& location : slot_locations)
+            location = -1;
+    }
 
     GLuint Shader::get_program() const
     {
@@ -15,7 +22,7 @@ namespace sc2d
 
     const Shader& Shader::run() const
     {
-        glUseProgram(program);
+        GLState::use_program(program);
         return *this;
     }
 
@@ -55,6 +62,48 @@ namespace sc2d
         }
         glDeleteShader(vert_obj);
         glDeleteShader(frag_obj);
+
+        reflect_uniforms(shader);
+    }
+
+    void ShaderUtil::reflect_uniforms(Shader& shader)
+    {
+        for(GLint& location : shader.slot_locations)
+            location = -1;
+
+        GLint uniform_count = 0;
+        glGetProgramiv(shader.program, GL_ACTIVE_UNIFORMS, &uniform_count);
+        auto table = std::make_shared<Shader::uniform_table>((size_t)uniform_count);
+
+        GLchar name[256];
+        for(GLint i = 0; i < uniform_count; ++i) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = GL_NONE;
+            glGetActiveUniform(shader.program, (GLuint)i, sizeof(name), &length, &size, &type,
+                               name);
+            // arrays are reported as "name[0]"
+            if(size > 1 && length > 3 && name[length - 1] == ']')
+                length -= 3;
+            name[length] = '\0';
+
+            // members of uniform blocks have no location
+            const GLint location = glGetUniformLocation(shader.program, name);
+            if(location < 0)
+                continue;
+
+            const u64 hash = fnv1a_64(name, (size_t)length);
+            table->insert_or_assign(hash, location);
+            for(size_t slot = 0; slot < uniforms::COUNT; ++slot) {
+                if(uniforms::NAMES[slot].value() == hash)
+                    shader.slot_locations[slot] = location;
+            }
+        }
+        shader.all_locations = std::move(table);
+
+        const GLuint camera_block = glGetUniformBlockIndex(shader.program, CAMERA_BLOCK_NAME);
+        if(camera_block != GL_INVALID_INDEX)
+            glUniformBlockBinding(shader.program, camera_block, CAMERA_BLOCK_BINDING);
     }
 
     void ShaderUtil::make_shader(const GLchar* shader_src, GLuint& shader_obj, shader_t shader_type)
@@ -87,29 +136,67 @@ namespace sc2d
         }
     }
 
-    void Shader::set_mat4(const GLchar* name, const math::mat4& matrix) const
+    GLint Shader::get_uniform_location(string_id name) const
+    {
+        if(!all_locations)
+            return -1;
+        const auto it = all_locations->find(name.value());
+        return it != all_locations->end() ? it->second : -1;
+    }
+
+    void Shader::set(uniform_handle<math::mat4> uniform, const math::mat4& matrix) const
     {
-        glUniformMatrix4fv(glGetUniformLocation(program, name), 1, GL_FALSE,
+        glUniformMatrix4fv(slot_locations[uniform.slot], 1, GL_FALSE,
                            (GLfloat*)&matrix.n[0][0]);
     }
 
-    void Shader::set_vec3(const GLchar* name, const math::vec3& value) const
+    void Shader::set(uniform_handle<math::vec3> uniform, const math::vec3& value) const
+    {
+        glUniform3f(slot_locations[uniform.slot], value.x, value.y, value.z);
+    }
+
+    void Shader::set(uniform_handle<math::vec2> uniform, const math::vec2& value) const
+    {
+        glUniform2f(slot_locations[uniform.slot], value.x, value.y);
+    }
+
+    void Shader::set(uniform_handle<GLint> uniform, GLint value) const
+    {
+        glUniform1i(slot_locations[uniform.slot], value);
+    }
+
+    void Shader::set(uniform_handle<GLint> uniform, const GLint* values, GLsizei count) const
+    {
+        glUniform1iv(slot_locations[uniform.slot], count, values);
+    }
+
+    void Shader::set(uniform_handle<GLuint> uniform, GLuint value) const
+    {
+        glUniform1ui(slot_locations[uniform.slot], value);
+    }
+
+    void Shader::set_mat4(string_id name, const math::mat4& matrix) const
+    {
+        glUniformMatrix4fv(get_uniform_location(name), 1, GL_FALSE, (GLfloat*)&matrix.n[0][0]);
+    }
+
+    void Shader::set_vec3(string_id name, const math::vec3& value) const
     {
-        glUniform3f(glGetUniformLocation(program, name), value.x, value.y, value.z);
+        glUniform3f(get_uniform_location(name), value.x, value.y, value.z);
     }
 
-    void Shader::set_vec2(const GLchar* name, const math::vec2& value) const
+    void Shader::set_vec2(string_id name, const math::vec2& value) const
     {
-        glUniform2f(glGetUniformLocation(program, name), value.x, value.y);
+        glUniform2f(get_uniform_location(name), value.x, value.y);
     }
 
-    void Shader::set_int(const GLchar* name, GLint value) const
+    void Shader::set_int(string_id name, GLint value) const
     {
-        glUniform1i(glGetUniformLocation(program, name), value);
+        glUniform1i(get_uniform_location(name), value);
     }
 
-    void Shader::set_uint(const GLchar* name, GLuint value) const
+    void Shader::set_uint(string_id name, GLuint value) const
     {
-        glUniform1ui(glGetUniformLocation(program, name), value);
+        glUniform1ui(get_uniform_location(name), value);
     }
 }
@@ -5,10 +5,13 @@
 #ifndef INC_2D_GAME_SHADER_H
 #define INC_2D_GAME_SHADER_H
 
+#include "collections/flat_map.h"
+#include "core/string_id.h"
 #include "math/matrix4.h"
 #include "math/vector2.h"
 #include "math/vector3.h"
 #include <glad/glad.h>
+#include <memory>
 
 namespace sc2d
 {
@@ -29,26 +32,95 @@ namespace sc2d
     // TODO: add prefix
     namespace shader_const
     {
-        constexpr char* IMG {"img"};
-        constexpr char* IMG_ARRAY {"img_array"};
-        constexpr char* IMG_COLOR {"img_color"};
-        constexpr char* MODEL {"model"};
-        constexpr char* PROJ {"proj"};
-        constexpr char* MVP {"mvp"};
+        constexpr string_id IMG {"img"};
+        constexpr string_id IMG_ARRAY {"img_array"};
+        constexpr string_id IMG_COLOR {"img_color"};
+        constexpr string_id MODEL {"model"};
+        constexpr string_id PROJ {"proj"};
+        constexpr string_id PROJECTION {"projection"};
+        constexpr string_id MVP {"mvp"};
+        constexpr string_id IMGS {"imgs"};
+        constexpr string_id TILE_SIZE {"tile_size"};
+        constexpr string_id CHUNK_ORIGIN {"chunk_origin"};
+        constexpr string_id TILES {"tiles"};
+    }
+
+    /**
+     * Index of a uniform in Shader's location table, typed by its value
+     */
+    template <typename T>
+    struct uniform_handle
+    {
+        u8 slot;
+    };
+
+    /**
+     * Uniforms used by engine shaders, their locations are looked up once at link time
+     */
+    namespace uniforms
+    {
+        constexpr uniform_handle<GLint> IMG {0};
+        constexpr uniform_handle<GLint> IMG_ARRAY {1};
+        constexpr uniform_handle<math::vec3> IMG_COLOR {2};
+        constexpr uniform_handle<math::mat4> MODEL {3};
+        constexpr uniform_handle<math::mat4> PROJ {4};
+        constexpr uniform_handle<math::mat4> PROJECTION {5};
+        constexpr uniform_handle<math::mat4> MVP {6};
+        // sampler2D array
+        constexpr uniform_handle<GLint> IMGS {7};
+        constexpr uniform_handle<math::vec2> TILE_SIZE {8};
+        constexpr uniform_handle<math::vec2> CHUNK_ORIGIN {9};
+        // usampler2D of chunk_tile
+        constexpr uniform_handle<GLint> TILES {10};
+
+        // Names of the slots above, in slot order
+        constexpr string_id NAMES[] = {shader_const::IMG,        shader_const::IMG_ARRAY,
+                                       shader_const::IMG_COLOR,  shader_const::MODEL,
+                                       shader_const::PROJ,       shader_const::PROJECTION,
+                                       shader_const::MVP,        shader_const::IMGS,
+                                       shader_const::TILE_SIZE,  shader_const::CHUNK_ORIGIN,
+                                       shader_const::TILES};
+        constexpr size_t COUNT = sizeof(NAMES) / sizeof(NAMES[0]);
     }
 
     class Shader
     {
         friend class ShaderUtil;
     public:
+        Shader();
+
         GLuint get_program() const;
         const Shader& run() const;
 
-        void set_mat4(const GLchar* name, const math::mat4& matrix) const;
-        void set_vec3(const GLchar* name, const math::vec3& value) const;
-        void set_vec2(const GLchar* name, const math::vec2& value) const;
-        void set_int(const GLchar* name, GLint value) const;
-        void set_uint(const GLchar* name, GLuint value) const;
+        /**
+         * Setting through a handle is an array index, missing uniforms are ignored by GL
+         */
+        void set(uniform_handle<math::mat4> uniform, const math::mat4& matrix) const;
+        void set(uniform_handle<math::vec3> uniform, const math::vec3& value) const;
+        void set(uniform_handle<math::vec2> uniform, const math::vec2& value) const;
+        void set(uniform_handle<GLint> uniform, GLint value) const;
+        /**
+         * Sets 'count' elements of an array uniform starting from the first
+         */
+        void set(uniform_handle<GLint> uniform, const GLint* values, GLsizei count) const;
+        void set(uniform_handle<GLuint> uniform, GLuint value) const;
+
+        void set_mat4(string_id name, const math::mat4& matrix) const;
+        void set_vec3(string_id name, const math::vec3& value) const;
+        void set_vec2(string_id name, const math::vec2& value) const;
+        void set_int(string_id name, GLint value) const;
+        void set_uint(string_id name, GLuint value) const;
+
+        template <typename T>
+        GLint get_uniform_location(uniform_handle<T> uniform) const
+        {
+            return slot_locations[uniform.slot];
+        }
+
+        /**
+         * Looks the name up in the uniforms reflected at link time, -1 if not active
+         */
+        GLint get_uniform_location(string_id name) const;
 
         operator GLuint() const
         {
@@ -56,17 +128,27 @@ namespace sc2d
         }
 
     private:
-        GLuint program;
+        using uniform_table = flat_map<u64, GLint>;
+
+        GLuint program = 0;
+        GLint slot_locations[uniforms::COUNT];
+        // every active uniform by name hash, shared by copies of the shader
+        std::shared_ptr<const uniform_table> all_locations;
     };
 
     struct ShaderUtil
     {
+        /**
+         * Compiles and links the program, reflects its active uniforms and binds
+         * the Camera uniform block
+         */
         static void compile(Shader& shader, const GLchar* vert_src, const GLchar* frag_src,
                             const GLchar* geom_src);
 
     private:
         static void error_checking(GLuint object, shader_t shader_type);
         static void make_shader(const GLchar* shader_src, GLuint& shader_obj, shader_t shader_type);
+        static void reflect_uniforms(Shader& shader);
 
     };
 }
@@ -0,0 +1,114 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "stream_buffer.h"
+#include "core/dbg/dbg_asserts.h"
+#include "core/log2.h"
+#include "core/rendering/gl_state.h"
+
+namespace sc2d
+{
+    namespace
+    {
+        constexpr GLuint64 FENCE_WAIT_NS = 1'000'000;
+    }
+
+    void StreamBuffer::init(GLenum target, size_t region_size)
+    {
+        this->target = target;
+        ring.init(region_size);
+        const size_t capacity = ring.get_capacity();
+
+        glGenBuffers(1, &buffer);
+        GLState::bind_buffer(target, buffer);
+#ifdef GL_ARB_buffer_storage
+        if(GLAD_GL_ARB_buffer_storage) {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(target, capacity, nullptr, flags);
+            persistent = static_cast<u8*>(glMapBufferRange(target, 0, capacity, flags));
+            if(persistent)
+                return;
+
+            // Storage is immutable, start over with a mutable buffer
+            log_warn_cmd("Persistent mapping of stream buffer failed, using orphaning");
+            GLState::forget_buffer(buffer);
+            glDeleteBuffers(1, &buffer);
+            glGenBuffers(1, &buffer);
+            GLState::bind_buffer(target, buffer);
+        }
+#endif
+        glBufferData(target, capacity, nullptr, GL_STREAM_DRAW);
+        DBG_WARN_ON_RENDER_ERR
+    }
+
+    void StreamBuffer::destroy()
+    {
+        for(GLsync& fence : fences) {
+            if(fence)
+                glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        GLState::bind_buffer(target, buffer);
+        if(persistent)
+            glUnmapBuffer(target);
+        persistent = nullptr;
+        GLState::forget_buffer(buffer);
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+
+    StreamBuffer::allocation StreamBuffer::map(size_t size, size_t alignment)
+    {
+        const auto [offset, next_region] = ring.reserve(size, alignment);
+        if(next_region)
+            enter_region(ring.get_region());
+
+        GLState::bind_buffer(target, buffer);
+        if(persistent)
+            return {persistent + offset, offset};
+
+        // Nothing queued reads this range since the last orphaning, no need to sync
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT
+                                 | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+        return {glMapBufferRange(target, offset, size, flags), offset};
+    }
+
+    void StreamBuffer::commit(size_t written)
+    {
+        ring.commit(written);
+        if(persistent)
+            return;
+
+        GLState::bind_buffer(target, buffer);
+        if(written)
+            glFlushMappedBufferRange(target, 0, written);
+        glUnmapBuffer(target);
+    }
+
+    void StreamBuffer::enter_region(u32 region)
+    {
+        if(!persistent) {
+            if(region == 0) {
+                // Orphaning, GL hands out fresh storage while queued draws keep the old one
+                GLState::bind_buffer(target, buffer);
+                glBufferData(target, ring.get_capacity(), nullptr, GL_STREAM_DRAW);
+            }
+            return;
+        }
+
+        // Draws using the region that is left are already queued
+        const u32 left = (region + REGION_COUNT - 1) % REGION_COUNT;
+        fences[left] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        GLsync& fence = fences[region];
+        if(!fence)
+            return;
+
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        while(glClientWaitSync(fence, flags, FENCE_WAIT_NS) == GL_TIMEOUT_EXPIRED)
+            flags = 0;
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
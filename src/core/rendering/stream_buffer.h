@@ -0,0 +1,83 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_STREAM_BUFFER_H
+#define SCARECROW2D_STREAM_BUFFER_H
+
+#include "core/types.h"
+#include "stream_ring.h"
+#include <glad/glad.h>
+#include <cstddef>
+
+namespace sc2d
+{
+    /**
+     * Write-only ring of GPU memory for data rebuilt every frame (batched quads, text, tile
+     * updates). Allocations are carved from the ring one after another and never overwrite
+     * memory the GPU may still read:
+     * - with ARB_buffer_storage the buffer is mapped once (persistent, coherent) and split
+     *   into REGION_COUNT regions, entering a region waits for the fence set when it was
+     *   last left, normally long signaled
+     * - otherwise every allocation is mapped unsynchronized and the buffer is orphaned when
+     *   the ring wraps
+     * Buffer name never changes, so VAOs set up once stay valid, draws pick their data with
+     * the returned offset (base vertex or attribute offset). Offsets come from stream_ring.
+     */
+    class StreamBuffer
+    {
+    public:
+        static constexpr u32 REGION_COUNT = stream_ring::REGION_COUNT;
+
+        struct allocation
+        {
+            /** Write-only, valid until commit() */
+            void* data;
+            /** Byte offset of data in the buffer */
+            size_t offset;
+        };
+
+        /**
+         * Creates the buffer and leaves it bound to target
+         * @param region_size bytes available to the allocations of one frame,
+         *                    single allocation can not be larger
+         */
+        void init(GLenum target, size_t region_size);
+        void destroy();
+
+        /**
+         * Binds the buffer and reserves 'size' bytes at an offset that is a multiple of
+         * 'alignment' (e.g. vertex stride for base vertex draws)
+         */
+        allocation map(size_t size, size_t alignment = 16);
+
+        /**
+         * Finishes the last allocation, 'written' bytes from its start are used by draws
+         */
+        void commit(size_t written);
+
+        GLuint get_buffer() const
+        {
+            return buffer;
+        }
+
+        bool is_persistent() const
+        {
+            return persistent != nullptr;
+        }
+
+    private:
+        /**
+         * Called once ring moved to 'region', fences the region that is left
+         */
+        void enter_region(u32 region);
+
+        GLenum target = GL_ARRAY_BUFFER;
+        GLuint buffer = 0;
+        u8* persistent = nullptr;
+        stream_ring ring;
+        GLsync fences[REGION_COUNT] = {};
+    };
+}
+
+#endif //SCARECROW2D_STREAM_BUFFER_H
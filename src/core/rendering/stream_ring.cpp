@@ -0,0 +1,46 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "stream_ring.h"
+#include "core/dbg/dbg_asserts.h"
+
+namespace sc2d
+{
+    namespace
+    {
+        size_t align_up(size_t value, size_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    void stream_ring::init(size_t region_size)
+    {
+        this->region_size = region_size;
+        head = 0;
+        reserved_offset = 0;
+        region = 0;
+    }
+
+    stream_ring::reservation stream_ring::reserve(size_t size, size_t alignment)
+    {
+        DBG_FAIL_IF(size > region_size, "Stream buffer allocation is larger than a region")
+        size_t offset = align_up(head, alignment);
+        const bool next_region = offset + size > (region + 1) * region_size;
+        if(next_region) {
+            region = (region + 1) % REGION_COUNT;
+            head = region * region_size;
+            offset = align_up(head, alignment);
+            DBG_FAIL_IF(offset + size > (region + 1) * region_size,
+                        "Stream buffer region size must be a multiple of alignment")
+        }
+        reserved_offset = offset;
+        return {offset, next_region};
+    }
+
+    void stream_ring::commit(size_t written)
+    {
+        head = reserved_offset + written;
+    }
+}
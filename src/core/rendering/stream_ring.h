@@ -0,0 +1,72 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_STREAM_RING_H
+#define SCARECROW2D_STREAM_RING_H
+
+#include "core/types.h"
+#include <cstddef>
+
+namespace sc2d
+{
+    /**
+     * Offset bookkeeping of StreamBuffer, kept apart from GL.
+     * The ring is REGION_COUNT regions of region_size bytes. An allocation never straddles
+     * two regions, when it does not fit the rest of the current region the ring moves on to
+     * the next one, after the last region it wraps to the first.
+     */
+    class stream_ring
+    {
+    public:
+        static constexpr u32 REGION_COUNT = 3;
+
+        struct reservation
+        {
+            /** Byte offset in the ring */
+            size_t offset;
+            /** The ring left the previous region, get_region() is the one entered */
+            bool next_region;
+        };
+
+        /**
+         * @param region_size must be a multiple of every alignment passed to reserve()
+         */
+        void init(size_t region_size);
+
+        /**
+         * Reserves 'size' bytes at an offset that is a multiple of 'alignment',
+         * size can not be larger than a region
+         */
+        reservation reserve(size_t size, size_t alignment);
+
+        /**
+         * 'written' bytes from the start of the last reservation are used,
+         * the next one starts after them
+         */
+        void commit(size_t written);
+
+        u32 get_region() const
+        {
+            return region;
+        }
+
+        size_t get_region_size() const
+        {
+            return region_size;
+        }
+
+        size_t get_capacity() const
+        {
+            return region_size * REGION_COUNT;
+        }
+
+    private:
+        size_t region_size = 0;
+        size_t head = 0;
+        size_t reserved_offset = 0;
+        u32 region = 0;
+    };
+}
+
+#endif //SCARECROW2D_STREAM_RING_H
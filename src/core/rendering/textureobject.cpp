@@ -3,6 +3,7 @@
 //
 
 #include "textureobject.h"
+#include "core/rendering/gl_state.h"
 #include "core/types.h"
 #include <type_traits>
 
@@ -50,7 +51,7 @@ namespace sc2d
         if constexpr(std::is_same<T, default_tex2d>::value) {
             texture_type = GL_TEXTURE_2D;
 
-            glBindTexture(GL_TEXTURE_2D, texdata->obj_id);
+            GLState::bind_texture(GL_TEXTURE_2D, texdata->obj_id);
             glTexImage2D(GL_TEXTURE_2D, 0, texdata->internal_format, texdata->width,
                          texdata->height, 0, texdata->image_format, GL_UNSIGNED_BYTE,
                          texdata->data);
@@ -66,7 +67,7 @@ namespace sc2d
             const size_t next_row_offset = tile_width * tile_width;
             size_t ptr_offset = tile_width;
 
-            glBindTexture(GL_TEXTURE_2D_ARRAY, texdata->obj_id);
+            GLState::bind_texture(GL_TEXTURE_2D_ARRAY, texdata->obj_id);
             glPixelStorei(GL_UNPACK_ROW_LENGTH, texdata->width);
             glPixelStorei(GL_UNPACK_IMAGE_HEIGHT, texdata->height);
             glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, texdata->internal_format, tile_width, tile_height,
@@ -90,8 +91,5 @@ namespace sc2d
         glTexParameteri(texture_type, GL_TEXTURE_MIN_FILTER, texdata->filter_min);
         glTexParameteri(texture_type, GL_TEXTURE_WRAP_S, texdata->wrap_s);
         glTexParameteri(texture_type, GL_TEXTURE_WRAP_T, texdata->wrap_t);
-
-        // unbind texture
-        glBindTexture(texture_type, 0);
     }
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "unit_quad.h"
+#include "gl_state.h"
+#include "rendering_types.h"
+#include <cstddef>
+
+namespace sc2d
+{
+    namespace
+    {
+        unit_quad shared_quad;
+    }
+
+    const unit_quad& unit_quad::get()
+    {
+        if(shared_quad.vao)
+            return shared_quad;
+
+        glGenBuffers(1, &shared_quad.vbo);
+        glGenBuffers(1, &shared_quad.ebo);
+        GLState::bind_buffer(GL_ARRAY_BUFFER, shared_quad.vbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * VERTICES_PER_QUAD, QUAD_VERTICES,
+                     GL_STATIC_DRAW);
+
+        glGenVertexArrays(1, &shared_quad.vao);
+        GLState::bind_vertex_array(shared_quad.vao);
+        GLState::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, shared_quad.ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(QUAD_INDICES), QUAD_INDICES, GL_STATIC_DRAW);
+        shared_quad.attach();
+        return shared_quad;
+    }
+
+    void unit_quad::destroy()
+    {
+        if(!shared_quad.vao)
+            return;
+
+        GLState::forget_vertex_array(shared_quad.vao);
+        glDeleteVertexArrays(1, &shared_quad.vao);
+        GLState::forget_buffer(shared_quad.vbo);
+        glDeleteBuffers(1, &shared_quad.vbo);
+        GLState::forget_buffer(shared_quad.ebo);
+        glDeleteBuffers(1, &shared_quad.ebo);
+        shared_quad = {};
+    }
+
+    void unit_quad::attach() const
+    {
+        GLState::bind_buffer(GL_ARRAY_BUFFER, vbo);
+        GLState::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        // position attribute
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                              (GLvoid*)offsetof(Vertex, pos));
+        glEnableVertexAttribArray(0);
+        // texture coord attribute
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                              (GLvoid*)offsetof(Vertex, uv));
+        glEnableVertexAttribArray(1);
+    }
+}
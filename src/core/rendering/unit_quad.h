@@ -0,0 +1,40 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_UNIT_QUAD_H
+#define SCARECROW2D_UNIT_QUAD_H
+
+#include <glad/glad.h>
+
+namespace sc2d
+{
+    // Attributes of the sprite_default shader that are per instance in merged draws
+    constexpr GLuint SPRITE_MODEL_LOCATION = 2;
+    constexpr GLuint SPRITE_COLOR_LOCATION = 6;
+
+    /**
+     * QUAD_VERTICES and QUAD_INDICES uploaded once and shared by every Sprite.
+     * vao has position and uv at locations 0 and 1, other attributes are left disabled so
+     * draws read their current generic values.
+     */
+    struct unit_quad
+    {
+        GLuint vbo = 0;
+        GLuint ebo = 0;
+        GLuint vao = 0;
+
+        /**
+         * Creates the quad on first call, needs a current context
+         */
+        static const unit_quad& get();
+        static void destroy();
+
+        /**
+         * Sets position and uv of the bound VAO to the shared vertices and binds the indices
+         */
+        void attach() const;
+    };
+}
+
+#endif //SCARECROW2D_UNIT_QUAD_H
@@ -0,0 +1,60 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "visibility_tree.h"
+#include "core/dbg/dbg_asserts.h"
+
+namespace sc2d
+{
+    void VisibilityTree::init(const math::rect2d& world)
+    {
+        tree = math::QuadTreeNode(world);
+        entries.clear();
+        entry_of.clear();
+    }
+
+    void VisibilityTree::add(const rend_data2d& item, const math::rect2d& bounds)
+    {
+        DBG_FAIL_IF(entry_of.contains(&item), "item is already in the visibility tree")
+        const auto id = (u32)entries.size();
+        entries.push_back(std::make_unique<math::QuadTreeData>((void*)&item, bounds));
+        entry_of.insert({&item, id});
+        tree.insert(*entries.back());
+    }
+
+    void VisibilityTree::move(const rend_data2d& item, const math::rect2d& bounds)
+    {
+        const auto found = entry_of.find(&item);
+        DBG_FAIL_IF(found == entry_of.end(), "item is not in the visibility tree")
+        math::QuadTreeData& entry = *entries[found->second];
+        tree.remove(entry);
+        entry.bounds = bounds;
+        tree.insert(entry);
+    }
+
+    void VisibilityTree::remove(const rend_data2d& item)
+    {
+        const auto found = entry_of.find(&item);
+        DBG_FAIL_IF(found == entry_of.end(), "item is not in the visibility tree")
+        const u32 id = found->second;
+        tree.remove(*entries[id]);
+        entry_of.erase(&item);
+
+        // Keeps ids dense, the last entry takes the freed id
+        if(id + 1 != entries.size()) {
+            entries[id] = std::move(entries.back());
+            entry_of.insert_or_assign((const rend_data2d*)entries[id]->object, id);
+        }
+        entries.pop_back();
+    }
+
+    size_t VisibilityTree::submit(const math::rect2d& view, RenderQueue& queue)
+    {
+        visible.clear();
+        tree.query(view, visible);
+        for(const math::QuadTreeData* entry : visible)
+            queue.push(*static_cast<const rend_data2d*>(entry->object));
+        return visible.size();
+    }
+}
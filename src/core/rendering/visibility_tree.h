@@ -0,0 +1,58 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_VISIBILITY_TREE_H
+#define SCARECROW2D_VISIBILITY_TREE_H
+
+#include "collections/flat_map.h"
+#include "math/quadtree.h"
+#include "renderqueue.h"
+#include <memory>
+#include <vector>
+
+namespace sc2d
+{
+    /**
+     * Renderables indexed by their world bounds in a QuadTreeNode. submit() pushes only the
+     * ones intersecting the view, so off-screen items never reach the RenderQueue.
+     * Items must stay alive while added, bounds outside 'world' are never found.
+     */
+    class VisibilityTree
+    {
+    public:
+        /**
+         * Starts empty with items expected inside 'world'
+         */
+        void init(const math::rect2d& world);
+
+        void add(const rend_data2d& item, const math::rect2d& bounds);
+        /**
+         * Call after the item moved or was resized
+         */
+        void move(const rend_data2d& item, const math::rect2d& bounds);
+        void remove(const rend_data2d& item);
+
+        /**
+         * Pushes items intersecting view to the queue
+         * @return number of items pushed
+         */
+        size_t submit(const math::rect2d& view, RenderQueue& queue);
+
+        size_t size() const
+        {
+            return entries.size();
+        }
+
+    private:
+        math::QuadTreeNode tree {math::rect2d()};
+        // Items map to their entry index, entries are heap allocated because the tree keeps
+        // pointers
+        std::vector<std::unique_ptr<math::QuadTreeData>> entries;
+        flat_map<const rend_data2d*, u32> entry_of;
+        // Result of the last submit, kept so queries do not allocate
+        std::vector<math::QuadTreeData*> visible;
+    };
+}
+
+#endif //SCARECROW2D_VISIBILITY_TREE_H
@@ -0,0 +1,56 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "string_id.h"
+#include "collections/flat_map.h"
+#include "core/log2.h"
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace sc2d
+{
+    namespace
+    {
+        struct interned_names
+        {
+            std::mutex lock;
+            // Heap copies don't move when the table grows
+            flat_map<u64, std::unique_ptr<char[]>> names;
+        };
+
+        interned_names& get_interned_names()
+        {
+            static interned_names table;
+            return table;
+        }
+    }
+
+    string_id string_table::intern(std::string_view str)
+    {
+        const u64 hash = fnv1a_64(str.data(), str.size());
+        interned_names& table = get_interned_names();
+        std::lock_guard<std::mutex> guard(table.lock);
+
+        auto [it, inserted] = table.names.try_emplace(hash);
+        if(inserted) {
+            it->second.reset(new char[str.size() + 1]);
+            memcpy(it->second.get(), str.data(), str.size());
+            it->second[str.size()] = '\0';
+        } else if(str != it->second.get()) {
+            log_err_cmd("String id collision: '%s' and '%.*s'", it->second.get(), (int)str.size(),
+                        str.data());
+        }
+        return string_id(it->second.get(), str.size());
+    }
+
+    const char* string_table::lookup(u64 hash)
+    {
+        interned_names& table = get_interned_names();
+        std::lock_guard<std::mutex> guard(table.lock);
+
+        auto it = table.names.find(hash);
+        return it != table.names.end() ? it->second.get() : nullptr;
+    }
+}
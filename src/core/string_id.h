@@ -0,0 +1,135 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_STRING_ID_H
+#define SCARECROW2D_STRING_ID_H
+
+#include "types.h"
+#include <functional>
+#include <string_view>
+
+namespace sc2d
+{
+    /**
+     * 64-bit FNV-1a
+     */
+    constexpr u64 fnv1a_64(const char* str, size_t length)
+    {
+        u64 hash = 14695981039346656037ull;
+        for(size_t i = 0; i < length; ++i) {
+            hash ^= (u8)str[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    constexpr size_t constexpr_strlen(const char* str)
+    {
+        size_t length = 0;
+        while(str[length] != '\0')
+            ++length;
+        return length;
+    }
+
+    /**
+     * Hashed name of a resource or uniform, compared and looked up as an integer.
+     * The hash of a literal is computed at compile time when the id is constexpr.
+     * Keeps a pointer to the name, which must outlive the id:
+     * use string_table::intern for names built at runtime.
+     */
+    class string_id
+    {
+    public:
+        constexpr string_id() = default;
+
+        constexpr string_id(const char* str)
+            : string_id(str, constexpr_strlen(str))
+        { }
+
+        constexpr string_id(const char* str, size_t length)
+            : hash(fnv1a_64(str, length))
+            , name(str)
+        { }
+
+        constexpr u64 value() const
+        {
+            return hash;
+        }
+
+        /**
+         * Name the id was made from, "" for default constructed ids
+         */
+        constexpr const char* c_str() const
+        {
+            return name;
+        }
+
+        constexpr bool operator==(const string_id& other) const
+        {
+            return hash == other.hash;
+        }
+
+        constexpr bool operator!=(const string_id& other) const
+        {
+            return hash != other.hash;
+        }
+
+        constexpr bool operator<(const string_id& other) const
+        {
+            return hash < other.hash;
+        }
+
+    private:
+        u64 hash = fnv1a_64("", 0);
+        const char* name = "";
+    };
+
+    namespace literals
+    {
+        constexpr string_id operator""_sid(const char* str, size_t length)
+        {
+            return string_id(str, length);
+        }
+    }
+
+    /**
+     * Global table of interned names, thread safe.
+     * Stored names are never freed, so ids made by intern stay valid.
+     */
+    class string_table
+    {
+    public:
+        /**
+         * Stores a copy of str unless it is already interned.
+         * Logs an error on a hash collision with a different name.
+         */
+        static string_id intern(std::string_view str);
+
+        /**
+         * Reverse lookup for debugging
+         * @return interned name or nullptr
+         */
+        static const char* lookup(u64 hash);
+        static const char* lookup(string_id id)
+        {
+            return lookup(id.value());
+        }
+
+        string_table() = delete;
+    };
+}
+
+namespace std
+{
+    template <>
+    struct hash<sc2d::string_id>
+    {
+        size_t operator()(const sc2d::string_id& id) const
+        {
+            return (size_t)id.value();
+        }
+    };
+}
+
+#endif //SCARECROW2D_STRING_ID_H
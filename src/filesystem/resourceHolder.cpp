@@ -5,14 +5,15 @@
 #include "resourceHolder.h"
 #include "../../deps/stb/stb_image.h"
 #include "core/log2.h"
+#include "core/rendering/gl_state.h"
 
 namespace sc2d
 {
 
-    std::unordered_map<std::string, Shader> ResourceHolder::shaders;
-    std::unordered_map<std::string, Texture2d> ResourceHolder::textures;
-    std::unordered_map<std::string, tiled::Map> ResourceHolder::tilemaps;
-    std::unordered_map<std::string, TextureAtlas> ResourceHolder::texture_atlases;
+    concurrent_map<string_id, Shader> ResourceHolder::shaders;
+    concurrent_map<string_id, Texture2d> ResourceHolder::textures;
+    concurrent_map<string_id, tiled::Map> ResourceHolder::tilemaps;
+    concurrent_map<string_id, TextureAtlas> ResourceHolder::texture_atlases;
 
     void ResourceHolder::load_shader_program(ShaderSource shader_source, const std::string& name,
                                              const GLchar* vert_file, const GLchar* frag_file,
@@ -31,12 +32,12 @@ namespace sc2d
             ShaderUtil::compile(shader, vert_file, frag_file,
                                 geom_file != nullptr ? geom_file : nullptr);
         }
-        shaders.insert({name, shader});
+        shaders.insert_or_assign(string_table::intern(name), std::move(shader));
     }
 
-    const Shader& ResourceHolder::get_shader(const std::string& shader_name)
+    const Shader& ResourceHolder::get_shader(string_id shader_name)
     {
-        return shaders[shader_name];
+        return get_or_default(shaders, shader_name);
     }
 
     void ResourceHolder::load_texture(const std::string& img_file, bool alpha,
@@ -57,23 +58,40 @@ namespace sc2d
             image_format = GL_RGB;
         }
 
-        textures[name] = Texture2d(width, height, internal_format, image_format, GL_REPEAT,
-                                   GL_REPEAT, GL_LINEAR, GL_LINEAR, image);
+        textures.insert_or_assign(string_table::intern(name),
+                                  Texture2d(width, height, internal_format, image_format,
+                                            GL_REPEAT, GL_REPEAT, GL_LINEAR, GL_LINEAR, image));
     }
 
-    const Texture2d& ResourceHolder::get_texture(const std::string& texture_name)
+    const Texture2d& ResourceHolder::get_texture(string_id texture_name)
     {
-        return textures[texture_name];
+        return get_or_default(textures, texture_name);
     }
 
     void ResourceHolder::clean()
     {
-        for(auto [name, shader] : shaders)
+        const auto delete_program = [](const Shader& shader) {
             glDeleteProgram(shader.get_program());
-        for(auto [name, texture] : textures)
+        };
+        const auto delete_texture = [](const auto& texture) {
+            GLState::forget_texture(texture.get_obj_id());
             glDeleteTextures(1, &texture.get_obj_id());
-        for(auto [name, tex_array] : texture_atlases)
-            glDeleteTextures(1, &tex_array.get_obj_id());
+        };
+
+        // reloads keep the replaced resources alive, their GL names are released here too
+        shaders.for_each([&](string_id, const Shader& shader) { delete_program(shader); });
+        shaders.for_each_retired(delete_program);
+        textures.for_each([&](string_id, const Texture2d& texture) { delete_texture(texture); });
+        textures.for_each_retired(delete_texture);
+        texture_atlases.for_each(
+            [&](string_id, const TextureAtlas& tex_array) { delete_texture(tex_array); });
+        texture_atlases.for_each_retired(delete_texture);
+
+        shaders.clear();
+        textures.clear();
+        texture_atlases.clear();
+        tilemaps.clear();
+        GLState::invalidate();
     }
 
     // TODO: remove C++ streams and exceptions
@@ -94,13 +112,12 @@ namespace sc2d
 
     void ResourceHolder::load_tiled_map(const std::string& name, const tiled::Data& tiled_data)
     {
-        tiled::Map tiled_map {tiled_data};
-        tilemaps[name] = tiled_map;
+        tilemaps.insert_or_assign(string_table::intern(name), tiled::Map {tiled_data});
     }
 
-    const tiled::Map& ResourceHolder::get_tiled_map(const std::string& map_name)
+    const tiled::Map& ResourceHolder::get_tiled_map(string_id map_name)
     {
-        return tilemaps[map_name];
+        return get_or_default(tilemaps, map_name);
     }
     void ResourceHolder::load_texture_atlas(const std::string& img_file, const u32 rows,
                                             const u32 columns, bool alpha, const std::string& name)
@@ -120,12 +137,25 @@ namespace sc2d
             image_format = GL_RGB;
         }
 
-        texture_atlases[name] =
+        texture_atlases.insert_or_assign(
+            string_table::intern(name),
             TextureAtlas(width, height, internal_format, image_format, GL_REPEAT, GL_REPEAT,
-                         GL_LINEAR, GL_LINEAR, image, rows, columns);
+                         GL_LINEAR, GL_LINEAR, image, rows, columns));
     }
-    const TextureAtlas& ResourceHolder::get_texture_atlas(const std::string& name)
+    const TextureAtlas& ResourceHolder::get_texture_atlas(string_id name)
     {
-        return texture_atlases[name];
+        return get_or_default(texture_atlases, name);
+    }
+
+    template <typename T>
+    const T& ResourceHolder::get_or_default(const concurrent_map<string_id, T>& resources,
+                                            string_id name)
+    {
+        if(const T* resource = resources.find(name))
+            return *resource;
+
+        log_err_cmd("Resource %s is not loaded", name.c_str());
+        static const T missing {};
+        return missing;
     }
 }
@@ -8,12 +8,13 @@
 #include <fstream>
 #include <sstream>
 #include <string>
-#include <unordered_map>
 
+#include "collections/concurrent_map.h"
 #include "core/rendering/scene/tiled_map.h"
 #include "core/rendering/shader.h"
 #include "core/rendering/texture.h"
 #include "core/rendering/texture_atlas.h"
+#include "core/string_id.h"
 #include "core/types.h"
 
 namespace sc2d
@@ -25,18 +26,26 @@ namespace sc2d
         FILE
     };
 
+    /**
+     * Resources are stored in concurrent maps keyed by hashed names: lookups only take a
+     * shared lock, so other threads may publish resources while the render thread reads.
+     * References returned by get_* functions are valid until clean(), reloading a name
+     * keeps the old resource alive. Missing resources are logged and a default one returned.
+     * Names passed to load_* functions are interned in string_table.
+     * GL objects are still created by load_* on the calling thread.
+     */
     class ResourceHolder
     {
     public:
         static void load_shader_program(ShaderSource shader_source, const std::string& name,
                                         const GLchar* vert_file, const GLchar* frag_file,
                                         const GLchar* geom_file = nullptr);
-        static const Shader& get_shader(const std::string& shader_name);
+        static const Shader& get_shader(string_id shader_name);
         static void load_texture(const std::string& img_file, bool alpha, const std::string& name);
-        static const Texture2d& get_texture(const std::string& texture_name);
+        static const Texture2d& get_texture(string_id texture_name);
         static void load_tiled_map(const std::string& name, const tiled::Data& tiled_data);
-        static const tiled::Map& get_tiled_map(const std::string& map_name);
-        static const TextureAtlas& get_texture_atlas(const std::string& name);
+        static const tiled::Map& get_tiled_map(string_id map_name);
+        static const TextureAtlas& get_texture_atlas(string_id name);
         static void load_texture_atlas(const std::string& img_file, const u32 rows,
                                        const u32 columns, bool alpha, const std::string& name);
 
@@ -49,12 +58,15 @@ namespace sc2d
         ResourceHolder& operator=(ResourceHolder&& other) = delete;
 
     private:
-        static std::unordered_map<std::string, Shader> shaders;
-        static std::unordered_map<std::string, Texture2d> textures;
-        static std::unordered_map<std::string, tiled::Map> tilemaps;
-        static std::unordered_map<std::string, TextureAtlas> texture_atlases;
+        static concurrent_map<string_id, Shader> shaders;
+        static concurrent_map<string_id, Texture2d> textures;
+        static concurrent_map<string_id, tiled::Map> tilemaps;
+        static concurrent_map<string_id, TextureAtlas> texture_atlases;
 
         static std::string load_shader(const GLchar* file_path);
+        template <typename T>
+        static const T& get_or_default(const concurrent_map<string_id, T>& resources,
+                                       string_id name);
     };
 }
 
@@ -11,12 +11,20 @@
 namespace sc2d::cshaders
 {
 
-    constexpr const char* VS_SPRITESHEET = ""
-#include "shaders/spritesheet.vert"
+    constexpr const char* VS_TILEMAP_CHUNK = ""
+#include "shaders/tilemap_chunk.vert"
         ;
 
-    constexpr const char* FS_SPRITESHEET = ""
-#include "shaders/spritesheet.frag"
+    constexpr const char* FS_TILEMAP_CHUNK = ""
+#include "shaders/tilemap_chunk.frag"
+        ;
+
+    constexpr const char* VS_TILEMAP_LOOKUP = ""
+#include "shaders/tilemap_lookup.vert"
+        ;
+
+    constexpr const char* FS_TILEMAP_LOOKUP = ""
+#include "shaders/tilemap_lookup.frag"
         ;
 
     constexpr const char* VS_SPRITE_DEFAULT = ""
@@ -43,6 +51,10 @@ namespace sc2d::cshaders
 #include "shaders/sprite_batched.frag"
         ;
 
+    constexpr const char* VS_SPRITE_INSTANCED = ""
+#include "shaders/sprite_instanced.vert"
+        ;
+
     struct ShadersArray
     {
         const char* vs_src;
@@ -51,9 +63,12 @@ namespace sc2d::cshaders
     };
 
     constexpr const ShadersArray SHADERS_ARRAY[] {
-        {VS_SPRITESHEET, FS_SPRITESHEET, "spritesheet"},
+        {VS_TILEMAP_CHUNK, FS_TILEMAP_CHUNK, "tilemap_chunk"},
+        {VS_TILEMAP_LOOKUP, FS_TILEMAP_LOOKUP, "tilemap_lookup"},
         {VS_SPRITE_DEFAULT, FS_SPRITE_DEFAULT, "sprite_default"},
         {VS_TEXT_FT2, FS_TEXT_FT2, "text_ft2"},
-        {VS_SPRITE_BATCHED, FS_SPRITE_BATCHED, "sprite_batched"}};
+        {VS_SPRITE_BATCHED, FS_SPRITE_BATCHED, "sprite_batched"},
+        // Same fragment stage as the batch, only the way corners are made differs
+        {VS_SPRITE_INSTANCED, FS_SPRITE_BATCHED, "sprite_instanced"}};
 };
 #endif //SCARECROW2D_SHADER_FILES_H
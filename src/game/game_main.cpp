@@ -7,22 +7,30 @@
 #include "core/input_types.h"
 #include "core/log2.h"
 #include "core/rendering/texture.h"
+#include "core/rendering/unit_quad.h"
 #include "core/window.h"
 #include "filesystem/resourceHolder.h"
 #include "menu.h"
 #include <core/dbg/dbg_asserts.h>
 #include "core/rendering/renderqueue.h"
+#include <cmath>
 
 GameMode Game::mode;
 
+namespace
+{
+    // Area the visibility tree indexes, items outside are never drawn
+    const math::rect2d WORLD_BOUNDS({-8192.0f, -8192.0f}, {16384.0f, 16384.0f});
+}
+
 void Game::init(GameMode start_mode, const sc2d::WindowSize& window_size)
 {
     mode = start_mode;
 
     ///------------- INIT TEST SCENE / LEVEL
-    sc2d::Camera camera;
     camera.make_orthographic(window_size.width, window_size.height, sc2d::DEFAULT_Z_NEAR,
                              sc2d::DEFAULT_Z_FAR);
+    camera.init();
 
     // REGULAR SPRITE
     const sc2d::Shader& sprite_shader = sc2d::ResourceHolder::get_shader("sprite_default");
@@ -30,18 +38,16 @@ void Game::init(GameMode start_mode, const sc2d::WindowSize& window_size)
     sprite.init(sprite_shader);
     sprite.set_color(sc2d::Color::WHITE);
     sprite.set_texture(logo_texture);
-    sprite.set_transfdata(math::vec2(0, 0), math::vec2(111, 148), 0, camera.get_proj());
+    sprite.set_transfdata(math::vec2(0, 0), math::vec2(111, 148), 0);
 
     // SPRITE_SHEEEEEEEEEEET
-    const sc2d::Shader& sprite_sheet_shader = sc2d::ResourceHolder::get_shader("spritesheet");
+    const sc2d::Shader& tilemap_shader = sc2d::ResourceHolder::get_shader("tilemap_chunk");
     const sc2d::TextureAtlas tex_atlas = sc2d::ResourceHolder::get_texture_atlas("tilemap");
     tiled_map = sc2d::ResourceHolder::get_tiled_map("wasd");
-    tiled_map.init(sprite_sheet_shader, camera.get_proj());
+    tiled_map.init(tilemap_shader);
     tiled_map.set_sheet_texture(tex_atlas);
 
     const sc2d::Shader& font_shader = sc2d::ResourceHolder::get_shader("text_ft2");
-    font_shader.run();
-    font_shader.set_mat4("projection", camera.get_proj());
     sc2d::Ft2Font128 fnt_04b_03;
     fnt_04b_03.init("data/fonts/04B_03__.TTF", 48);
     text_ft2.init(font_shader, fnt_04b_03);
@@ -50,22 +56,37 @@ void Game::init(GameMode start_mode, const sc2d::WindowSize& window_size)
     text_ft2.set_color(sc2d::Color::CYAN);
 
     const sc2d::Shader& batched_shader = sc2d::ResourceHolder::get_shader("sprite_batched");
-    sprite_batch.init(batched_shader, camera.get_proj());
+    sprite_batch.init(batched_shader);
+    const sc2d::Shader& instanced_shader = sc2d::ResourceHolder::get_shader("sprite_instanced");
+    instanced_batch.init(instanced_shader);
 
 
-    render_queue.push(sprite);
-    render_queue.push(text_ft2);
+    render_queue.init();
+    visibility.init(WORLD_BOUNDS);
+    visibility.add(sprite, sprite.get_bounds());
+    visibility.add(text_ft2, text_ft2.get_bounds());
 
     DBG_WARN_ON_RENDER_ERR
 }
 
-void Game::draw()
+void Game::resize(int width, int height)
 {
+    camera.make_orthographic(width, height, sc2d::DEFAULT_Z_NEAR, sc2d::DEFAULT_Z_FAR);
+}
+
+void Game::draw(float time)
+{
+    camera.update(time);
     if(mode == GameMode::MENU) {
         menu.draw();
     } else {
-        tiled_map.draw_map();
+        const math::rect2d view = camera.get_view_rect();
+        tiled_map.draw_map(view);
+        render_queue.clear();
+        visibility.submit(view, render_queue);
         render_queue.draw();
+        sprite_batch.set_view(view);
+        instanced_batch.set_view(view);
 //        sprite.draw();
 //        text_ft2.draw();
 
@@ -73,13 +94,37 @@ void Game::draw()
         sprite_batch.draw({100,100}, {100, 100}, {1.0, .0f, 1.0f, 1.0f});
         sprite_batch.draw({50,65}, {10, 10}, {1.0, 1.0f, .0f, 1.0f});
         sprite_batch.draw({500,256}, {50, 50}, {0.0, 0.0f, .0f, 1.0f});
+        sc2d::batch_sprite logo;
+        logo.pos = {300.0f, 300.0f};
+        logo.size = {111.0f, 148.0f};
+        logo.origin = {0.5f, 0.5f};
+        logo.rotation = time;
+        sprite_batch.draw(sc2d::ResourceHolder::get_texture("logo"), logo);
         sprite_batch.flush();
+
+        // Ring of small logos around the big one
+        const GLuint logo_texture = sc2d::ResourceHolder::get_texture("logo");
+        for(int i = 0; i < 16; ++i) {
+            const float angle = time * 0.5f + (float)i * 0.3927f;
+            sc2d::batch_sprite small_logo = logo;
+            small_logo.pos = {300.0f + std::cos(angle) * 150.0f, 300.0f + std::sin(angle) * 150.0f};
+            small_logo.size = {22.0f, 30.0f};
+            small_logo.rotation = -time;
+            instanced_batch.draw(logo_texture, small_logo);
+        }
+        instanced_batch.flush();
         //    spritesheet->draw(sc2d::ResourceHolder::get_texture_atlas("tilemap"), math::vec2(0, 0),
         //                     math::size2d(16, 16), 0);
     }
 }
 void Game::destroy()
 {
+    sprite_batch.destroy();
+    instanced_batch.destroy();
+    tiled_map.destroy();
+    render_queue.destroy();
+    sc2d::unit_quad::destroy();
+    camera.destroy();
 //    text_ft2.destroy();
 }
 void Game::read_input(int key, int action)
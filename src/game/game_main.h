@@ -5,11 +5,14 @@
 #ifndef SCARECROW2D_GAME_MAIN_H
 #define SCARECROW2D_GAME_MAIN_H
 
+#include "core/camera.h"
 #include "core/rendering/scene/text_ft2.h"
 #include "core/rendering/scene/tiled_map.h"
 #include "menu.h"
 #include <core/rendering/renderqueue.h>
+#include <core/rendering/visibility_tree.h>
 #include <core/rendering/scene/sprite.h>
+#include <core/rendering/scene/instanced_spritebatch.h>
 #include <core/rendering/scene/spritebatch.h>
 
 enum class GameMode
@@ -26,7 +29,11 @@ namespace sc2d
 struct Game
 {
     void init(GameMode start_mode, const sc2d::WindowSize& size);
-    void draw();
+    void resize(int width, int height);
+    /**
+     * @param time seconds since start
+     */
+    void draw(float time);
     void destroy();
     void read_input(int key, int action);
 
@@ -34,11 +41,14 @@ struct Game
 
 private:
     Menu menu;
+    sc2d::Camera camera;
     sc2d::Sprite sprite;
     sc2d::SpriteBatch sprite_batch;
+    sc2d::InstancedSpriteBatch instanced_batch;
     sc2d::tiled::Map tiled_map;
     sc2d::TextFt2 text_ft2;
     sc2d::RenderQueue render_queue;
+    sc2d::VisibilityTree visibility;
 };
 
 #endif //SCARECROW2D_GAME_MAIN_H
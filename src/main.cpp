@@ -5,6 +5,7 @@
 #include "core/dbg/ogl_errors.h"
 #include "core/input.h"
 #include "core/log2.h"
+#include "core/rendering/gl_state.h"
 #include "core/resources.h"
 #include "core/result.h"
 #include "core/window.h"
@@ -45,9 +46,10 @@ sc2d::ResultBool renderer_init()
     }
 
     glViewport(0, 0, window_data.size.width, window_data.size.height);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    sc2d::GLState::init();
+    sc2d::GLState::blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    sc2d::GLState::set_blend(true);
     glEnable(GL_CULL_FACE);
-    glEnable(GL_BLEND);
     glDisable(GL_DEPTH_TEST);
     glDisable(GL_SCISSOR_TEST);
 //    log_gl_error_cmd();
@@ -85,7 +87,7 @@ int main(int argc, char* argv[])
         glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
         if(main_mode == MainMode::GAME) {
-            game.draw();
+            game.draw((float)glfwGetTime());
         } else {
             Editor::draw();
         }
@@ -116,4 +118,6 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height)
     // make sure the viewport matches the new window dimensions; note that width and
     // height will be significantly larger than specified on retina displays.
     glViewport(0, 0, width, height);
+    if(auto* game = static_cast<Game*>(glfwGetWindowUserPointer(window)))
+        game->resize(width, height);
 }
@@ -82,6 +82,18 @@ namespace math
         {
             return rect2d(min, max - min);
         }
+
+        /**
+         * True if the rectangles intersect or touch
+         */
+        static bool overlap(const rect2d& a, const rect2d& b)
+        {
+            const vec2 amin = get_min(a);
+            const vec2 amax = get_max(a);
+            const vec2 bmin = get_min(b);
+            const vec2 bmax = get_max(b);
+            return amin.x <= bmax.x && bmin.x <= amax.x && amin.y <= bmax.y && bmin.y <= amax.y;
+        }
     };
 
     struct orrect2d
@@ -203,7 +215,7 @@ namespace math
      * @param line
      * @return
      */
-    bool point_on_line(const point2d& point, const line2d& line)
+    inline bool point_on_line(const point2d& point, const line2d& line)
     {
         // Find slope
         float dy = line.end.y - line.start.y;
@@ -224,20 +236,20 @@ namespace math
      * @param c
      * @return
      */
-    bool point_in_circle(const point2d& point, const circle& c)
+    inline bool point_in_circle(const point2d& point, const circle& c)
     {
         line2d line(point, c.position);
         return line2d::lengthSq(line) >= c.radius * c.radius;
     }
 
-    bool point_in_rect(const point2d& point, const rect2d rect)
+    inline bool point_in_rect(const point2d& point, const rect2d rect)
     {
         vec2 min = rect2d::get_min(rect);
         vec2 max = rect2d::get_max(rect);
         return min.x <= point.x && min.y <= point.y && point.x <= max.x && point.y <= max.y;
     }
 
-    bool point_in_orrect(const point2d& point, const orrect2d rect)
+    inline bool point_in_orrect(const point2d& point, const orrect2d rect)
     {
         rect2d local_rect {point2d(), rect.half_extends * 2.0f};
         vec2 rot_vec = point - rect.position;
@@ -250,7 +262,7 @@ namespace math
         return point_in_rect(local_point, local_rect);
     }
 
-    bool line_circle(const line2d& line, const circle& circle)
+    inline bool line_circle(const line2d& line, const circle& circle)
     {
         vec2 ab = line.end - line.start;
         float t = dot(circle.position - line.start, ab) / magnitudeSq(ab);
@@ -262,7 +274,7 @@ namespace math
         return line2d::lengthSq(circle_to_closest) < circle.radius * circle.radius;
     }
 
-    bool line_rect(const line2d& line, const rect2d& rect)
+    inline bool line_rect(const line2d& line, const rect2d& rect)
     {
         if(point_in_rect(line.start, rect) || point_in_rect(line.end, rect)) {
             return true;
@@ -284,7 +296,7 @@ namespace math
         return t > 0.0f && t * t < line2d::lengthSq(line);
     }
 
-    bool line_orrect(const line2d& line, const orrect2d& orrect)
+    inline bool line_orrect(const line2d& line, const orrect2d& orrect)
     {
         float theta = -utils::deg2rad(orrect.rotation);
         mat2 z_rotation {cosf(theta), sinf(theta), -sinf(theta), cosf(theta)};
@@ -303,7 +315,7 @@ namespace math
         return line_rect(local_line, local_rect);
     };
 
-    bool overlap_on_axis(const math::rect2d& rect1, const math::rect2d& rect2,
+    inline bool overlap_on_axis(const math::rect2d& rect1, const math::rect2d& rect2,
                          const math::vec2& axis)
     {
         interval2d a = interval2d::get_interval(rect1, axis);
@@ -311,7 +323,7 @@ namespace math
         return ((b.min <= a.max) && (a.min <= b.max));
     }
 
-    bool overlap_on_axis(const math::rect2d& rect1, const math::orrect2d& rect2,
+    inline bool overlap_on_axis(const math::rect2d& rect1, const math::orrect2d& rect2,
                          const math::vec2& axis)
     {
         interval2d a = interval2d::get_interval(rect1, axis);
@@ -324,7 +336,7 @@ namespace math
      * @param points array of points
      * @return circle with central point position & difference between furthest point and center as a radius
      */
-    circle containing_circle(const point2d* const points)
+    inline circle containing_circle(const point2d* const points)
     {
         constexpr size_t points_count = sizeof(points) / sizeof(points[0]);
         point2d center;
@@ -350,7 +362,7 @@ namespace math
      * @param points
      * @return
      */
-    rect2d containing_rectangle(const point2d* const points)
+    inline rect2d containing_rectangle(const point2d* const points)
     {
         constexpr size_t points_count = sizeof(points) / sizeof(points[0]);
         vec2 min = points[0];
@@ -376,7 +388,7 @@ namespace math
      * @param point point
      * @return true if point is inside the shape
      */
-    bool point_in_shape(const bounding_shape& shape, const point2d& point)
+    inline bool point_in_shape(const bounding_shape& shape, const point2d& point)
     {
         constexpr size_t num_circles = sizeof(shape.circles) / sizeof(shape.circles[0]);
         for(size_t i = 0; i < num_circles; ++i) {
@@ -129,10 +129,10 @@ namespace math {
             result.n[2][2] = n[2][0] * o.n[0][2] + n[2][1] * o.n[1][2] + n[2][2] * o.n[2][2] + n[2][3] * o.n[3][2];
             result.n[2][3] = n[2][0] * o.n[0][3] + n[2][1] * o.n[1][3] + n[2][2] * o.n[2][3] + n[2][3] * o.n[3][3];
 
-            result.n[3][0] = n[3][0] * o.n[0][0] + n[3][1] * o.n[1][0] + n[3][3] * o.n[2][0] + n[3][3] * o.n[3][0];
-            result.n[3][1] = n[3][0] * o.n[0][1] + n[3][1] * o.n[1][1] + n[3][3] * o.n[2][1] + n[3][3] * o.n[3][1];
-            result.n[3][2] = n[3][0] * o.n[0][2] + n[3][1] * o.n[1][2] + n[3][3] * o.n[2][2] + n[3][3] * o.n[3][2];
-            result.n[3][3] = n[3][0] * o.n[0][3] + n[3][1] * o.n[1][3] + n[3][3] * o.n[2][3] + n[3][3] * o.n[3][3];
+            result.n[3][0] = n[3][0] * o.n[0][0] + n[3][1] * o.n[1][0] + n[3][2] * o.n[2][0] + n[3][3] * o.n[3][0];
+            result.n[3][1] = n[3][0] * o.n[0][1] + n[3][1] * o.n[1][1] + n[3][2] * o.n[2][1] + n[3][3] * o.n[3][1];
+            result.n[3][2] = n[3][0] * o.n[0][2] + n[3][1] * o.n[1][2] + n[3][2] * o.n[2][2] + n[3][3] * o.n[3][2];
+            result.n[3][3] = n[3][0] * o.n[0][3] + n[3][1] * o.n[1][3] + n[3][2] * o.n[2][3] + n[3][3] * o.n[3][3];
             return result;
         }
 
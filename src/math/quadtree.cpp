@@ -9,46 +9,50 @@ namespace math
 {
     size_t QuadTreeNode::max_depth = 5;
     size_t QuadTreeNode::max_objects_per_node = 15;
+    uint64_t QuadTreeNode::last_stamp = 0;
 
     bool QuadTreeNode::is_leaf()
     {
         return childrens.size() == 0;
     }
 
-    size_t QuadTreeNode::size()
+    namespace
     {
-        reset();
-        size_t object_count = content.size();
-
-        for(size_t i = 0; i < object_count; ++i) {
-            content[i]->flag = true;
+        /**
+         * @return true the first time data is reached by the traversal with stamp
+         */
+        bool first_visit(QuadTreeData& data, uint64_t stamp)
+        {
+            if(data.visit_stamp == stamp)
+                return false;
+            data.visit_stamp = stamp;
+            return true;
         }
+    }
+
+    size_t QuadTreeNode::size()
+    {
+        const uint64_t stamp = ++last_stamp;
+        size_t object_count = 0;
 
         std::vector<QuadTreeNode*> process;
         // Adds current node to the vector with each node
         process.emplace_back(this);
 
         // For each node in 'process' vector
-        while(process.size() > 0) {
+        while(!process.empty()) {
             QuadTreeNode* processing = process.back();
-            // If current node, that we are checking, is 'leaf'
-            if(!processing->is_leaf()) {
-                for(auto& children : processing->childrens) {
-                    // push each children of 'leaf' node to 'process' vector
-                    process.emplace_back(&children);
-                }
-            } else {
-                // If not, increment 'object_count' for each node's 'content'
-                for(auto& c : processing->content) {
-                    if(!c->flag) {
-                        c->flag = true;
-                        object_count++;
-                    }
-                }
+            process.pop_back();
+            for(auto& children : processing->childrens) {
+                // push each children of 'leaf' node to 'process' vector
+                process.emplace_back(&children);
+            }
+            // Objects spanning several leaves are counted once
+            for(auto& c : processing->content) {
+                if(first_visit(*c, stamp))
+                    object_count++;
             }
-            process.erase(process.begin());
         }
-        reset();
         return object_count;
     }
 
@@ -76,7 +80,7 @@ namespace math
                 }
             }
             if(remove_index != -1)
-                content.erase(content.begin() + 1);
+                content.erase(content.begin() + remove_index);
         } else {
             for(auto& child : childrens)
                 child.remove(data);
@@ -97,19 +101,22 @@ namespace math
             if(num_objs == 0)
                 childrens.clear();
             else if(num_objs < max_objects_per_node) {
+                const uint64_t stamp = ++last_stamp;
                 std::vector<QuadTreeNode*> process;
                 process.emplace_back(this);
-                while(process.size() > 0) {
+                while(!process.empty()) {
                     QuadTreeNode* processing = process.back();
+                    process.pop_back();
                     if(!processing->is_leaf()) {
-                        for(size_t i = 0; i < childrens.size(); ++i) {
-                            process.emplace_back(&processing->childrens[i]);
+                        for(auto& children : processing->childrens) {
+                            process.emplace_back(&children);
                         }
                     } else {
-                        content.insert(content.end(), processing->content.begin(),
-                                       processing->content.end());
+                        for(auto& c : processing->content) {
+                            if(first_visit(*c, stamp))
+                                content.push_back(c);
+                        }
                     }
-                    process.erase(process.begin());
                 }
                 childrens.clear();
             }
@@ -139,43 +146,40 @@ namespace math
         childrens.emplace_back(QuadTreeNode(child_areas[3]));
         childrens[3].current_depth =  current_depth + 1;
 
-        for(size_t i = 0; i < content.size(); ++i) {
-            childrens[i].insert(*content[i]);
+        for(auto& c : content) {
+            for(auto& children : childrens)
+                children.insert(*c);
         }
 
         content.clear();
     };
 
-    void QuadTreeNode::reset()
+    std::vector<QuadTreeData*> QuadTreeNode::query(const rect2d& area)
     {
-        if(is_leaf()) {
-            for(auto& c : content)
-                c->flag = false;
-        } else {
-            for(auto& c : childrens)
-                c.reset();
-        }
+        std::vector<QuadTreeData*> result;
+        query(area, result, ++last_stamp);
+        return result;
     }
 
-    std::vector<QuadTreeData*> QuadTreeNode::query(const rect2d& area)
+    void QuadTreeNode::query(const rect2d& area, std::vector<QuadTreeData*>& result)
+    {
+        query(area, result, ++last_stamp);
+    }
+
+    void QuadTreeNode::query(const rect2d& area, std::vector<QuadTreeData*>& result,
+                             uint64_t stamp)
     {
         if(!physics::collision2d::rectangle_rectangle(area, node_bounds))
-            return {};
+            return;
 
-        std::vector<QuadTreeData*> result;
-        if(is_leaf())
-        {
+        if(is_leaf()) {
             for(auto& c : content)
-                if(physics::collision2d::rectangle_rectangle(c->bounds, area))
+                if(physics::collision2d::rectangle_rectangle(c->bounds, area)
+                   && first_visit(*c, stamp))
                     result.emplace_back(c);
         } else {
-            for(auto& c : childrens) {
-                auto recurse = c.query(area);
-                if(!recurse.empty()) {
-                    result.insert(result.end(), recurse.begin(), recurse.end());
-                }
-            }
+            for(auto& c : childrens)
+                c.query(area, result, stamp);
         }
-        return  result;
     }
 }
@@ -5,6 +5,7 @@
 #ifndef SCARECROW2D_QUADTREE_H
 #define SCARECROW2D_QUADTREE_H
 #include "geometry2d.h"
+#include <cstdint>
 #include <vector>
 
 namespace math
@@ -14,12 +15,12 @@ namespace math
     {
         void* object;
         rect2d bounds;
-        bool flag;
+        // Last traversal that reached the object, objects spanning several nodes are seen once
+        uint64_t visit_stamp = 0;
 
         QuadTreeData(void* obj, const rect2d& rect)
             : object(obj)
             , bounds(rect)
-            , flag(false)
         {}
     };
 
@@ -37,16 +38,28 @@ namespace math
         void update(QuadTreeData& data);
         void snake();
         void split();
-        void reset();
+        /**
+         * Objects intersecting area, each one once
+         */
         std::vector<QuadTreeData*> query(const rect2d& area);
 
+        /**
+         * Appends objects intersecting area to result, which can be reused between queries
+         */
+        void query(const rect2d& area, std::vector<QuadTreeData*>& result);
+
     private:
+        void query(const rect2d& area, std::vector<QuadTreeData*>& result, uint64_t stamp);
+
         std::vector<QuadTreeNode> childrens;
         std::vector<QuadTreeData*> content;
         rect2d node_bounds;
         size_t current_depth;
         static size_t max_depth;
         static size_t max_objects_per_node;
+        // Stamp of the last traversal, shared by all trees so stamps never repeat.
+        // Traversals are not thread safe
+        static uint64_t last_stamp;
     };
 };
 #endif //SCARECROW2D_QUADTREE_H
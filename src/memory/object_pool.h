@@ -0,0 +1,261 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_OBJECT_POOL_H
+#define SCARECROW2D_OBJECT_POOL_H
+
+#include "core/dbg/dbg_asserts.h"
+#include "core/types.h"
+#include "pool_allocator.h"
+#include "pool_handle.h"
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sc2d::memory
+{
+
+    /**
+     * Typed pool that constructs and destroys T in place, inside pool_allocator blocks.
+     * Objects are addressed with pool_handle: handle -> slot -> block, both O(1).
+     * Objects move only when the pool grows or on defragment(), handles stay valid in both cases.
+     * @tparam T object type
+     */
+    template <typename T>
+    class object_pool
+    {
+    public:
+        explicit object_pool(size_t capacity = 16);
+        ~object_pool();
+        object_pool(const object_pool&) = delete;
+        object_pool& operator=(const object_pool&) = delete;
+
+        template <typename... Args>
+        pool_handle create(Args&&... args);
+        void destroy(pool_handle handle);
+        void clear();
+
+        T* get(pool_handle handle);
+        const T* get(pool_handle handle) const;
+        bool is_alive(pool_handle handle) const;
+
+        size_t size() const
+        {
+            return pool->get_intialized_num();
+        }
+
+        size_t capacity() const
+        {
+            return pool->get_num_of_blocks();
+        }
+
+        /**
+         * Calls fn(pool_handle, T&) for every live object, in memory order.
+         */
+        template <typename Fn>
+        void for_each(Fn&& fn);
+
+        /**
+         * Moves live objects into the first size() blocks, so iteration becomes
+         * one contiguous range.
+         * @return number of moved objects
+         */
+        size_t defragment();
+
+    private:
+        static constexpr u32 FREE = 0xffffffff;
+        // Block must fit pool_allocator's free-list link
+        static constexpr size_t BLOCK_ALIGNMENT =
+            alignof(T) > alignof(size_t) ? alignof(T) : alignof(size_t);
+        static constexpr size_t BLOCK_SIZE =
+            ((sizeof(T) > sizeof(size_t) ? sizeof(T) : sizeof(size_t)) + BLOCK_ALIGNMENT - 1)
+            & ~(BLOCK_ALIGNMENT - 1);
+
+        struct slot
+        {
+            u32 block;
+            u32 generation;
+        };
+
+        forceinline T* block_ptr(u32 block) const
+        {
+            return (T*)(pool->get_start() + block * BLOCK_SIZE);
+        }
+
+        void grow();
+        void move_block(u32 from, u32 to);
+
+        pool_allocator* pool;
+        // handle index -> block and generation
+        std::vector<slot> slots;
+        // block -> handle index, FREE for unused blocks
+        std::vector<u32> block_owners;
+        std::vector<u32> free_slots;
+    };
+
+    template <typename T>
+    object_pool<T>::object_pool(size_t capacity)
+        : pool(new pool_allocator)
+    {
+        pool->create(BLOCK_SIZE, capacity ? capacity : 1, BLOCK_ALIGNMENT);
+        block_owners.resize(pool->get_num_of_blocks(), FREE);
+    }
+
+    template <typename T>
+    object_pool<T>::~object_pool()
+    {
+        clear();
+        delete pool;
+    }
+
+    template <typename T>
+    template <typename... Args>
+    pool_handle object_pool<T>::create(Args&&... args)
+    {
+        if constexpr(!std::is_trivially_copyable<T>::value) {
+            // pool_allocator grows with memcpy, non-trivial objects are moved manually
+            if(pool->get_intialized_num() == pool->get_num_of_blocks())
+                grow();
+        }
+
+        const alloc_result res = pool->allocate();
+        if(res.resized == is_resized::YES)
+            block_owners.resize(pool->get_num_of_blocks(), FREE);
+
+        const u32 block = (u32)((res.ptr - pool->get_start()) / BLOCK_SIZE);
+        new(block_ptr(block)) T(std::forward<Args>(args)...);
+
+        u32 index;
+        if(!free_slots.empty()) {
+            index = free_slots.back();
+            free_slots.pop_back();
+        } else {
+            index = (u32)slots.size();
+            DBG_FAIL_IF(index > pool_handle::INDEX_MASK - 1, "object_pool handle index overflow")
+            slots.push_back({FREE, 0});
+        }
+
+        slots[index].block = block;
+        block_owners[block] = index;
+        return pool_handle(index, slots[index].generation);
+    }
+
+    template <typename T>
+    void object_pool<T>::destroy(pool_handle handle)
+    {
+        if(!is_alive(handle))
+            return;
+
+        slot& s = slots[handle.index()];
+        T* obj = block_ptr(s.block);
+        obj->~T();
+        pool->deallocate(obj);
+
+        block_owners[s.block] = FREE;
+        s.block = FREE;
+        s.generation = (s.generation + 1) & pool_handle::GENERATION_MASK;
+        free_slots.push_back(handle.index());
+    }
+
+    template <typename T>
+    void object_pool<T>::clear()
+    {
+        for(u32 i = 0; i < slots.size(); ++i) {
+            if(slots[i].block != FREE)
+                destroy(pool_handle(i, slots[i].generation));
+        }
+    }
+
+    template <typename T>
+    forceinline T* object_pool<T>::get(pool_handle handle)
+    {
+        return is_alive(handle) ? block_ptr(slots[handle.index()].block) : nullptr;
+    }
+
+    template <typename T>
+    forceinline const T* object_pool<T>::get(pool_handle handle) const
+    {
+        return is_alive(handle) ? block_ptr(slots[handle.index()].block) : nullptr;
+    }
+
+    template <typename T>
+    forceinline bool object_pool<T>::is_alive(pool_handle handle) const
+    {
+        const u32 index = handle.index();
+        return index < slots.size() && slots[index].block != FREE
+               && slots[index].generation == handle.generation();
+    }
+
+    template <typename T>
+    template <typename Fn>
+    void object_pool<T>::for_each(Fn&& fn)
+    {
+        size_t left = size();
+        for(u32 block = 0; left > 0; ++block) {
+            const u32 owner = block_owners[block];
+            if(owner != FREE) {
+                fn(pool_handle(owner, slots[owner].generation), *block_ptr(block));
+                --left;
+            }
+        }
+    }
+
+    template <typename T>
+    size_t object_pool<T>::defragment()
+    {
+        const size_t count = size();
+        size_t moved = 0;
+        u32 hole = 0;
+        u32 last = (u32)block_owners.size();
+
+        while(true) {
+            while(hole < count && block_owners[hole] != FREE)
+                ++hole;
+            if(hole >= count)
+                break;
+            while(block_owners[--last] == FREE) { }
+            move_block(last, hole);
+            ++moved;
+        }
+
+        pool->reset(count);
+        return moved;
+    }
+
+    template <typename T>
+    void object_pool<T>::move_block(u32 from, u32 to)
+    {
+        T* src = block_ptr(from);
+        new(block_ptr(to)) T(std::move(*src));
+        src->~T();
+
+        const u32 owner = block_owners[from];
+        slots[owner].block = to;
+        block_owners[to] = owner;
+        block_owners[from] = FREE;
+    }
+
+    template <typename T>
+    void object_pool<T>::grow()
+    {
+        const size_t count = pool->get_num_of_blocks();
+        auto* grown = new pool_allocator;
+        grown->create(BLOCK_SIZE, count << 1u, BLOCK_ALIGNMENT);
+
+        // Pool is full, so every block is alive
+        for(size_t i = 0; i < count; ++i) {
+            T* src = block_ptr(i);
+            new(grown->get_start() + i * BLOCK_SIZE) T(std::move(*src));
+            src->~T();
+        }
+        grown->reset(count);
+
+        delete pool;
+        pool = grown;
+        block_owners.resize(pool->get_num_of_blocks(), FREE);
+    }
+}
+
+#endif //SCARECROW2D_OBJECT_POOL_H
@@ -4,6 +4,7 @@
 
 #include "pool_allocator.h"
 #include "memory.h"
+#include <cstddef>
 #include <cstring>
 
 //Pool allocator reference: http://www.thinkmind.org/download.php?articleid=computation_tools_2012_1_10_80006
@@ -16,6 +17,8 @@ namespace sc2d::memory
         size_of_block = block_size;
         num_of_blocks = blocks_numb;
         this->alignment = alignment;
+        num_of_initialized = 0;
+        num_of_touched = 0;
         p_start = reinterpret_cast<unsigned char*>(
             malloc_aligned(block_size * blocks_numb, this->alignment));
         p_next = p_start;
@@ -32,19 +35,28 @@ namespace sc2d::memory
         alloc_result result;
 
         if(num_of_initialized < num_of_blocks) {
-            size_t* ptr = (size_t*)addr_from_index(num_of_initialized);
-            *ptr = num_of_initialized + 1;
+            // Blocks are linked lazily, one per allocation. The high-water mark is tracked
+            // separately from the number of used blocks, otherwise a block that is still in use
+            // gets overwritten after out-of-order deallocations.
+            if(num_of_touched < num_of_blocks) {
+                size_t* ptr = (size_t*)addr_from_index(num_of_touched);
+                *ptr = num_of_touched + 1;
+                ++num_of_touched;
+            }
             ++num_of_initialized;
 
             result.ptr = p_next;
             if(num_of_blocks - num_of_initialized > 0) {
                 p_next = addr_from_index(*(size_t*)p_next);
+            } else {
+                p_next = nullptr;
             }
         } else {
             resize(num_of_blocks << 1u);
             result.resized = is_resized::YES;
             result.ptr = addr_from_index(num_of_initialized);
             ++num_of_initialized;
+            num_of_touched = num_of_initialized;
             p_next = addr_from_index(num_of_initialized);
         }
 
@@ -54,8 +66,13 @@ namespace sc2d::memory
     void pool_allocator::resize(size_t new_size)
     {
 #if COMPILER_GCC || COMPILER_CLANG
-        if(void* p_new_start = malloc_aligned(size_of_block * new_size, alignment)) {
-            if(!(memcpy(p_new_start, p_start, size_of_block * num_of_blocks))) {
+        // realloc can grow in place, but guarantees only fundamental alignment
+        if(alignment <= alignof(std::max_align_t)) {
+            if(void* p_new_start = realloc(p_start, size_of_block * new_size))
+                p_start = reinterpret_cast<unsigned char*>(p_new_start);
+        } else if(void* p_new_start = malloc_aligned(size_of_block * new_size, alignment)) {
+            const size_t copy_blocks = new_size < num_of_blocks ? new_size : num_of_blocks;
+            if(!(memcpy(p_new_start, p_start, size_of_block * copy_blocks))) {
                 // TODO: throw error;
             }
             free_aligned(p_start);
@@ -83,6 +100,13 @@ namespace sc2d::memory
         --num_of_initialized;
     }
 
+    void pool_allocator::reset(size_t num_of_used)
+    {
+        num_of_initialized = num_of_used;
+        num_of_touched = num_of_used;
+        p_next = num_of_used < num_of_blocks ? addr_from_index(num_of_used) : nullptr;
+    }
+
     inline unsigned char* pool_allocator::addr_from_index(size_t index) const
     {
         return p_start + index * size_of_block;
@@ -46,6 +46,11 @@ namespace sc2d
             alloc_result allocate();
             void resize(size_t new_size);
             void deallocate(void* ptr);
+            /**
+             * Drops the free list, first 'num_of_used' blocks are treated as allocated
+             * and the rest as free. Used after blocks were compacted by the caller.
+             */
+            void reset(size_t num_of_used);
 
             unsigned char* get_start() const
             {
@@ -67,6 +72,8 @@ namespace sc2d
             size_t num_of_blocks = 0;
             size_t size_of_block = 0;
             size_t num_of_initialized = 0;
+            // Blocks whose free-list link was already written (lazy initialization)
+            size_t num_of_touched = 0;
             size_t alignment = 0;
             unsigned char* p_start;
             unsigned char* p_next;
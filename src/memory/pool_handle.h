@@ -0,0 +1,60 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_POOL_HANDLE_H
+#define SCARECROW2D_POOL_HANDLE_H
+
+#include "core/types.h"
+
+namespace sc2d::memory
+{
+
+    /**
+     * Compact reference to an object in object_pool or sparse_set.
+     * Lower INDEX_BITS are the slot index, upper GENERATION_BITS are the slot generation,
+     * so a handle of a destroyed object never resolves to an object created later in its slot.
+     */
+    struct pool_handle
+    {
+        static constexpr u32 INDEX_BITS = 20;
+        static constexpr u32 GENERATION_BITS = 32 - INDEX_BITS;
+        static constexpr u32 INDEX_MASK = (1u << INDEX_BITS) - 1;
+        static constexpr u32 GENERATION_MASK = (1u << GENERATION_BITS) - 1;
+        static constexpr u32 INVALID = 0xffffffff;
+
+        u32 id = INVALID;
+
+        constexpr pool_handle() = default;
+        constexpr pool_handle(u32 index, u32 generation)
+            : id((generation & GENERATION_MASK) << INDEX_BITS | (index & INDEX_MASK))
+        { }
+
+        constexpr u32 index() const
+        {
+            return id & INDEX_MASK;
+        }
+
+        constexpr u32 generation() const
+        {
+            return id >> INDEX_BITS;
+        }
+
+        constexpr bool is_valid() const
+        {
+            return id != INVALID;
+        }
+
+        constexpr bool operator==(const pool_handle& other) const
+        {
+            return id == other.id;
+        }
+
+        constexpr bool operator!=(const pool_handle& other) const
+        {
+            return id != other.id;
+        }
+    };
+}
+
+#endif //SCARECROW2D_POOL_HANDLE_H
@@ -0,0 +1,28 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_RELOCATABLE_H
+#define SCARECROW2D_RELOCATABLE_H
+
+#include <type_traits>
+
+namespace sc2d::memory
+{
+
+    /**
+     * Types that can be moved to another address with memcpy / memmove / realloc,
+     * without calling move constructor and destructor.
+     * Defaults to trivially copyable types. Specialize it for types which don't point
+     * into themselves, e.g. containers that own a heap buffer:
+     *     template <> struct is_trivially_relocatable<my_type> : std::true_type {};
+     */
+    template <typename T>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T>
+    { };
+
+    template <typename T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+}
+
+#endif //SCARECROW2D_RELOCATABLE_H
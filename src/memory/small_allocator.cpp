@@ -0,0 +1,347 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "small_allocator.h"
+#include "core/types.h"
+#include "pool_allocator.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+namespace sc2d::memory
+{
+    namespace
+    {
+        using sa = small_allocator;
+
+        // Must be a power of two and bigger than the max number of slabs
+        constexpr size_t REGISTRY_SIZE = 16384;
+        static_assert(REGISTRY_SIZE >= 2 * sa::NUM_OF_CLASSES * sa::MAX_SLABS_PER_CLASS);
+        static_assert(sa::class_block_size(sa::NUM_OF_CLASSES - 1) == sa::MAX_BLOCK_SIZE);
+
+        struct free_block
+        {
+            free_block* next;
+        };
+
+        /**
+         * All slabs of one size class. Slabs are appended only, 'partial' is a hint
+         * to the first slab that may still have free blocks.
+         */
+        struct size_class_pool
+        {
+            std::mutex lock;
+            pool_allocator* slabs[sa::MAX_SLABS_PER_CLASS] {};
+            size_t num_of_slabs = 0;
+            size_t partial = 0;
+        };
+
+        /**
+         * Maps slab start address to its size class and slab.
+         * Entries are only inserted, so lookups need no locks.
+         */
+        struct registry_entry
+        {
+            std::atomic<uintptr_t> slab_start;
+            pool_allocator* slab;
+            u32 cls;
+            u32 index;
+        };
+
+        struct thread_cache
+        {
+            free_block* heads[sa::NUM_OF_CLASSES];
+            u32 counts[sa::NUM_OF_CLASSES];
+            bool registered;
+            bool dead;
+        };
+
+        // Thread cache must be trivially destructible, guard flushes it on thread exit.
+        struct thread_cache_guard
+        {
+            ~thread_cache_guard();
+        };
+
+        size_class_pool pools[sa::NUM_OF_CLASSES];
+        registry_entry registry[REGISTRY_SIZE];
+        thread_local thread_cache tcache;
+        thread_local thread_cache_guard tcache_guard;
+
+        forceinline size_t registry_hash(uintptr_t slab_start)
+        {
+            return (size_t)(((u64)slab_start * 0x9E3779B97F4A7C15ull) >> 32u) & (REGISTRY_SIZE - 1);
+        }
+
+        forceinline uintptr_t slab_start_of(const void* ptr)
+        {
+            return (uintptr_t)ptr & ~(uintptr_t)(sa::SLAB_SIZE - 1);
+        }
+
+        void registry_insert(uintptr_t slab_start, pool_allocator* slab, u32 cls, u32 index)
+        {
+            for(size_t i = registry_hash(slab_start);; i = (i + 1) & (REGISTRY_SIZE - 1)) {
+                uintptr_t expected = 0;
+                registry_entry& entry = registry[i];
+                if(entry.slab_start.load(std::memory_order_relaxed) != 0)
+                    continue;
+                // Slot is claimed with a temporary value, then published with the real key
+                if(entry.slab_start.compare_exchange_strong(expected, 1, std::memory_order_acquire)) {
+                    entry.slab = slab;
+                    entry.cls = cls;
+                    entry.index = index;
+                    entry.slab_start.store(slab_start, std::memory_order_release);
+                    return;
+                }
+            }
+        }
+
+        const registry_entry* registry_find(const void* ptr)
+        {
+            const uintptr_t slab_start = slab_start_of(ptr);
+            for(size_t i = registry_hash(slab_start);; i = (i + 1) & (REGISTRY_SIZE - 1)) {
+                const uintptr_t key = registry[i].slab_start.load(std::memory_order_acquire);
+                if(key == slab_start)
+                    return &registry[i];
+                if(key == 0)
+                    return nullptr;
+            }
+        }
+
+        forceinline u32 batch_size(size_t cls)
+        {
+            const size_t batch = 4096 / sa::class_block_size(cls);
+            return batch < 8 ? 8 : (batch > 64 ? 64 : (u32)batch);
+        }
+
+        pool_allocator* make_slab(size_t cls)
+        {
+            size_class_pool& pool = pools[cls];
+            if(pool.num_of_slabs == sa::MAX_SLABS_PER_CLASS)
+                return nullptr;
+
+            // Not using operator new here, it can be replaced by this allocator
+            void* mem = malloc(sizeof(pool_allocator));
+            if(!mem)
+                return nullptr;
+
+            const size_t block_size = sa::class_block_size(cls);
+            auto* slab = new(mem) pool_allocator;
+            slab->create(block_size, sa::SLAB_SIZE / block_size, sa::SLAB_SIZE);
+            if(!slab->get_start()) {
+                free(mem);
+                return nullptr;
+            }
+
+            registry_insert((uintptr_t)slab->get_start(), slab, (u32)cls, (u32)pool.num_of_slabs);
+            pool.slabs[pool.num_of_slabs++] = slab;
+            return slab;
+        }
+
+        /**
+         * Takes up to 'count' blocks from the slabs of size class
+         * @return number of blocks linked into 'head'
+         */
+        u32 central_allocate(size_t cls, free_block*& head, u32 count)
+        {
+            size_class_pool& pool = pools[cls];
+            std::lock_guard<std::mutex> lock(pool.lock);
+
+            u32 taken = 0;
+            while(taken < count) {
+                while(pool.partial < pool.num_of_slabs
+                      && pool.slabs[pool.partial]->get_intialized_num()
+                             == pool.slabs[pool.partial]->get_num_of_blocks())
+                    ++pool.partial;
+
+                if(pool.partial == pool.num_of_slabs && !make_slab(cls))
+                    break;
+
+                // Slab is never full here, so it will not resize and move its blocks
+                auto* block = (free_block*)pool.slabs[pool.partial]->allocate().ptr;
+                block->next = head;
+                head = block;
+                ++taken;
+            }
+            return taken;
+        }
+
+        void central_deallocate(size_t cls, free_block* head)
+        {
+            size_class_pool& pool = pools[cls];
+            std::lock_guard<std::mutex> lock(pool.lock);
+
+            while(head) {
+                free_block* next = head->next;
+                const registry_entry* entry = registry_find(head);
+                entry->slab->deallocate(head);
+                if(entry->index < pool.partial)
+                    pool.partial = entry->index;
+                head = next;
+            }
+        }
+
+        thread_cache_guard::~thread_cache_guard()
+        {
+            small_allocator::flush_thread_cache();
+            tcache.dead = true;
+        }
+
+        /**
+         * First cached block of a thread, from allocate or deallocate, must register the guard
+         */
+        forceinline void register_thread_cache()
+        {
+            if(!tcache.registered) {
+                // Touching the guard registers its destructor for the current thread
+                static_cast<void>(&tcache_guard);
+                tcache.registered = true;
+            }
+        }
+    }
+
+    void* small_allocator::allocate(size_t size)
+    {
+        if(size > MAX_BLOCK_SIZE)
+            return malloc(size);
+
+        const size_t cls = size_class(size);
+
+        if(tcache.dead) {
+            free_block* block = nullptr;
+            return central_allocate(cls, block, 1) ? block : malloc(size);
+        }
+
+        if(!tcache.heads[cls]) {
+            register_thread_cache();
+            tcache.counts[cls] += central_allocate(cls, tcache.heads[cls], batch_size(cls));
+            // All slabs of this size class are in use
+            if(!tcache.heads[cls])
+                return malloc(size);
+        }
+
+        free_block* block = tcache.heads[cls];
+        tcache.heads[cls] = block->next;
+        --tcache.counts[cls];
+        return block;
+    }
+
+    void small_allocator::deallocate(void* ptr)
+    {
+        if(!ptr)
+            return;
+
+        const registry_entry* entry = registry_find(ptr);
+        if(!entry) {
+            free(ptr);
+            return;
+        }
+
+        auto* block = (free_block*)ptr;
+        const size_t cls = entry->cls;
+
+        if(tcache.dead) {
+            block->next = nullptr;
+            central_deallocate(cls, block);
+            return;
+        }
+
+        register_thread_cache();
+        block->next = tcache.heads[cls];
+        tcache.heads[cls] = block;
+
+        // Cache grew too much, returning one batch back to the slabs
+        const u32 batch = batch_size(cls);
+        if(++tcache.counts[cls] > batch * 2) {
+            free_block* tail = tcache.heads[cls];
+            for(u32 i = 1; i < batch; ++i)
+                tail = tail->next;
+            free_block* released = tcache.heads[cls];
+            tcache.heads[cls] = tail->next;
+            tail->next = nullptr;
+            tcache.counts[cls] -= batch;
+            central_deallocate(cls, released);
+        }
+    }
+
+    void small_allocator::flush_thread_cache()
+    {
+        for(size_t cls = 0; cls < NUM_OF_CLASSES; ++cls) {
+            if(tcache.heads[cls]) {
+                central_deallocate(cls, tcache.heads[cls]);
+                tcache.heads[cls] = nullptr;
+                tcache.counts[cls] = 0;
+            }
+        }
+    }
+
+    bool small_allocator::owns(const void* ptr)
+    {
+        return ptr && registry_find(ptr);
+    }
+}
+
+#ifdef SC2D_SMALL_OBJECT_NEW
+
+// Global operator new / delete replacement.
+// Aligned (std::align_val_t) versions are left to the standard library.
+
+void* operator new(std::size_t size)
+{
+    void* ptr = sc2d::memory::small_allocator::allocate(size);
+    if(!ptr)
+        abort();
+    return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+    void* ptr = sc2d::memory::small_allocator::allocate(size);
+    if(!ptr)
+        abort();
+    return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return sc2d::memory::small_allocator::allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return sc2d::memory::small_allocator::allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    sc2d::memory::small_allocator::deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    sc2d::memory::small_allocator::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    sc2d::memory::small_allocator::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    sc2d::memory::small_allocator::deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    sc2d::memory::small_allocator::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    sc2d::memory::small_allocator::deallocate(ptr);
+}
+
+#endif
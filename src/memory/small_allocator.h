@@ -0,0 +1,60 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#ifndef SCARECROW2D_SMALL_ALLOCATOR_H
+#define SCARECROW2D_SMALL_ALLOCATOR_H
+
+#include "core/compiler.h"
+#include <cstddef>
+
+namespace sc2d::memory
+{
+
+    /**
+     * Small-object allocator.
+     * Requests up to MAX_BLOCK_SIZE bytes are rounded up to a power-of-two size class
+     * and served from fixed-size slabs, where every slab is a pool_allocator that never resizes.
+     * Each thread keeps a short free list per size class, so the common allocate / deallocate
+     * path takes no locks. Bigger requests go straight to malloc.
+     * Slabs are never returned to the OS, memory is reused by the same size class only.
+     */
+    class small_allocator
+    {
+    public:
+        static constexpr size_t MIN_BLOCK_SIZE = 8;
+        static constexpr size_t MAX_BLOCK_SIZE = 512;
+        static constexpr size_t NUM_OF_CLASSES = 7; // 8, 16, 32, 64, 128, 256, 512
+        static constexpr size_t SLAB_SIZE = 64 * 1024;
+        static constexpr size_t MAX_SLABS_PER_CLASS = 1024;
+
+        static void* allocate(size_t size);
+        static void deallocate(void* ptr);
+
+        /**
+         * Returns cached blocks of the calling thread to the shared size classes.
+         * Called automatically when a thread exits.
+         */
+        static void flush_thread_cache();
+
+        /**
+         * @return true if ptr points into one of the slabs
+         */
+        static bool owns(const void* ptr);
+
+        forceinline static size_t size_class(size_t size)
+        {
+            size_t cls = 0;
+            for(size_t block = MIN_BLOCK_SIZE; block < size; block <<= 1u)
+                ++cls;
+            return cls;
+        }
+
+        forceinline static constexpr size_t class_block_size(size_t cls)
+        {
+            return MIN_BLOCK_SIZE << cls;
+        }
+    };
+}
+
+#endif //SCARECROW2D_SMALL_ALLOCATOR_H
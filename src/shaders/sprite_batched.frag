@@ -3,14 +3,39 @@ R"(
 
 in vec2 TexCoords;
 in vec4 TexColor;
-flat in uint TileIndex;
+flat in uint TexIndex;
 
 layout(location = 0) out vec4 color;
 
-uniform sampler2D img;
+// Size must match limits::BATCH_TEXTURES
+uniform sampler2D imgs[16];
+
+// GLSL 3.30 indexes sampler arrays only with constant expressions
+vec4 sample_img(uint index, vec2 uv)
+{
+    switch(index) {
+        case 0u: return texture(imgs[0], uv);
+        case 1u: return texture(imgs[1], uv);
+        case 2u: return texture(imgs[2], uv);
+        case 3u: return texture(imgs[3], uv);
+        case 4u: return texture(imgs[4], uv);
+        case 5u: return texture(imgs[5], uv);
+        case 6u: return texture(imgs[6], uv);
+        case 7u: return texture(imgs[7], uv);
+        case 8u: return texture(imgs[8], uv);
+        case 9u: return texture(imgs[9], uv);
+        case 10u: return texture(imgs[10], uv);
+        case 11u: return texture(imgs[11], uv);
+        case 12u: return texture(imgs[12], uv);
+        case 13u: return texture(imgs[13], uv);
+        case 14u: return texture(imgs[14], uv);
+        case 15u: return texture(imgs[15], uv);
+    }
+    return vec4(1.0);
+}
 
 void main()
 {
-    color = TexColor * texture(img, TexCoords);
+    color = TexColor * sample_img(TexIndex, TexCoords);
 }
 )"
@@ -1,22 +1,30 @@
 R"(
 #version 330 core
-//layout (location = 3) in uint l_tileid;
+// SpriteBatch feeds either float or normalized u16 uv / u8 color attributes, GL converts both
 layout (location = 0) in vec2 l_pos;
 layout (location = 1) in vec2 l_uv;
 layout (location = 2) in vec4 l_color;
+layout (location = 3) in uint l_tex_index;
 
 out vec2 TexCoords;
 out vec4 TexColor;
-//flat out uint TileIndex;
+flat out uint TexIndex;
 
-uniform mat4 proj;
+layout (std140) uniform Camera
+{
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    float time;
+    float delta_time;
+};
 
 
 void main()
 {
     TexCoords = l_uv;
     TexColor = l_color;
-//    TileIndex = l_tileid;
-    gl_Position = proj * vec4(l_pos, 0.0, 1.0);
+    TexIndex = l_tex_index;
+    gl_Position = view_projection * vec4(l_pos, 0.0, 1.0);
 }
 )"
@@ -2,14 +2,26 @@ R"(
 #version 330 core
 layout (location = 0) in vec2 l_pos;
 layout (location = 1) in vec2 l_uv;
+// Per instance when RenderQueue merges sprites, constant values for a single Sprite::draw
+layout (location = 2) in mat4 l_model;
+layout (location = 6) in vec3 l_color;
 
 out vec2 TexCoords;
+out vec3 TexColor;
 
-uniform mat4 mvp;
+layout (std140) uniform Camera
+{
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    float time;
+    float delta_time;
+};
 
 void main()
 {
     TexCoords = l_uv;
-    gl_Position = mvp * vec4(l_pos, 0.0, 1.0);
+    TexColor = l_color;
+    gl_Position = view_projection * l_model * vec4(l_pos, 0.0, 1.0);
 }
 )"
@@ -0,0 +1,39 @@
+R"(
+#version 330 core
+// One sprite_instance per instance, corners are built from gl_VertexID
+layout (location = 0) in vec4 l_rect; // pos.xy, size.xy
+layout (location = 1) in float l_rotation;
+layout (location = 2) in vec2 l_origin;
+layout (location = 3) in vec4 l_uv; // min.xy, max.xy
+layout (location = 4) in vec4 l_color;
+layout (location = 5) in uint l_tex_index;
+
+out vec2 TexCoords;
+out vec4 TexColor;
+flat out uint TexIndex;
+
+layout (std140) uniform Camera
+{
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    float time;
+    float delta_time;
+};
+
+
+void main()
+{
+    // Strip (0, 0), (0, 1), (1, 0), (1, 1): counter-clockwise on screen with y pointing down
+    vec2 corner = vec2(gl_VertexID >> 1, gl_VertexID & 1);
+    vec2 local = (corner - l_origin) * l_rect.zw;
+    float s = sin(l_rotation);
+    float c = cos(l_rotation);
+    vec2 pos = l_rect.xy + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+
+    TexCoords = mix(l_uv.xy, l_uv.zw, corner);
+    TexColor = l_color;
+    TexIndex = l_tex_index;
+    gl_Position = view_projection * vec4(pos, 0.0, 1.0);
+}
+)"
@@ -7,12 +7,20 @@ layout (location = 3) in mat4 l_model;
 
 out vec2 TexCoords;
 flat out uint GlyphId;
-uniform mat4 projection;
+
+layout (std140) uniform Camera
+{
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    float time;
+    float delta_time;
+};
 
 void main()
 {
     TexCoords = l_uv;
     GlyphId = l_glyphid;
-    gl_Position = projection * l_model * vec4(l_pos, 0.0, 1.0);
+    gl_Position = view_projection * l_model * vec4(l_pos, 0.0, 1.0);
 }
 )"
@@ -0,0 +1,44 @@
+R"(
+#version 330 core
+// One chunk_tile per instance, gl_InstanceID is the cell of a 32x32 chunk, row by row
+layout (location = 0) in uint l_tile;
+
+out vec2 TexCoords;
+flat out uint TileIndex;
+
+layout (std140) uniform Camera
+{
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    float time;
+    float delta_time;
+};
+
+uniform vec2 chunk_origin;
+uniform vec2 tile_size;
+
+void main()
+{
+    // (0, 0), (0, 1), (1, 0), (1, 1) keeps the strip front facing under the y-down camera
+    vec2 corner = vec2(gl_VertexID >> 1, gl_VertexID & 1);
+    uint gid = l_tile & 0x1fffu;
+    // Empty cells collapse to a point and rasterize nothing
+    if(gid == 0u)
+        corner = vec2(0.0);
+
+    // Tiled applies the diagonal flip first, so it is the last one undone here
+    vec2 uv = corner;
+    if((l_tile & 0x8000u) != 0u)
+        uv.x = 1.0 - uv.x;
+    if((l_tile & 0x4000u) != 0u)
+        uv.y = 1.0 - uv.y;
+    if((l_tile & 0x2000u) != 0u)
+        uv = uv.yx;
+
+    vec2 cell = vec2(gl_InstanceID & 31, gl_InstanceID >> 5);
+    TexCoords = uv;
+    TileIndex = gid - 1u;
+    gl_Position = view_projection * vec4(chunk_origin + (cell + corner) * tile_size, 0.0, 1.0);
+}
+)"
@@ -0,0 +1,36 @@
+R"(
+#version 330 core
+
+in vec2 TilePos;
+out vec4 color;
+
+uniform usampler2D tiles;
+uniform sampler2DArray img_array;
+
+void main()
+{
+    // Gradients of the continuous position, uv jumps at tile edges and would pick the
+    // coarsest mip there. Taken before any discard
+    vec2 uv_dx = dFdx(TilePos);
+    vec2 uv_dy = dFdy(TilePos);
+
+    ivec2 cell = ivec2(floor(TilePos));
+    if(any(lessThan(cell, ivec2(0))) || any(greaterThanEqual(cell, textureSize(tiles, 0))))
+        discard;
+    uint tile = texelFetch(tiles, cell, 0).r;
+    uint gid = tile & 0x1fffu;
+    if(gid == 0u)
+        discard;
+
+    // Same flip order as tilemap_chunk
+    vec2 uv = TilePos - vec2(cell);
+    if((tile & 0x8000u) != 0u)
+        uv.x = 1.0 - uv.x;
+    if((tile & 0x4000u) != 0u)
+        uv.y = 1.0 - uv.y;
+    if((tile & 0x2000u) != 0u)
+        uv = uv.yx;
+
+    color = textureGrad(img_array, vec3(uv, float(gid - 1u)), uv_dx, uv_dy);
+}
+)"
@@ -0,0 +1,26 @@
+R"(
+#version 330 core
+// Screen covering triangle strip, fragments find their tile in the tile index texture
+
+out vec2 TilePos;
+
+layout (std140) uniform Camera
+{
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    float time;
+    float delta_time;
+};
+
+uniform vec2 tile_size;
+
+void main()
+{
+    vec2 ndc = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0 - 1.0;
+    vec4 world = inverse(view_projection) * vec4(ndc, 0.0, 1.0);
+    world.xy /= world.w;
+    TilePos = world.xy / tile_size;
+    gl_Position = view_projection * vec4(world.xy, 0.0, 1.0);
+}
+)"
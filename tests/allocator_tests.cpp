@@ -0,0 +1,171 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "../src/memory/pool_allocator.h"
+#include "../src/memory/small_allocator.h"
+#include "doctest/doctest.h"
+#include <cstring>
+#include <thread>
+#include <vector>
+
+TEST_CASE("pool-allocator")
+{
+    using namespace sc2d::memory;
+
+    SUBCASE("out of order deallocation keeps used blocks intact")
+    {
+        pool_allocator pool;
+        pool.create(sizeof(size_t), 8, alignof(size_t));
+
+        size_t* a = (size_t*)pool.allocate().ptr;
+        size_t* b = (size_t*)pool.allocate().ptr;
+        size_t* c = (size_t*)pool.allocate().ptr;
+        *a = 1;
+        *b = 2;
+        *c = 3;
+
+        pool.deallocate(a);
+        size_t* d = (size_t*)pool.allocate().ptr;
+        size_t* e = (size_t*)pool.allocate().ptr;
+
+        CHECK(d == a);
+        CHECK(e != b);
+        CHECK(e != c);
+        CHECK(*b == 2);
+        CHECK(*c == 3);
+        CHECK(pool.get_intialized_num() == 4);
+    }
+
+    SUBCASE("all blocks are reused after freeing a full pool")
+    {
+        pool_allocator pool;
+        pool.create(sizeof(size_t), 4, alignof(size_t));
+
+        size_t* blocks[4];
+        for(auto& block : blocks)
+            block = (size_t*)pool.allocate().ptr;
+
+        pool.deallocate(blocks[2]);
+        pool.deallocate(blocks[0]);
+        pool.deallocate(blocks[3]);
+
+        size_t* again[3];
+        for(auto& block : again) {
+            alloc_result res = pool.allocate();
+            CHECK(res.resized == is_resized::NO);
+            block = (size_t*)res.ptr;
+        }
+
+        CHECK(again[0] == blocks[3]);
+        CHECK(again[1] == blocks[0]);
+        CHECK(again[2] == blocks[2]);
+        CHECK(pool.get_intialized_num() == pool.get_num_of_blocks());
+    }
+}
+
+TEST_CASE("small-object-allocator")
+{
+    using sc2d::memory::small_allocator;
+
+    SUBCASE("size classes")
+    {
+        CHECK(small_allocator::size_class(1) == 0);
+        CHECK(small_allocator::size_class(8) == 0);
+        CHECK(small_allocator::size_class(9) == 1);
+        CHECK(small_allocator::size_class(64) == 3);
+        CHECK(small_allocator::size_class(65) == 4);
+        CHECK(small_allocator::size_class(512) == small_allocator::NUM_OF_CLASSES - 1);
+    }
+
+    SUBCASE("blocks do not overlap and are aligned to their size class")
+    {
+        std::vector<unsigned char*> ptrs;
+        for(size_t i = 0; i < 2000; ++i) {
+            const size_t size = 1 + (i * 37) % small_allocator::MAX_BLOCK_SIZE;
+            auto* ptr = (unsigned char*)small_allocator::allocate(size);
+            CHECK(ptr != nullptr);
+            CHECK(small_allocator::owns(ptr));
+            CHECK((uintptr_t)ptr % small_allocator::MIN_BLOCK_SIZE == 0);
+            memset(ptr, (int)(i & 0xff), size);
+            ptrs.push_back(ptr);
+        }
+
+        bool intact = true;
+        for(size_t i = 0; i < ptrs.size(); ++i) {
+            const size_t size = 1 + (i * 37) % small_allocator::MAX_BLOCK_SIZE;
+            for(size_t j = 0; j < size; ++j)
+                intact &= ptrs[i][j] == (unsigned char)(i & 0xff);
+        }
+        CHECK(intact);
+
+        for(size_t i = 0; i < ptrs.size(); i += 2)
+            small_allocator::deallocate(ptrs[i]);
+        for(size_t i = 1; i < ptrs.size(); i += 2)
+            small_allocator::deallocate(ptrs[i]);
+    }
+
+    SUBCASE("freed block is reused by the same thread")
+    {
+        void* first = small_allocator::allocate(24);
+        small_allocator::deallocate(first);
+        void* second = small_allocator::allocate(30);
+        CHECK(first == second);
+        small_allocator::deallocate(second);
+    }
+
+    SUBCASE("big blocks go to malloc")
+    {
+        void* ptr = small_allocator::allocate(small_allocator::MAX_BLOCK_SIZE + 1);
+        CHECK(ptr != nullptr);
+        CHECK_FALSE(small_allocator::owns(ptr));
+        small_allocator::deallocate(ptr);
+        small_allocator::deallocate(nullptr);
+    }
+
+    SUBCASE("blocks are freed from another thread")
+    {
+        constexpr size_t count = 10000;
+        std::vector<void*> ptrs(count);
+
+        std::thread producer([&ptrs] {
+            for(size_t i = 0; i < count; ++i)
+                ptrs[i] = small_allocator::allocate(16 + i % 100);
+        });
+        producer.join();
+
+        std::thread consumer([&ptrs] {
+            for(void* ptr : ptrs)
+                small_allocator::deallocate(ptr);
+        });
+        consumer.join();
+
+        small_allocator::flush_thread_cache();
+        void* ptr = small_allocator::allocate(16);
+        CHECK(small_allocator::owns(ptr));
+        small_allocator::deallocate(ptr);
+    }
+
+    SUBCASE("thread that only frees returns its cache on exit")
+    {
+        void* block = nullptr;
+        std::thread producer([&block] { block = small_allocator::allocate(300); });
+        producer.join();
+        std::thread consumer([block] { small_allocator::deallocate(block); });
+        consumer.join();
+
+        // Left in the consumer cache, the block would never be handed out again
+        bool reused = false;
+        std::thread reader([block, &reused] {
+            std::vector<void*> ptrs;
+            for(int i = 0; i < 64 && !reused; ++i) {
+                ptrs.push_back(small_allocator::allocate(300));
+                reused = ptrs.back() == block;
+            }
+            for(void* ptr : ptrs)
+                small_allocator::deallocate(ptr);
+        });
+        reader.join();
+        CHECK(reused);
+    }
+}
@@ -0,0 +1,146 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "../src/collections/bitset.h"
+#include "doctest/doctest.h"
+#include <vector>
+
+TEST_CASE("fixed-bitset")
+{
+    SUBCASE("set / reset / count")
+    {
+        sc2d::fixed_bitset<100> bits;
+        CHECK(bits.none());
+        bits.set(0).set(63).set(64).set(99);
+        CHECK(bits.test(63));
+        CHECK(bits[64]);
+        CHECK_FALSE(bits.test(62));
+        CHECK(bits.count() == 4);
+        bits.reset(63);
+        CHECK(bits.count() == 3);
+        bits.reset();
+        CHECK(bits.none());
+    }
+
+    SUBCASE("and / or / xor / and_not")
+    {
+        sc2d::fixed_bitset<256> a;
+        sc2d::fixed_bitset<256> b;
+        for(size_t i = 0; i < 256; i += 2)
+            a.set(i);
+        for(size_t i = 0; i < 256; i += 3)
+            b.set(i);
+
+        auto both = a;
+        both &= b;
+        auto either = a;
+        either |= b;
+        auto one = a;
+        one ^= b;
+        auto only_a = a;
+        only_a.and_not(b);
+
+        bool ok = true;
+        for(size_t i = 0; i < 256; ++i) {
+            const bool in_a = i % 2 == 0;
+            const bool in_b = i % 3 == 0;
+            ok &= both[i] == (in_a && in_b);
+            ok &= either[i] == (in_a || in_b);
+            ok &= one[i] == (in_a != in_b);
+            ok &= only_a[i] == (in_a && !in_b);
+        }
+        CHECK(ok);
+        CHECK(both.count() == 43);
+        CHECK(a.contains(both));
+        CHECK_FALSE(both.contains(a));
+        CHECK(both != a);
+    }
+
+    SUBCASE("find and iterate set bits")
+    {
+        sc2d::fixed_bitset<130> bits;
+        CHECK(bits.find_first() == 130);
+        const size_t expected[] = {3, 64, 65, 129};
+        for(size_t i : expected)
+            bits.set(i);
+
+        std::vector<size_t> found;
+        for(size_t i = bits.find_first(); i < bits.size(); i = bits.find_next(i))
+            found.push_back(i);
+        CHECK(found == std::vector<size_t>(expected, expected + 4));
+
+        found.clear();
+        bits.for_each_set([&](size_t i) { found.push_back(i); });
+        CHECK(found == std::vector<size_t>(expected, expected + 4));
+    }
+}
+
+TEST_CASE("dynamic-bitset")
+{
+    SUBCASE("resize keeps bits past size clear")
+    {
+        sc2d::dynamic_bitset bits(70, true);
+        CHECK(bits.count() == 70);
+        bits.resize(10);
+        CHECK(bits.count() == 10);
+        bits.resize(70);
+        CHECK(bits.count() == 10);
+        bits.resize(200, true);
+        CHECK(bits.count() == 200 - 60);
+        CHECK_FALSE(bits.test(10));
+        CHECK(bits.test(70));
+        CHECK(bits.test(199));
+    }
+
+    SUBCASE("visited set")
+    {
+        sc2d::dynamic_bitset visited(1000);
+        CHECK_FALSE(visited.test_and_set(500));
+        CHECK(visited.test_and_set(500));
+        CHECK(visited.count() == 1);
+        visited.clear();
+        CHECK(visited.none());
+        CHECK(visited.size() == 1000);
+    }
+
+    SUBCASE("word-parallel operations")
+    {
+        sc2d::dynamic_bitset a(1001);
+        sc2d::dynamic_bitset b(1001);
+        for(size_t i = 0; i < 1001; i += 5)
+            a.set(i);
+        for(size_t i = 0; i < 1001; i += 7)
+            b.set(i);
+
+        auto both = a;
+        both &= b;
+        CHECK(both.count() == 29);
+        auto either = a;
+        either |= b;
+        CHECK(either.count() == 201 + 143 - 29);
+        either.and_not(a);
+        CHECK(either.count() == 143 - 29);
+        either ^= b;
+        CHECK(either == both);
+        CHECK(b.contains(both));
+    }
+
+    SUBCASE("find and iterate set bits")
+    {
+        sc2d::dynamic_bitset bits(300);
+        CHECK(bits.find_first() == sc2d::dynamic_bitset::npos);
+        bits.set(0);
+        bits.set(128);
+        bits.set(299);
+
+        std::vector<size_t> found;
+        for(size_t i = bits.find_first(); i != sc2d::dynamic_bitset::npos; i = bits.find_next(i))
+            found.push_back(i);
+        CHECK(found == std::vector<size_t> {0, 128, 299});
+
+        size_t sum = 0;
+        bits.for_each_set([&](size_t i) { sum += i; });
+        CHECK(sum == 427);
+    }
+}
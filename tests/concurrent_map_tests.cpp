@@ -0,0 +1,97 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "../src/collections/concurrent_map.h"
+#include "doctest/doctest.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("concurrent-map")
+{
+    SUBCASE("insert / find / replace")
+    {
+        sc2d::concurrent_map<int, std::string> map;
+        CHECK(map.find(1) == nullptr);
+
+        auto [first, inserted] = map.try_emplace(1, "one");
+        CHECK(inserted);
+        CHECK(*first == "one");
+        auto [same, inserted_again] = map.try_emplace(1, "uno");
+        CHECK_FALSE(inserted_again);
+        CHECK(same == first);
+
+        const std::string* replaced = map.insert_or_assign(1, "eins");
+        CHECK(*map.find(1) == "eins");
+        CHECK(map.find(1) == replaced);
+        // old value stays readable until clear()
+        CHECK(*first == "one");
+
+        for(int i = 2; i < 200; ++i)
+            map.try_emplace(i, std::to_string(i));
+        CHECK(map.size() == 199);
+        CHECK(*map.find(150) == "150");
+        CHECK(map.find(1) == replaced);
+
+        size_t visited = 0;
+        map.for_each([&](int key, const std::string& value) {
+            visited += key == 1 ? value == "eins" : value == std::to_string(key);
+        });
+        CHECK(visited == 199);
+
+        size_t retired = 0;
+        map.for_each_retired([&](const std::string& value) { retired += value == "one"; });
+        CHECK(retired == 1);
+
+        map.clear();
+        CHECK(map.size() == 0);
+        CHECK_FALSE(map.contains(150));
+        retired = 0;
+        map.for_each_retired([&](const std::string&) { ++retired; });
+        CHECK(retired == 0);
+    }
+
+    SUBCASE("readers run while writers publish")
+    {
+        constexpr int WRITERS = 2;
+        constexpr int READERS = 4;
+        constexpr int KEYS_PER_WRITER = 2000;
+
+        sc2d::concurrent_map<int, int> map;
+        std::atomic<int> done_writers {0};
+        std::atomic<bool> bad_value {false};
+        std::vector<std::thread> threads;
+
+        for(int w = 0; w < WRITERS; ++w) {
+            threads.emplace_back([&, w] {
+                for(int i = 0; i < KEYS_PER_WRITER; ++i) {
+                    const int key = i * WRITERS + w;
+                    map.try_emplace(key, key * 3);
+                }
+                ++done_writers;
+            });
+        }
+        for(int r = 0; r < READERS; ++r) {
+            threads.emplace_back([&] {
+                while(done_writers.load() < WRITERS) {
+                    for(int key = 0; key < KEYS_PER_WRITER * WRITERS; key += 7) {
+                        const int* value = map.find(key);
+                        if(value && *value != key * 3)
+                            bad_value = true;
+                    }
+                }
+            });
+        }
+        for(auto& t : threads)
+            t.join();
+
+        CHECK_FALSE(bad_value.load());
+        CHECK(map.size() == WRITERS * KEYS_PER_WRITER);
+        bool all_found = true;
+        for(int key = 0; key < KEYS_PER_WRITER * WRITERS; ++key)
+            all_found &= map.find(key) && *map.find(key) == key * 3;
+        CHECK(all_found);
+    }
+}
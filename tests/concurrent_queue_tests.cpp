@@ -0,0 +1,219 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "../src/collections/mpmc_queue.h"
+#include "../src/collections/spsc_queue.h"
+#include "doctest/doctest.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("spsc-queue")
+{
+    SUBCASE("capacity is rounded up to power of two")
+    {
+        sc2d::spsc_queue<int> q(100);
+        CHECK(q.capacity() == 128);
+        CHECK(q.empty());
+    }
+
+    SUBCASE("push and pop in order, fails when full / empty")
+    {
+        sc2d::spsc_queue<int> q(4);
+        for(int i = 0; i < 4; ++i)
+            CHECK(q.try_push(i));
+        CHECK_FALSE(q.try_push(4));
+        CHECK(q.size() == 4);
+
+        int value = -1;
+        for(int i = 0; i < 4; ++i) {
+            CHECK(q.try_pop(value));
+            CHECK(value == i);
+        }
+        CHECK_FALSE(q.try_pop(value));
+    }
+
+    SUBCASE("batch push and pop wrap around the buffer")
+    {
+        sc2d::spsc_queue<int> q(8);
+        int in[8];
+        int out[8];
+        // Moving start away from the buffer begin
+        q.try_push(0);
+        q.try_pop(out[0]);
+        for(int round = 0; round < 5; ++round) {
+            for(int i = 0; i < 8; ++i)
+                in[i] = round * 10 + i;
+
+            CHECK(q.push_batch(in, 5) == 5);
+            CHECK(q.push_batch(in + 5, 5) == 3);
+            CHECK(q.pop_batch(out, 6) == 6);
+            CHECK(out[0] == round * 10);
+            CHECK(out[5] == round * 10 + 5);
+            CHECK(q.pop_batch(out, 8) == 2);
+            CHECK(out[1] == round * 10 + 7);
+        }
+    }
+
+    SUBCASE("non-trivial elements are destroyed")
+    {
+        auto counter = std::make_shared<int>(0);
+        {
+            sc2d::spsc_queue<std::shared_ptr<int>> q(4);
+            q.try_push(counter);
+            q.try_push(counter);
+            std::shared_ptr<int> out;
+            CHECK(q.try_pop(out));
+            CHECK(counter.use_count() == 3);
+        }
+        CHECK(counter.use_count() == 1);
+    }
+
+    SUBCASE("stress: producer and consumer threads")
+    {
+        constexpr size_t count = 200000;
+        sc2d::spsc_queue<size_t> q(1024);
+        bool ordered = true;
+        size_t sum = 0;
+
+        std::thread consumer([&] {
+            size_t expected = 0;
+            size_t batch[64];
+            while(expected < count) {
+                const size_t n = (expected & 1u) ? q.pop_batch(batch, 64)
+                                                 : q.try_pop(batch[0]) ? 1 : 0;
+                for(size_t i = 0; i < n; ++i, ++expected) {
+                    ordered &= batch[i] == expected;
+                    sum += batch[i];
+                }
+                if(n == 0)
+                    std::this_thread::yield();
+            }
+        });
+
+        size_t batch[32];
+        for(size_t i = 0; i < count;) {
+            if(i % 3 == 0) {
+                size_t n = count - i < 32 ? count - i : 32;
+                for(size_t j = 0; j < n; ++j)
+                    batch[j] = i + j;
+                i += q.push_batch(batch, n);
+            } else if(q.try_push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        consumer.join();
+
+        CHECK(ordered);
+        CHECK(sum == count * (count - 1) / 2);
+        CHECK(q.empty());
+    }
+}
+
+TEST_CASE("mpmc-queue")
+{
+    SUBCASE("push and pop in order, fails when full / empty")
+    {
+        sc2d::mpmc_queue<int> q(4);
+        CHECK(q.capacity() == 4);
+        for(int i = 0; i < 4; ++i)
+            CHECK(q.try_push(i));
+        CHECK_FALSE(q.try_push(4));
+
+        int value = -1;
+        for(int i = 0; i < 4; ++i) {
+            CHECK(q.try_pop(value));
+            CHECK(value == i);
+        }
+        CHECK_FALSE(q.try_pop(value));
+        CHECK(q.empty());
+    }
+
+    SUBCASE("batch push and pop")
+    {
+        sc2d::mpmc_queue<std::string> q(8);
+        const std::string in[] = {"a", "b", "c", "d", "e", "f"};
+        std::string out[8];
+
+        CHECK(q.push_batch(in, 6) == 6);
+        CHECK(q.push_batch(in, 6) == 2);
+        CHECK(q.pop_batch(out, 3) == 3);
+        CHECK(out[2] == "c");
+        CHECK(q.push_batch(in, 0) == 0);
+        CHECK(q.pop_batch(out, 8) == 5);
+        CHECK(out[4] == "b");
+        CHECK(q.pop_batch(out, 8) == 0);
+    }
+
+    SUBCASE("stress: 4 producers, 4 consumers")
+    {
+        constexpr size_t producers = 4;
+        constexpr size_t consumers = 4;
+        constexpr size_t per_producer = 50000;
+        constexpr size_t total = producers * per_producer;
+
+        sc2d::mpmc_queue<size_t> q(256);
+        std::atomic<size_t> popped {0};
+        std::atomic<size_t> sum {0};
+        // Each producer's values must come out in order for any single consumer
+        std::atomic<bool> ordered {true};
+        std::vector<std::thread> threads;
+
+        for(size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&q, p] {
+                size_t batch[16];
+                for(size_t i = 0; i < per_producer;) {
+                    const size_t value = p * per_producer + i;
+                    if(i & 1u) {
+                        size_t n = per_producer - i < 16 ? per_producer - i : 16;
+                        for(size_t j = 0; j < n; ++j)
+                            batch[j] = value + j;
+                        i += q.push_batch(batch, n);
+                    } else if(q.try_push(value)) {
+                        ++i;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        for(size_t c = 0; c < consumers; ++c) {
+            threads.emplace_back([&, c] {
+                size_t last[producers];
+                for(auto& l : last)
+                    l = (size_t)-1;
+                size_t batch[16];
+                size_t local_sum = 0;
+                while(popped.load(std::memory_order_relaxed) < total) {
+                    const size_t n = (c & 1u) ? q.pop_batch(batch, 16)
+                                              : q.try_pop(batch[0]) ? 1 : 0;
+                    for(size_t i = 0; i < n; ++i) {
+                        const size_t producer = batch[i] / per_producer;
+                        if(last[producer] != (size_t)-1 && batch[i] <= last[producer])
+                            ordered = false;
+                        last[producer] = batch[i];
+                        local_sum += batch[i];
+                    }
+                    if(n == 0)
+                        std::this_thread::yield();
+                    popped.fetch_add(n, std::memory_order_relaxed);
+                }
+                sum.fetch_add(local_sum);
+            });
+        }
+
+        for(auto& t : threads)
+            t.join();
+
+        CHECK(popped.load() == total);
+        CHECK(sum.load() == total * (total - 1) / 2);
+        CHECK(ordered.load());
+        CHECK(q.empty());
+    }
+}
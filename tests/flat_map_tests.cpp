@@ -0,0 +1,197 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "../src/collections/flat_map.h"
+#include "doctest/doctest.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace
+{
+    /**
+     * Puts every key in the same probe sequence
+     */
+    struct colliding_hash
+    {
+        size_t operator()(int) const
+        {
+            return 0;
+        }
+    };
+}
+
+TEST_CASE("flat-map")
+{
+    SUBCASE("empty map")
+    {
+        sc2d::flat_map<int, int> map;
+        CHECK(map.empty());
+        CHECK(map.capacity() == 0);
+        CHECK(map.begin() == map.end());
+        CHECK(map.find(1) == map.end());
+        CHECK_FALSE(map.contains(1));
+        CHECK(map.erase(1) == 0);
+    }
+
+    SUBCASE("insert, find and operator[]")
+    {
+        sc2d::flat_map<int, int> map;
+        CHECK(map.insert({1, 10}).second);
+        CHECK_FALSE(map.insert({1, 20}).second);
+        CHECK(map.find(1)->second == 10);
+        CHECK(map.try_emplace(2, 20).second);
+        map[3] = 30;
+        CHECK(map[3] == 30);
+        CHECK(map[4] == 0);
+        CHECK(map.size() == 4);
+        CHECK(map.count(2) == 1);
+        CHECK(map.count(5) == 0);
+
+        map.insert_or_assign(1, 11);
+        CHECK(map[1] == 11);
+    }
+
+    SUBCASE("grows and keeps all entries")
+    {
+        sc2d::flat_map<int, int> map;
+        for(int i = 0; i < 10000; ++i)
+            map[i * 7] = i;
+
+        CHECK(map.size() == 10000);
+        CHECK(map.size() <= map.capacity() - map.capacity() / 8);
+        bool all_found = true;
+        for(int i = 0; i < 10000; ++i)
+            all_found &= map.find(i * 7) != map.end() && map.find(i * 7)->second == i;
+        CHECK(all_found);
+        CHECK_FALSE(map.contains(1));
+
+        size_t visited = 0;
+        long long sum = 0;
+        for(const auto& [key, value] : map) {
+            ++visited;
+            sum += value;
+        }
+        CHECK(visited == 10000);
+        CHECK(sum == 10000LL * 9999 / 2);
+    }
+
+    SUBCASE("reserve avoids rehashing")
+    {
+        sc2d::flat_map<int, int> map(1000);
+        const size_t capacity = map.capacity();
+        for(int i = 0; i < 1000; ++i)
+            map[i] = i;
+        CHECK(map.capacity() == capacity);
+    }
+
+    SUBCASE("erase and reinsert")
+    {
+        sc2d::flat_map<int, int> map;
+        for(int i = 0; i < 1000; ++i)
+            map[i] = i;
+        for(int i = 0; i < 1000; i += 2)
+            CHECK(map.erase(i) == 1);
+        CHECK(map.size() == 500);
+        CHECK_FALSE(map.contains(0));
+        CHECK(map.contains(1));
+
+        map.erase(map.find(1));
+        CHECK_FALSE(map.contains(1));
+        CHECK(map.size() == 499);
+
+        for(int i = 0; i < 1000; i += 2)
+            map[i] = -i;
+        CHECK(map.size() == 999);
+        CHECK(map[998] == -998);
+        CHECK(map[999] == 999);
+    }
+
+    SUBCASE("erase / insert churn does not grow the table")
+    {
+        sc2d::flat_map<int, int> map;
+        for(int i = 0; i < 100; ++i)
+            map[i] = i;
+        const size_t capacity = map.capacity();
+        for(int i = 100; i < 100000; ++i) {
+            map.erase(i - 100);
+            map[i] = i;
+        }
+        CHECK(map.size() == 100);
+        // Tombstones are cleaned by rehashing in place, at most one growth
+        CHECK(map.capacity() <= capacity * 2 + 1);
+        CHECK(map[99999] == 99999);
+        CHECK_FALSE(map.contains(99899));
+    }
+
+    SUBCASE("keys with the same hash")
+    {
+        sc2d::flat_map<int, int, colliding_hash> map;
+        for(int i = 0; i < 100; ++i)
+            map[i] = i;
+        map.erase(50);
+        CHECK(map.size() == 99);
+        CHECK_FALSE(map.contains(50));
+        CHECK(map[99] == 99);
+        CHECK(map[0] == 0);
+    }
+
+    SUBCASE("string keys, copy and move")
+    {
+        sc2d::flat_map<std::string, std::string> map;
+        for(int i = 0; i < 100; ++i)
+            map[std::to_string(i)] = "value " + std::to_string(i);
+
+        sc2d::flat_map<std::string, std::string> copy(map);
+        CHECK(copy.size() == 100);
+        CHECK(copy["42"] == "value 42");
+
+        sc2d::flat_map<std::string, std::string> moved(std::move(map));
+        CHECK(map.empty());
+        CHECK(moved["7"] == "value 7");
+        map = moved;
+        CHECK(map.size() == 100);
+
+        moved.clear();
+        CHECK(moved.empty());
+        CHECK(moved.begin() == moved.end());
+        CHECK_FALSE(moved.contains("7"));
+    }
+
+    SUBCASE("values are destroyed")
+    {
+        auto counter = std::make_shared<int>(0);
+        {
+            sc2d::flat_map<int, std::shared_ptr<int>> map;
+            for(int i = 0; i < 100; ++i)
+                map[i] = counter;
+            map.erase(3);
+            CHECK(counter.use_count() == 100);
+        }
+        CHECK(counter.use_count() == 1);
+    }
+
+    SUBCASE("matches std::unordered_map on random operations")
+    {
+        sc2d::flat_map<unsigned, unsigned> map;
+        std::unordered_map<unsigned, unsigned> reference;
+        unsigned seed = 12345;
+        bool same = true;
+        for(int i = 0; i < 50000; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            const unsigned key = (seed >> 8u) % 2000;
+            if(seed & 1u) {
+                map[key] = i;
+                reference[key] = i;
+            } else {
+                same &= map.erase(key) == reference.erase(key);
+            }
+        }
+        CHECK(same);
+        CHECK(map.size() == reference.size());
+        for(const auto& [key, value] : reference)
+            same &= map.contains(key) && map[key] == value;
+        CHECK(same);
+    }
+}
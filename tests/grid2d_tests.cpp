@@ -0,0 +1,121 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "../src/collections/grid2d.h"
+#include "doctest/doctest.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("morton")
+{
+    CHECK(sc2d::bits::morton2(0, 0) == 0);
+    CHECK(sc2d::bits::morton2(1, 0) == 1);
+    CHECK(sc2d::bits::morton2(0, 1) == 2);
+    CHECK(sc2d::bits::morton2(3, 3) == 15);
+    CHECK(sc2d::bits::morton2(0xffff, 0) == 0x55555555u);
+    CHECK(sc2d::bits::compact1by1(sc2d::bits::part1by1(12345)) == 12345);
+}
+
+template <typename Grid>
+static void check_grid(Grid& grid, uint32_t width, uint32_t height)
+{
+    std::vector<uint32_t> src(width * height);
+    for(uint32_t i = 0; i < src.size(); ++i)
+        src[i] = i;
+    grid.assign_row_major(src.data(), width, height);
+    CHECK(grid.width() == width);
+    CHECK(grid.height() == height);
+    CHECK(grid.storage_size() >= grid.size());
+
+    // every cell maps to its own storage slot
+    std::vector<bool> used(grid.storage_size());
+    bool unique = true;
+    bool values = true;
+    for(uint32_t y = 0; y < height; ++y) {
+        for(uint32_t x = 0; x < width; ++x) {
+            const size_t index = grid.index_of(x, y);
+            unique &= index < used.size() && !used[index];
+            used[index] = true;
+            values &= grid(x, y) == y * width + x;
+        }
+    }
+    CHECK(unique);
+    CHECK(values);
+
+    // region walks each clipped cell once
+    size_t visited = 0;
+    bool region_ok = true;
+    grid.for_each_in_region(-3, 2, 14, 100, [&](uint32_t x, uint32_t y, uint32_t& cell) {
+        region_ok &= x < 11 && y >= 2 && cell == y * width + x;
+        ++visited;
+    });
+    CHECK(region_ok);
+    CHECK(visited == std::min<uint32_t>(11u, width) * (height - 2));
+
+    // window partly outside the grid
+    std::vector<uint32_t> window(6 * 4);
+    grid.copy_window(-2, height - 2, 6, 4, window.data(), 0xffffffffu);
+    CHECK(window[0] == 0xffffffffu);
+    CHECK(window[2] == (height - 2) * width);
+    CHECK(window[6 + 5] == (height - 1) * width + 3);
+    CHECK(window[2 * 6 + 2] == 0xffffffffu);
+}
+
+TEST_CASE("grid2d")
+{
+    SUBCASE("morton blocks")
+    {
+        sc2d::grid2d<uint32_t> grid;
+        check_grid(grid, 37, 21);
+        CHECK(grid.index_of(1, 1) == 3);
+        CHECK(grid.index_of(8, 0) == 64);
+    }
+
+    SUBCASE("row-major")
+    {
+        sc2d::grid2d<uint32_t, 0> grid;
+        check_grid(grid, 37, 21);
+        CHECK(grid.index_of(5, 2) == 2 * 37 + 5);
+        CHECK(grid.storage_size() == grid.size());
+    }
+
+    SUBCASE("neighbors")
+    {
+        sc2d::grid2d<int> grid(10, 10, 1);
+        grid(0, 1) = 5;
+        int sum = 0;
+        int count = 0;
+        grid.for_each_neighbor4(0, 0, [&](int, int, int cell) {
+            sum += cell;
+            ++count;
+        });
+        CHECK(count == 2);
+        CHECK(sum == 6);
+
+        count = 0;
+        grid.for_each_neighbor8(5, 5, [&](int x, int y, int) {
+            count += x != 5 || y != 5;
+        });
+        CHECK(count == 8);
+
+        count = 0;
+        grid.for_each_neighbor8(9, 9, [&](int, int, int) { ++count; });
+        CHECK(count == 3);
+
+        CHECK(grid.get_or(-1, 0, 7) == 7);
+        CHECK(grid.get_or(0, 1, 7) == 5);
+    }
+
+    SUBCASE("fill / clear")
+    {
+        sc2d::grid2d<char> grid(3, 3, 'a');
+        grid.fill('b');
+        bool all_b = true;
+        grid.for_each([&](uint32_t, uint32_t, char cell) { all_b &= cell == 'b'; });
+        CHECK(all_b);
+        grid.clear();
+        CHECK(grid.empty());
+    }
+}
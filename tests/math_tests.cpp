@@ -5,7 +5,10 @@
 #include "../src/math/matrix2.h"
 #include "../src/math/matrix3.h"
 #include "../src/math/matrix4.h"
+#include "../src/math/quadtree.h"
 #include "../src/math/vector2.h"
+#include <memory>
+#include <vector>
 
 using namespace math;
 
@@ -314,6 +317,13 @@ TEST_CASE("mat4d-operations")
             matrix *= matrix2;
             CHECK(matrix == mat4(10,10,10,10,20,20,20,20,56,56,56,56,45,45,45,45));
         }
+
+        SUBCASE("last row uses every column of the left matrix")
+        {
+            mat4 left(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 5, 6, 7, 1);
+            mat4 right(2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4, 0, 0, 0, 0, 1);
+            CHECK(left * right == mat4(2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4, 0, 10, 18, 28, 1));
+        }
     }
 
     SUBCASE("matrix addition")
@@ -492,4 +502,33 @@ TEST_CASE("vec2d-operations")
     {
         CHECK(reflection(vector, normalize(vector)) == vec2(-1,-2));
     }
-}
\ No newline at end of file
+}
+TEST_CASE("quadtree-query")
+{
+    QuadTreeNode tree({{0.0f, 0.0f}, {100.0f, 100.0f}});
+    std::vector<std::unique_ptr<QuadTreeData>> items;
+    int objects[41];
+    // Enough small items to split the root, plus one crossing every child
+    for(uint32_t i = 0; i < 40; ++i) {
+        const rect2d bounds({(float)(i % 8) * 12.0f, (float)(i / 8) * 12.0f}, {2.0f, 2.0f});
+        items.push_back(std::make_unique<QuadTreeData>(&objects[i], bounds));
+        tree.insert(*items.back());
+    }
+    items.push_back(
+        std::make_unique<QuadTreeData>(&objects[40], rect2d({40.0f, 40.0f}, {20.0f, 20.0f})));
+    tree.insert(*items.back());
+    CHECK(tree.size() == 41);
+
+    std::vector<QuadTreeData*> found;
+    for(int pass = 0; pass < 2; ++pass) {
+        found.clear();
+        tree.query({{30.0f, 30.0f}, {40.0f, 40.0f}}, found);
+        size_t crossing = 0;
+        for(const QuadTreeData* data : found)
+            crossing += data->object == &objects[40];
+        CHECK(crossing == 1);
+        // Small items at x 36, 48, 60 and y 36, 48, plus the crossing one
+        CHECK(found.size() == 7);
+    }
+    CHECK(tree.query({{0.0f, 0.0f}, {100.0f, 100.0f}}).size() == 41);
+}
@@ -0,0 +1,136 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "../src/memory/object_pool.h"
+#include "doctest/doctest.h"
+#include <string>
+
+namespace
+{
+    struct tracked
+    {
+        explicit tracked(int value)
+            : value(value)
+            , name(std::to_string(value) + " - long enough to skip small string buffer")
+        {
+            ++alive;
+        }
+        tracked(tracked&& other) noexcept
+            : value(other.value)
+            , name(std::move(other.name))
+        {
+            ++alive;
+        }
+        ~tracked()
+        {
+            --alive;
+        }
+
+        int value;
+        std::string name;
+        static int alive;
+    };
+
+    int tracked::alive = 0;
+}
+
+TEST_CASE("object-pool")
+{
+    using namespace sc2d::memory;
+
+    SUBCASE("create / get / destroy")
+    {
+        object_pool<tracked> pool(4);
+        pool_handle a = pool.create(1);
+        pool_handle b = pool.create(2);
+
+        CHECK(pool.size() == 2);
+        CHECK(tracked::alive == 2);
+        CHECK(pool.get(a)->value == 1);
+        CHECK(pool.get(b)->value == 2);
+
+        pool.destroy(a);
+        CHECK(tracked::alive == 1);
+        CHECK(pool.get(a) == nullptr);
+        CHECK_FALSE(pool.is_alive(a));
+
+        // Slot is reused with a new generation, old handle stays dead
+        pool_handle c = pool.create(3);
+        CHECK(c.index() == a.index());
+        CHECK(c.generation() != a.generation());
+        CHECK(pool.get(a) == nullptr);
+        CHECK(pool.get(c)->value == 3);
+        CHECK(pool.get(pool_handle()) == nullptr);
+    }
+
+    SUBCASE("handles survive growth")
+    {
+        object_pool<tracked> pool(2);
+        pool_handle handles[100];
+        for(int i = 0; i < 100; ++i)
+            handles[i] = pool.create(i);
+
+        CHECK(pool.capacity() >= 100);
+        for(int i = 0; i < 100; ++i)
+            CHECK(pool.get(handles[i])->value == i);
+        CHECK(pool.get(handles[42])->name.substr(0, 2) == "42");
+    }
+
+    SUBCASE("trivial objects")
+    {
+        object_pool<double> pool(1);
+        pool_handle handles[10];
+        for(int i = 0; i < 10; ++i)
+            handles[i] = pool.create(i * 1.5);
+        for(int i = 0; i < 10; ++i)
+            CHECK(*pool.get(handles[i]) == i * 1.5);
+    }
+
+    SUBCASE("for_each visits only live objects")
+    {
+        object_pool<tracked> pool(8);
+        pool_handle handles[8];
+        for(int i = 0; i < 8; ++i)
+            handles[i] = pool.create(i);
+        pool.destroy(handles[1]);
+        pool.destroy(handles[6]);
+
+        int sum = 0;
+        int count = 0;
+        pool.for_each([&](pool_handle h, tracked& t) {
+            CHECK(pool.get(h) == &t);
+            sum += t.value;
+            ++count;
+        });
+        CHECK(count == 6);
+        CHECK(sum == 0 + 2 + 3 + 4 + 5 + 7);
+    }
+
+    SUBCASE("defragment")
+    {
+        object_pool<tracked> pool(8);
+        pool_handle handles[8];
+        for(int i = 0; i < 8; ++i)
+            handles[i] = pool.create(i);
+        pool.destroy(handles[0]);
+        pool.destroy(handles[2]);
+        pool.destroy(handles[3]);
+
+        tracked* first = pool.get(handles[1]);
+        CHECK(pool.defragment() == 3);
+
+        // Live objects are packed at the start of the pool
+        const tracked* base = first - 1;
+        for(int i : {1, 4, 5, 6, 7}) {
+            CHECK(pool.get(handles[i])->value == i);
+            CHECK(pool.get(handles[i]) - base < 5);
+        }
+
+        CHECK(tracked::alive == 5);
+        pool_handle h = pool.create(42);
+        CHECK(pool.get(h) - base == 5);
+    }
+
+    CHECK(tracked::alive == 0);
+}
@@ -0,0 +1,366 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "../src/core/rendering/rendering_types.h"
+#include "../src/math/transform.h"
+#include "doctest/doctest.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    struct sprite_columns
+    {
+        std::vector<float> x, y, width, height, rotation;
+        std::vector<sc2d::uv_rect> uv;
+        std::vector<uint32_t> color;
+
+        explicit sprite_columns(size_t count)
+        {
+            std::mt19937 rng(7);
+            std::uniform_real_distribution<float> coord(-500.0f, 500.0f);
+            std::uniform_real_distribution<float> extent(1.0f, 64.0f);
+            std::uniform_real_distribution<float> angle(-20.0f, 20.0f);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+            for(size_t i = 0; i < count; ++i) {
+                x.push_back(coord(rng));
+                y.push_back(coord(rng));
+                width.push_back(extent(rng));
+                height.push_back(extent(rng));
+                rotation.push_back(angle(rng));
+                uv.push_back({{unit(rng), unit(rng)}, {unit(rng), unit(rng)}});
+                color.push_back((uint32_t)rng());
+            }
+        }
+
+        sc2d::sprite_arrays arrays(bool rotated, bool with_uv) const
+        {
+            sc2d::sprite_arrays result;
+            result.x = x.data();
+            result.y = y.data();
+            result.width = width.data();
+            result.height = height.data();
+            result.rotation = rotated ? rotation.data() : nullptr;
+            result.uv = with_uv ? uv.data() : nullptr;
+            result.color = color.data();
+            result.origin = {0.25f, 0.5f};
+            return result;
+        }
+
+        sc2d::batch_sprite sprite(size_t i, bool rotated, bool with_uv) const
+        {
+            sc2d::batch_sprite result;
+            result.pos = {x[i], y[i]};
+            result.size = {width[i], height[i]};
+            result.origin = {0.25f, 0.5f};
+            result.rotation = rotated ? rotation[i] : 0.0f;
+            if(with_uv)
+                result.uv = uv[i];
+            result.color = {(float)(color[i] & 0xffu) / 255.0f,
+                            (float)((color[i] >> 8u) & 0xffu) / 255.0f,
+                            (float)((color[i] >> 16u) & 0xffu) / 255.0f,
+                            (float)(color[i] >> 24u) / 255.0f};
+            return result;
+        }
+    };
+
+    bool near(float a, float b, float tolerance)
+    {
+        return std::fabs(a - b) <= tolerance;
+    }
+
+    bool same_vertex(const sc2d::VertexColored& a, const sc2d::VertexColored& b, float tolerance)
+    {
+        return near(a.pos.x, b.pos.x, tolerance) && near(a.pos.y, b.pos.y, tolerance)
+               && a.uv.x == b.uv.x && a.uv.y == b.uv.y && near(a.color.x, b.color.x, 1e-6f)
+               && near(a.color.y, b.color.y, 1e-6f) && near(a.color.z, b.color.z, 1e-6f)
+               && near(a.color.w, b.color.w, 1e-6f) && a.tex_index == b.tex_index;
+    }
+
+    bool same_vertex(const sc2d::VertexPacked& a, const sc2d::VertexPacked& b, float tolerance)
+    {
+        return near(a.pos.x, b.pos.x, tolerance) && near(a.pos.y, b.pos.y, tolerance)
+               && a.uv[0] == b.uv[0] && a.uv[1] == b.uv[1] && a.color == b.color
+               && a.tex_index == b.tex_index;
+    }
+
+    /**
+     * Adds count sprites with add_many and one by one, all vertices must match
+     */
+    template <typename Buffer>
+    void check_against_single_adds(size_t count, bool rotated, bool with_uv)
+    {
+        const sprite_columns columns(count);
+        auto bulk = std::make_unique<Buffer>();
+        auto single = std::make_unique<Buffer>();
+
+        CHECK(bulk->add_many(columns.arrays(rotated, with_uv), count, 3) == count);
+        for(size_t i = 0; i < count; ++i)
+            single->add(columns.sprite(i, rotated, with_uv), 3);
+        CHECK(bulk->size() == single->size());
+
+        // Positions up to ~600 apart, polynomial sin / cos differ from std in the last bits
+        const float tolerance = rotated ? 1e-3f : 0.0f;
+        size_t mismatches = 0;
+        for(size_t i = 0; i < count; ++i) {
+            const auto& a = bulk->data[i];
+            const auto& b = single->data[i];
+            if(!same_vertex(a.tr, b.tr, tolerance) || !same_vertex(a.br, b.br, tolerance)
+               || !same_vertex(a.bl, b.bl, tolerance) || !same_vertex(a.tl, b.tl, tolerance))
+                ++mismatches;
+        }
+        CHECK(mismatches == 0);
+    }
+}
+
+TEST_CASE("quad-buffer")
+{
+    SUBCASE("add_many matches single adds")
+    {
+        // Counts that leave every possible tail after 8 and 4 wide steps
+        for(size_t count = 1; count <= 19; ++count) {
+            check_against_single_adds<sc2d::QuadBuffer>(count, false, false);
+            check_against_single_adds<sc2d::QuadBuffer>(count, true, true);
+            check_against_single_adds<sc2d::PackedQuadBuffer>(count, false, false);
+            check_against_single_adds<sc2d::PackedQuadBuffer>(count, true, true);
+        }
+        check_against_single_adds<sc2d::QuadBuffer>(1000, false, true);
+        check_against_single_adds<sc2d::QuadBuffer>(1000, true, false);
+        check_against_single_adds<sc2d::PackedQuadBuffer>(1000, false, true);
+        check_against_single_adds<sc2d::PackedQuadBuffer>(1000, true, false);
+    }
+
+    SUBCASE("add_many stops when full")
+    {
+        const size_t count = sc2d::limits::DRAWCALL_QUADS + 5;
+        const sprite_columns columns(count);
+        auto buffer = std::make_unique<sc2d::QuadBuffer>();
+
+        buffer->add({0.0f, 0.0f}, {1.0f, 1.0f}, {1.0f, 1.0f, 1.0f, 1.0f});
+        const size_t added = buffer->add_many(columns.arrays(true, true), count, 0);
+        CHECK(added == sc2d::limits::DRAWCALL_QUADS - 1);
+        CHECK(buffer->size() == sc2d::limits::DRAWCALL_QUADS);
+        CHECK(buffer->add_many(columns.arrays(true, true), count, 0) == 0);
+
+        buffer->clear();
+        CHECK(buffer->size() == 0);
+    }
+
+    SUBCASE("packed buffer quantizes the float vertices")
+    {
+        sc2d::batch_sprite sprite;
+        sprite.pos = {10.0f, 20.0f};
+        sprite.size = {30.0f, 40.0f};
+        sprite.uv = {{0.25f, 0.5f}, {1.0f, 0.75f}};
+        sprite.color = {1.0f, 0.5f, 0.0f, 1.0f};
+        sprite.flip = sc2d::FLIP_Y;
+
+        auto floats = std::make_unique<sc2d::QuadBuffer>();
+        auto packed = std::make_unique<sc2d::PackedQuadBuffer>();
+        floats->add(sprite, 5);
+        packed->add(sprite, 5);
+
+        const sc2d::VertexColored& f = floats->data[0].br;
+        const sc2d::VertexPacked& p = packed->data[0].br;
+        CHECK(p.pos.x == f.pos.x);
+        CHECK(p.pos.y == f.pos.y);
+        CHECK(p.uv[0] == 65535);
+        CHECK(p.uv[1] == (uint16_t)(f.uv.y * 65535.0f + 0.5f));
+        CHECK(p.color == sc2d::pack_rgba8(f.color));
+        CHECK(p.tex_index == 5);
+    }
+
+    SUBCASE("pack_rgba8 puts red in the lowest byte")
+    {
+        CHECK(sc2d::pack_rgba8({1.0f, 0.0f, 0.0f, 1.0f}) == 0xff0000ffu);
+        CHECK(sc2d::pack_rgba8({0.0f, 1.0f, 0.0f, 0.0f}) == 0x0000ff00u);
+        CHECK(sc2d::pack_rgba8({2.0f, -1.0f, 0.5f, 1.0f}) == 0xff8000ffu);
+    }
+}
+
+TEST_CASE("sprite-instance")
+{
+    SUBCASE("packs uv, origin and color")
+    {
+        sc2d::batch_sprite sprite;
+        sprite.pos = {10.0f, 20.0f};
+        sprite.size = {30.0f, 40.0f};
+        sprite.origin = {0.5f, 1.0f};
+        sprite.rotation = 0.5f;
+        sprite.uv = {{0.0f, 0.25f}, {1.0f, 0.75f}};
+        sprite.color = {1.0f, 0.0f, 0.0f, 1.0f};
+        sprite.flip = sc2d::FLIP_X;
+
+        const sc2d::sprite_instance instance = sc2d::make_sprite_instance(sprite, 2);
+        CHECK(instance.pos.x == 10.0f);
+        CHECK(instance.size.y == 40.0f);
+        CHECK(instance.rotation == 0.5f);
+        CHECK(instance.origin[0] == 32768);
+        CHECK(instance.origin[1] == 65535);
+        CHECK(instance.uv[0] == 65535);
+        CHECK(instance.uv[2] == 0);
+        CHECK(instance.uv[1] == 16384);
+        CHECK(instance.uv[3] == 49151);
+        CHECK(instance.color == 0xff0000ffu);
+        CHECK(instance.tex_index == 2);
+    }
+
+    SUBCASE("arrays match single sprites")
+    {
+        // Arrays carry packed colors and no flip, the same sprite without flip must match
+        const sprite_columns columns(5);
+        for(bool with_uv : {false, true}) {
+            sc2d::sprite_instance from_arrays[5];
+            sc2d::make_sprite_instances(columns.arrays(true, with_uv), 5, 1, from_arrays);
+            for(size_t i = 0; i < 5; ++i) {
+                const sc2d::sprite_instance from_sprite =
+                    sc2d::make_sprite_instance(columns.sprite(i, true, with_uv), 1);
+                CHECK(std::memcmp(&from_arrays[i], &from_sprite, sizeof(from_sprite)) == 0);
+            }
+        }
+    }
+}
+
+TEST_CASE("sprite-bounds")
+{
+    sc2d::batch_sprite sprite;
+    sprite.pos = {100.0f, 50.0f};
+    sprite.size = {40.0f, 20.0f};
+    sprite.origin = {0.25f, 0.5f};
+
+    SUBCASE("exact without rotation")
+    {
+        const math::rect2d exact = sc2d::sprite_bounds(sprite);
+        CHECK(exact.origin.x == 90.0f);
+        CHECK(exact.origin.y == 40.0f);
+        CHECK(exact.size.x == 40.0f);
+        CHECK(exact.size.y == 20.0f);
+
+        CHECK(math::rect2d::overlap(exact, {{129.0f, 59.0f}, {10.0f, 10.0f}}));
+        CHECK(!math::rect2d::overlap(exact, {{131.0f, 0.0f}, {10.0f, 100.0f}}));
+    }
+
+    SUBCASE("rotated contains every corner")
+    {
+        auto buffer = std::make_unique<sc2d::QuadBuffer>();
+        sprite.rotation = 1.0f;
+        buffer->add(sprite, 0);
+        const math::rect2d rotated = sc2d::sprite_bounds(sprite);
+        const math::vec2 lo = math::rect2d::get_min(rotated);
+        const math::vec2 hi = math::rect2d::get_max(rotated);
+        for(const auto* v : {&buffer->data[0].tr, &buffer->data[0].br, &buffer->data[0].bl,
+                             &buffer->data[0].tl}) {
+            CHECK(v->pos.x >= lo.x);
+            CHECK(v->pos.x <= hi.x);
+            CHECK(v->pos.y >= lo.y);
+            CHECK(v->pos.y <= hi.y);
+        }
+    }
+
+    SUBCASE("visible runs split sprites at the view edge")
+    {
+        // 10 sprites in a row, 10 units apart, view covers sprites 2..4 and 7 (rotated)
+        float x[10], y[10], width[10], height[10], rotation[10] = {};
+        uint32_t color[10] = {};
+        for(int i = 0; i < 10; ++i) {
+            x[i] = 10.0f * (float)i;
+            y[i] = 0.0f;
+            width[i] = height[i] = 4.0f;
+        }
+        x[7] = 70.0f;
+        y[7] = -8.0f;
+        rotation[7] = 0.7f;
+        const sc2d::sprite_arrays sprites {x, y, width, height, rotation, nullptr, color};
+        const math::rect2d view {{19.0f, -2.0f}, {22.0f, 6.0f}};
+        const math::rect2d lower {{70.0f, -3.0f}, {1.0f, 1.0f}};
+        using run = std::pair<size_t, size_t>;
+
+        CHECK(sc2d::visible_sprite_run(sprites, 0, 10, view) == run(2, 5));
+        CHECK(sc2d::visible_sprite_run(sprites, 3, 10, view) == run(3, 5));
+        CHECK(sc2d::visible_sprite_run(sprites, 5, 10, view) == run(10, 10));
+        // Unrotated, sprite 7 would end at y = -4 and miss
+        CHECK(sc2d::visible_sprite_run(sprites, 5, 10, lower) == run(7, 8));
+        CHECK(sc2d::visible_sprite_run(sprites, 0, 0, view) == run(0, 0));
+    }
+}
+
+TEST_CASE("tile-chunk")
+{
+    SUBCASE("pack keeps flip flags")
+    {
+        CHECK(sc2d::pack_chunk_tile(0) == 0);
+        CHECK(sc2d::pack_chunk_tile(7) == 7);
+        CHECK(sc2d::pack_chunk_tile(0x80000000u | 7) == (sc2d::CHUNK_TILE_FLIP_X | 7));
+        CHECK(sc2d::pack_chunk_tile(0x40000000u | 7) == (sc2d::CHUNK_TILE_FLIP_Y | 7));
+        CHECK(sc2d::pack_chunk_tile(0x20000000u | 7) == (sc2d::CHUNK_TILE_FLIP_DIAGONAL | 7));
+        // too large for 13 bits: empty, the high GID bits must not turn into flip flags
+        CHECK(sc2d::pack_chunk_tile(0xe000u | 7) == 0);
+        CHECK(sc2d::pack_chunk_tile(0x80000000u | 0x12345u) == 0);
+    }
+
+    // 40 x 35 tiles: one full chunk, the others cut by the map edge
+    constexpr uint32_t SIZE = sc2d::limits::TILE_CHUNK_SIZE;
+    sc2d::grid2d<uint32_t> gids(40, 35);
+    for(uint32_t y = 0; y < gids.height(); ++y) {
+        for(uint32_t x = 0; x < gids.width(); ++x)
+            gids(x, y) = (x + y) % 3 == 0 ? 0 : x + 1;
+    }
+    gids(39, 34) = 0x80000000u | 5;
+
+    SUBCASE("fill pads the map edge")
+    {
+        std::vector<sc2d::chunk_tile> chunk(sc2d::limits::TILE_CHUNK_TILES, 0xffff);
+        CHECK(sc2d::fill_tile_chunk(gids, 0, 0, chunk.data()) == SIZE * SIZE);
+        CHECK(chunk[0] == 0);
+        CHECK(chunk[1] == 2);
+        CHECK(chunk[SIZE + 3] == 4);
+
+        CHECK(sc2d::fill_tile_chunk(gids, 1, 1, chunk.data()) == 2 * SIZE + 8);
+        CHECK(chunk[2 * SIZE + 7] == (sc2d::CHUNK_TILE_FLIP_X | 5));
+        CHECK(chunk[8] == 0);
+        CHECK(chunk[3 * SIZE] == 0);
+
+        gids.fill(0);
+        CHECK(sc2d::fill_tile_chunk(gids, 1, 0, chunk.data()) == 0);
+    }
+
+    SUBCASE("layers with too large GIDs do not fit")
+    {
+        CHECK(sc2d::chunk_tiles_fit(gids));
+        gids(3, 3) = 0x2000u;
+        CHECK_FALSE(sc2d::chunk_tiles_fit(gids));
+        gids(3, 3) = 0xe0000000u | sc2d::CHUNK_TILE_GID_MASK;
+        CHECK(sc2d::chunk_tiles_fit(gids));
+    }
+}
+
+TEST_CASE("quad-strip-winding")
+{
+    // Corner order of sprite_instanced.vert and tilemap_chunk.vert, main.cpp culls back faces
+    // with the default counter-clockwise front face
+    const auto strip_corner = [](int id) { return math::vec2((float)(id >> 1), (float)(id & 1)); };
+    // Camera::make_orthographic, y points down; columns combined like GLSL's matrix * vector
+    const math::mat4 proj = math::ortho(0.0f, 64.0f, 64.0f, 0.0f, -1.0f, 1.0f);
+    const auto to_ndc = [&](const math::vec2& p) {
+        const math::vec4 clip = proj[0] * (p.x * 16.0f) + proj[1] * (p.y * 16.0f) + proj[3];
+        return math::vec2(clip.x / clip.w, clip.y / clip.w);
+    };
+
+    SUBCASE("both triangles are front facing")
+    {
+        // Strip triangle i is (i, i + 1, i + 2), odd triangles are wound the other way by GL
+        for(int i = 0; i < 2; ++i) {
+            const math::vec2 a = to_ndc(strip_corner(i));
+            const math::vec2 b = to_ndc(strip_corner(i + 1 + (i & 1)));
+            const math::vec2 c = to_ndc(strip_corner(i + 2 - (i & 1)));
+            const float signed_area = (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+            CHECK(signed_area > 0.0f);
+        }
+    }
+}
@@ -0,0 +1,100 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "../src/collections/radix_sort.h"
+#include "../src/core/rendering/render_key.h"
+#include "doctest/doctest.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct keyed
+    {
+        uint64_t key;
+        uint32_t order;
+    };
+
+    std::vector<keyed> random_items(size_t count, uint64_t key_mask)
+    {
+        std::mt19937_64 rng(42);
+        std::vector<keyed> items(count);
+        for(size_t i = 0; i < count; ++i)
+            items[i] = {rng() & key_mask, (uint32_t)i};
+        return items;
+    }
+
+    bool sorted_and_stable(const std::vector<keyed>& items)
+    {
+        for(size_t i = 1; i < items.size(); ++i) {
+            if(items[i - 1].key > items[i].key)
+                return false;
+            if(items[i - 1].key == items[i].key && items[i - 1].order > items[i].order)
+                return false;
+        }
+        return true;
+    }
+}
+
+TEST_CASE("radix-sort")
+{
+    const auto key_of = [](const keyed& item) { return item.key; };
+
+    SUBCASE("full 64-bit keys")
+    {
+        auto items = random_items(5000, ~0ull);
+        std::vector<keyed> scratch(items.size());
+        sc2d::radix_sort64(items.data(), scratch.data(), items.size(), key_of);
+        CHECK(sorted_and_stable(items));
+    }
+
+    SUBCASE("few distinct keys stay stable, skipped passes")
+    {
+        auto items = random_items(5000, 0x0f000000000000f0ull);
+        std::vector<keyed> scratch(items.size());
+        sc2d::radix_sort64(items.data(), scratch.data(), items.size(), key_of);
+        CHECK(sorted_and_stable(items));
+    }
+
+    SUBCASE("small input falls back to stable_sort")
+    {
+        auto items = random_items(10, 0x3);
+        std::vector<keyed> scratch(items.size());
+        sc2d::radix_sort64(items.data(), scratch.data(), items.size(), key_of);
+        CHECK(sorted_and_stable(items));
+    }
+}
+
+TEST_CASE("render-key")
+{
+    constexpr sc2d::render_key_layout layout;
+    static_assert(layout.is_valid(), "default render key layout is invalid");
+
+    SUBCASE("fields are ordered by offset")
+    {
+        CHECK(layout.encode(1, 0, 0, 0) > layout.encode(0, 4095, 65535, 0xfffffff));
+        CHECK(layout.encode(0, 2, 0, 0) > layout.encode(0, 1, 65535, 0xfffffff));
+        CHECK(layout.encode(0, 0, 3, 0) > layout.encode(0, 0, 2, 0xfffffff));
+        CHECK(layout.depth.decode(layout.encode(7, 8, 9, 10)) == 10);
+        CHECK(layout.texture.decode(layout.encode(7, 8, 9, 10)) == 9);
+    }
+
+    SUBCASE("custom layouts")
+    {
+        sc2d::render_key_layout depth_first;
+        depth_first.layer = {56, 8};
+        depth_first.depth = {24, 32};
+        depth_first.shader = {0, 0};
+        depth_first.texture = {0, 24};
+        CHECK(depth_first.is_valid());
+        CHECK(depth_first.encode(0, 99, 0, 2) > depth_first.encode(0, 0, 100, 1));
+        CHECK(depth_first.shader.decode(depth_first.encode(0, 99, 0, 0)) == 0);
+
+        sc2d::render_key_layout overlapping;
+        overlapping.depth = {0, 30};
+        CHECK_FALSE(overlapping.is_valid());
+    }
+}
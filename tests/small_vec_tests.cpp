@@ -0,0 +1,167 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "../src/collections/small_vec.h"
+#include "doctest/doctest.h"
+#include <string>
+
+TEST_CASE("small-vector-operations")
+{
+    SUBCASE("default constructor keeps elements inline")
+    {
+        sc2d::small_vec<int, 4> v;
+        CHECK(v.empty());
+        CHECK(v.capacity() == 4);
+        CHECK(v.is_inline());
+    }
+
+    SUBCASE("push_back spills to heap past N")
+    {
+        sc2d::small_vec<int, 4> v;
+        for(int i = 0; i < 4; ++i)
+            v.push_back(i);
+        CHECK(v.is_inline());
+
+        v.push_back(4);
+        CHECK_FALSE(v.is_inline());
+        CHECK(v.size() == 5);
+        CHECK(v.capacity() == 8);
+        for(int i = 0; i < 5; ++i)
+            CHECK(v[i] == i);
+    }
+
+    SUBCASE("push_back of own element while growing")
+    {
+        sc2d::small_vec<std::string, 2> v {"first", "second"};
+        v.push_back(v[0]);
+        CHECK(v.size() == 3);
+        CHECK(v[2] == "first");
+    }
+
+    SUBCASE("emplace_back and insert of own element")
+    {
+        sc2d::small_vec<std::string, 2> v {"first", "second"};
+        v.emplace_back(v[0]);
+        CHECK(v.size() == 3);
+        CHECK(v[2] == "first");
+
+        v.emplace_back(v[1]);
+        v.emplace_back(v[3]);
+        CHECK(v.capacity() == 8);
+        v.insert(v.begin(), std::move(v[4]));
+        CHECK(v.size() == 6);
+        CHECK(v[0] == "second");
+        CHECK(v[1] == "first");
+    }
+
+    SUBCASE("constructors")
+    {
+        sc2d::small_vec<double, 2> filled(3, 1.5);
+        CHECK(filled.size() == 3);
+        CHECK(filled[2] == 1.5);
+
+        sc2d::small_vec<double, 4> ilist {1.1, 2.2, 3.3};
+        CHECK(ilist.size() == 3);
+        CHECK(ilist.is_inline());
+        CHECK(ilist.back() == 3.3);
+    }
+
+    SUBCASE("copy")
+    {
+        sc2d::small_vec<std::string, 2> v {"a", "b", "c"};
+        sc2d::small_vec<std::string, 2> copy(v);
+        CHECK(copy == v);
+
+        sc2d::small_vec<std::string, 2> assigned {"x"};
+        assigned = v;
+        CHECK(assigned == v);
+    }
+
+    SUBCASE("move steals heap buffer")
+    {
+        sc2d::small_vec<std::string, 2> v {"a", "b", "c"};
+        const std::string* buffer = v.data();
+        sc2d::small_vec<std::string, 2> moved(std::move(v));
+        CHECK(moved.data() == buffer);
+        CHECK(moved.size() == 3);
+        CHECK(v.empty());
+        CHECK(v.is_inline());
+    }
+
+    SUBCASE("move of inline elements")
+    {
+        sc2d::small_vec<std::string, 4> v {"a", "b"};
+        sc2d::small_vec<std::string, 4> moved;
+        moved = std::move(v);
+        CHECK(moved.is_inline());
+        CHECK(moved.size() == 2);
+        CHECK(moved[1] == "b");
+        CHECK(v.empty());
+    }
+
+    SUBCASE("resize")
+    {
+        sc2d::small_vec<int, 2> v;
+        v.resize(5, 7);
+        CHECK(v.size() == 5);
+        CHECK(v[4] == 7);
+        v.resize(1);
+        CHECK(v.size() == 1);
+        CHECK(v[0] == 7);
+    }
+
+    SUBCASE("shrink_to_fit returns to inline storage")
+    {
+        sc2d::small_vec<int, 4> v {1, 2, 3, 4, 5, 6};
+        v.pop_back();
+        v.pop_back();
+        v.pop_back();
+        v.shrink_to_fit();
+        CHECK(v.is_inline());
+        CHECK(v.size() == 3);
+        CHECK(v[2] == 3);
+    }
+
+    SUBCASE("insert")
+    {
+        sc2d::small_vec<std::string, 2> v {"b", "d"};
+        v.insert(v.begin(), "a");
+        v.insert(v.begin() + 2, "c");
+        v.insert(v.end(), "e");
+        CHECK(v.size() == 5);
+        CHECK(v[0] == "a");
+        CHECK(v[1] == "b");
+        CHECK(v[2] == "c");
+        CHECK(v[3] == "d");
+        CHECK(v[4] == "e");
+    }
+
+    SUBCASE("erase")
+    {
+        sc2d::small_vec<int, 8> v {1, 2, 3, 4, 5};
+        v.erase(v.begin());
+        CHECK(v.size() == 4);
+        CHECK(v[0] == 2);
+
+        v.erase(v.begin() + 1, v.begin() + 3);
+        CHECK(v.size() == 2);
+        CHECK(v[0] == 2);
+        CHECK(v[1] == 5);
+
+        sc2d::small_vec<std::string, 2> s {"a", "b", "c"};
+        s.erase(s.begin() + 1);
+        CHECK(s.size() == 2);
+        CHECK(s[1] == "c");
+    }
+
+    SUBCASE("iterators")
+    {
+        sc2d::small_vec<int, 4> v {1, 2, 3};
+        int sum = 0;
+        for(int i : v)
+            sum += i;
+        CHECK(sum == 6);
+        CHECK(*v.rbegin() == 3);
+    }
+}
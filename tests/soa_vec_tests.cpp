@@ -0,0 +1,121 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "../src/collections/soa_vec.h"
+#include "doctest/doctest.h"
+#include <string>
+
+TEST_CASE("soa-vec")
+{
+    SUBCASE("push_back / element proxies")
+    {
+        sc2d::soa_vec<float, int, char> items;
+        CHECK(items.empty());
+        for(int i = 0; i < 100; ++i)
+            items.push_back((float)i * 0.5f, i, (char)('a' + i % 26));
+
+        CHECK(items.size() == 100);
+        CHECK(items.capacity() >= 100);
+
+        auto [x, id, c] = items[42];
+        CHECK(x == 21.0f);
+        CHECK(id == 42);
+        CHECK(c == 'a' + 42 % 26);
+
+        std::get<1>(items[42]) = -1;
+        CHECK(items.data<1>()[42] == -1);
+
+        int sum = 0;
+        for(auto [value, index, letter] : items) {
+            (void)value;
+            (void)letter;
+            sum += index;
+        }
+        CHECK(sum == 99 * 100 / 2 - 42 - 1);
+    }
+
+    SUBCASE("field arrays are aligned and contiguous")
+    {
+        sc2d::soa_vec<double, char, float> items;
+        for(int i = 0; i < 37; ++i)
+            items.push_back(i, (char)i, (float)i);
+
+        CHECK((uintptr_t)items.data<0>() % items.ALIGNMENT == 0);
+        CHECK((uintptr_t)items.data<1>() % items.ALIGNMENT == 0);
+        CHECK((uintptr_t)items.data<2>() % items.ALIGNMENT == 0);
+
+        auto floats = items.field<2>();
+        CHECK(floats.size() == 37);
+        float sum = 0;
+        for(float f : floats)
+            sum += f;
+        CHECK(sum == 36 * 37 / 2);
+        for(float& f : floats)
+            f *= 2;
+        CHECK(items.field<2>()[36] == 72.0f);
+    }
+
+    SUBCASE("bulk append")
+    {
+        sc2d::soa_vec<int, short> items;
+        const size_t first = items.append(10);
+        CHECK(first == 0);
+        CHECK(items.size() == 10);
+        CHECK(std::get<0>(items[9]) == 0);
+
+        const int ints[] = {1, 2, 3, 4};
+        const short shorts[] = {5, 6, 7, 8};
+        items.append(4, ints, shorts);
+        CHECK(items.size() == 14);
+        CHECK(std::get<0>(items[10]) == 1);
+        CHECK(std::get<1>(items[13]) == 8);
+    }
+
+    SUBCASE("erase keeps order, swap_erase moves last")
+    {
+        sc2d::soa_vec<int, float> items;
+        for(int i = 0; i < 10; ++i)
+            items.push_back(i, (float)i);
+
+        items.erase(2, 5);
+        CHECK(items.size() == 7);
+        CHECK(std::get<0>(items[2]) == 5);
+        CHECK(std::get<1>(items[6]) == 9.0f);
+
+        items.swap_erase(0);
+        CHECK(items.size() == 6);
+        CHECK(std::get<0>(items[0]) == 9);
+        CHECK(std::get<1>(items[0]) == 9.0f);
+
+        items.pop_back();
+        CHECK(items.size() == 5);
+        items.resize(8);
+        CHECK(std::get<0>(items[7]) == 0);
+        items.clear();
+        CHECK(items.empty());
+    }
+
+    SUBCASE("non-trivial fields")
+    {
+        sc2d::soa_vec<std::string, int> items;
+        for(int i = 0; i < 50; ++i)
+            items.emplace_back(std::string(40, (char)('a' + i % 26)), i);
+
+        items.erase(0);
+        items.swap_erase(10);
+        CHECK(items.size() == 48);
+        CHECK(std::get<0>(items[10]) == std::string(40, 'a' + 49 % 26));
+
+        sc2d::soa_vec<std::string, int> copy(items);
+        CHECK(copy.size() == 48);
+        CHECK(std::get<0>(copy[0]) == std::string(40, 'b'));
+
+        sc2d::soa_vec<std::string, int> moved(std::move(copy));
+        CHECK(moved.size() == 48);
+        CHECK(copy.empty());
+
+        copy = moved;
+        CHECK(std::get<1>(copy[47]) == std::get<1>(moved[47]));
+    }
+}
@@ -0,0 +1,126 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "../src/collections/sparse_set.h"
+#include "doctest/doctest.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST_CASE("sparse-set")
+{
+    using sc2d::memory::pool_handle;
+
+    SUBCASE("insert / get / erase")
+    {
+        sc2d::sparse_set<int> set;
+        pool_handle a = set.insert(1);
+        pool_handle b = set.insert(2);
+        pool_handle c = set.emplace(3);
+
+        CHECK(set.size() == 3);
+        CHECK(*set.get(a) == 1);
+        CHECK(*set.get(c) == 3);
+
+        CHECK(set.erase(a));
+        CHECK_FALSE(set.erase(a));
+        CHECK_FALSE(set.contains(a));
+        CHECK(set.get(a) == nullptr);
+        CHECK(set.size() == 2);
+        // Last value moved into the hole, handles still resolve
+        CHECK(*set.get(b) == 2);
+        CHECK(*set.get(c) == 3);
+        CHECK(set.data()[0] == 3);
+        CHECK(set.handle_at(0) == c);
+        CHECK(set.get(pool_handle()) == nullptr);
+    }
+
+    SUBCASE("reused slot gets a new generation")
+    {
+        sc2d::sparse_set<int> set;
+        pool_handle a = set.insert(1);
+        set.erase(a);
+        pool_handle b = set.insert(2);
+        CHECK(b.index() == a.index());
+        CHECK(b.generation() != a.generation());
+        CHECK(set.get(a) == nullptr);
+        CHECK(*set.get(b) == 2);
+    }
+
+    SUBCASE("values stay contiguous")
+    {
+        sc2d::sparse_set<int> set;
+        std::vector<pool_handle> handles;
+        for(int i = 0; i < 1000; ++i)
+            handles.push_back(set.insert(i));
+        for(int i = 0; i < 1000; i += 3)
+            set.erase(handles[i]);
+
+        long long sum = 0;
+        for(int value : set)
+            sum += value;
+        long long expected = 0;
+        bool resolved = true;
+        for(int i = 0; i < 1000; ++i) {
+            if(i % 3 != 0) {
+                expected += i;
+                resolved &= set.get(handles[i]) != nullptr && *set.get(handles[i]) == i;
+            }
+        }
+        CHECK(sum == expected);
+        CHECK(resolved);
+        CHECK(set.end() - set.begin() == (ptrdiff_t)set.size());
+
+        bool owners_match = true;
+        for(size_t i = 0; i < set.size(); ++i)
+            owners_match &= set.get(set.handle_at(i)) == set.data() + i;
+        CHECK(owners_match);
+    }
+
+    SUBCASE("clear invalidates handles")
+    {
+        sc2d::sparse_set<std::string> set;
+        pool_handle a = set.insert("long enough to skip small string buffer");
+        set.clear();
+        CHECK(set.empty());
+        CHECK_FALSE(set.contains(a));
+        pool_handle b = set.insert("b");
+        CHECK(*set.get(b) == "b");
+        CHECK(set.get(a) == nullptr);
+    }
+
+    SUBCASE("non-trivial values are moved and destroyed")
+    {
+        auto counter = std::make_shared<int>(0);
+        {
+            sc2d::sparse_set<std::shared_ptr<int>> set;
+            pool_handle first = set.insert(counter);
+            set.insert(counter);
+            set.insert(counter);
+            set.erase(first);
+            CHECK(counter.use_count() == 3);
+        }
+        CHECK(counter.use_count() == 1);
+    }
+}
+
+TEST_CASE("sparse-index")
+{
+    sc2d::sparse_index index;
+    auto a = index.insert();
+    auto b = index.insert();
+    auto c = index.insert();
+    CHECK(index.dense_index(c) == 2);
+
+    // Caller moves its last element to the returned position
+    CHECK(index.erase(a) == 0);
+    CHECK(index.dense_index(c) == 0);
+    CHECK(index.dense_index(b) == 1);
+    CHECK(index.size() == 2);
+
+    CHECK(index.erase(b) == 1);
+    CHECK(index.dense_index(c) == 0);
+    CHECK(index.contains(c));
+    CHECK_FALSE(index.contains(b));
+}
@@ -0,0 +1,78 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "../src/core/rendering/stream_ring.h"
+#include "doctest/doctest.h"
+
+TEST_CASE("stream-ring")
+{
+    constexpr size_t REGION = 256;
+    sc2d::stream_ring ring;
+    ring.init(REGION);
+    CHECK(ring.get_capacity() == REGION * sc2d::stream_ring::REGION_COUNT);
+
+    SUBCASE("reservations follow each other aligned")
+    {
+        auto first = ring.reserve(40, 16);
+        CHECK(first.offset == 0);
+        CHECK_FALSE(first.next_region);
+        ring.commit(20);
+
+        auto second = ring.reserve(40, 16);
+        CHECK(second.offset == 32);
+        CHECK_FALSE(second.next_region);
+        // Only what was written is used, the rest of the reservation is given back
+        ring.commit(8);
+        CHECK(ring.reserve(4, 4).offset == 40);
+        ring.commit(0);
+        CHECK(ring.reserve(4, 4).offset == 40);
+        ring.commit(4);
+
+        // Base vertex draws align to the vertex stride
+        CHECK(ring.reserve(24, 24).offset == 48);
+    }
+
+    SUBCASE("allocation that does not fit moves to the next region")
+    {
+        ring.reserve(200, 16);
+        ring.commit(200);
+        auto next = ring.reserve(64, 16);
+        CHECK(next.next_region);
+        CHECK(next.offset == REGION);
+        CHECK(ring.get_region() == 1);
+        ring.commit(64);
+
+        // An exact fit stays in the region
+        auto rest = ring.reserve(REGION - 64, 16);
+        CHECK_FALSE(rest.next_region);
+        CHECK(rest.offset == REGION + 64);
+        ring.commit(REGION - 64);
+    }
+
+    SUBCASE("last region wraps to the first")
+    {
+        for(sc2d::u32 region = 0; region < sc2d::stream_ring::REGION_COUNT; ++region) {
+            auto full = ring.reserve(REGION, 16);
+            CHECK(full.offset == region * REGION);
+            CHECK(full.next_region == (region != 0));
+            ring.commit(REGION);
+        }
+        auto wrapped = ring.reserve(16, 16);
+        CHECK(wrapped.next_region);
+        CHECK(wrapped.offset == 0);
+        CHECK(ring.get_region() == 0);
+        ring.commit(16);
+        CHECK(ring.reserve(16, 16).offset == 16);
+    }
+
+    SUBCASE("init starts over")
+    {
+        ring.reserve(REGION, 16);
+        ring.commit(REGION);
+        ring.reserve(16, 16);
+        ring.init(REGION);
+        CHECK(ring.get_region() == 0);
+        CHECK(ring.reserve(16, 16).offset == 0);
+    }
+}
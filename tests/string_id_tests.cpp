@@ -0,0 +1,61 @@
+//
+// Created by novasurfer on 10/19/26.
+//
+
+#include "../src/collections/flat_map.h"
+#include "../src/core/string_id.h"
+#include "doctest/doctest.h"
+#include <cstring>
+#include <string>
+
+using namespace sc2d::literals;
+
+namespace
+{
+    constexpr sc2d::string_id LOGO {"logo"};
+    // Hash must be usable at compile time
+    static_assert(LOGO.value() == "logo"_sid.value());
+    static_assert(sc2d::string_id("").value() == 14695981039346656037ull);
+}
+
+TEST_CASE("string-id")
+{
+    SUBCASE("FNV-1a reference values")
+    {
+        CHECK(sc2d::string_id("a").value() == 0xaf63dc4c8601ec8cull);
+        CHECK(sc2d::string_id("foobar").value() == 0x85944171f73967e8ull);
+    }
+
+    SUBCASE("ids compare by hash")
+    {
+        const std::string runtime_name = std::string("lo") + "go";
+        CHECK(sc2d::string_id(runtime_name.c_str()) == LOGO);
+        CHECK(sc2d::string_id("logo2") != LOGO);
+        CHECK(strcmp(LOGO.c_str(), "logo") == 0);
+        CHECK(strcmp(sc2d::string_id().c_str(), "") == 0);
+    }
+
+    SUBCASE("interned names outlive their source")
+    {
+        sc2d::string_id id;
+        {
+            std::string name = "textures/player_" + std::to_string(42);
+            id = sc2d::string_table::intern(name);
+            CHECK(sc2d::string_table::intern(name).c_str() == id.c_str());
+        }
+        CHECK(strcmp(id.c_str(), "textures/player_42") == 0);
+        CHECK(id == "textures/player_42"_sid);
+        CHECK(strcmp(sc2d::string_table::lookup(id), "textures/player_42") == 0);
+        CHECK(sc2d::string_table::lookup("never interned"_sid) == nullptr);
+    }
+
+    SUBCASE("as flat_map key")
+    {
+        sc2d::flat_map<sc2d::string_id, int> map;
+        map[sc2d::string_table::intern(std::string("sprite_default"))] = 1;
+        map[LOGO] = 2;
+        CHECK(map["sprite_default"] == 1);
+        CHECK(map["logo"_sid] == 2);
+        CHECK_FALSE(map.contains("tilemap"));
+    }
+}
@@ -3,6 +3,7 @@
 //
 #include "../src/collections/vec.h"
 #include "doctest/doctest.h"
+#include <string>
 #include <vector>
 
 //TEST_CASE("pool-allocator")
@@ -353,23 +354,22 @@ TEST_CASE("vector-operations")
         CHECK(v[6] == 7.7);
     }
 
-    // TODO: Fix errors from Valgrind
-    //    SUBCASE("insert(first, last iterators)")
-    //    {
-    //        sc2d::vec<double> v({1.1, 2.2, 3.3});
-    //        v.insert(v.cbegin(), v.begin(), v.begin() + 2);
-    //        v.insert(v.end(), v.end() - 2, v.end());
-    //
-    //        CHECK(v.size() == 7);
-    //        CHECK(v.capacity() == 12);
-    //        CHECK(v[0] == 1.1);
-    //        CHECK(v[1] == 2.2);
-    //        CHECK(v[2] == 1.1);
-    //        CHECK(v[3] == 2.2);
-    //        CHECK(v[4] == 3.3);
-    //        CHECK(v[5] == 2.2);
-    //        CHECK(v[6] == 3.3);
-    //    }
+    SUBCASE("insert(first, last iterators)")
+    {
+        sc2d::vec<double> v({1.1, 2.2, 3.3});
+        v.insert(v.cbegin(), v.begin(), v.begin() + 2);
+        v.insert(v.end(), v.end() - 2, v.end());
+
+        CHECK(v.size() == 7);
+        CHECK(v.capacity() == 12);
+        CHECK(v[0] == 1.1);
+        CHECK(v[1] == 2.2);
+        CHECK(v[2] == 1.1);
+        CHECK(v[3] == 2.2);
+        CHECK(v[4] == 3.3);
+        CHECK(v[5] == 2.2);
+        CHECK(v[6] == 3.3);
+    }
 
     SUBCASE("insert(std::initializer_list<T>)")
     {
@@ -398,9 +398,8 @@ TEST_CASE("vector-operations")
 
         CHECK(v.size() == 2);
         CHECK(v.capacity() == 6);
-        CHECK(v[0] != 1.1);
-        CHECK(v[1] == 2.2);
-        CHECK(v[2] == 3.3);
+        CHECK(v[0] == 2.2);
+        CHECK(v[1] == 3.3);
     }
 
     SUBCASE("erase(first, last)")
@@ -413,9 +412,18 @@ TEST_CASE("vector-operations")
 
         CHECK(v.size() == 0);
         CHECK(v.capacity() == 6);
-        CHECK(v[0] != 1.1);
-        CHECK(v[1] != 2.2);
-        CHECK(v[2] != 3.3);
+    }
+
+    SUBCASE("erase(first, last) from the middle")
+    {
+        sc2d::vec<double> v({1.1, 2.2, 3.3, 4.4, 5.5});
+        auto it = v.erase(v.begin() + 1, v.begin() + 3);
+
+        CHECK(it == v.begin() + 1);
+        CHECK(v.size() == 3);
+        CHECK(v[0] == 1.1);
+        CHECK(v[1] == 4.4);
+        CHECK(v[2] == 5.5);
     }
 
     SUBCASE("swap(other)")
@@ -515,3 +523,87 @@ TEST_CASE("vector-operations")
 //        }
 //    }
 }
+
+
+TEST_CASE("vector-relocation")
+{
+    SUBCASE("move steals the buffer")
+    {
+        sc2d::vec<double> v({1.1, 2.2, 3.3});
+        const double* data = v.data();
+
+        sc2d::vec<double> v2(std::move(v));
+        CHECK(v2.data() == data);
+        CHECK(v2.size() == 3);
+        CHECK(v.size() == 0);
+        CHECK(v.capacity() == 0);
+
+        // Moved-from vector is still usable
+        v.push_back(4.4);
+        v.push_back(5.5);
+        CHECK(v.size() == 2);
+        CHECK(v[1] == 5.5);
+
+        sc2d::vec<double> v3;
+        v3 = std::move(v2);
+        CHECK(v3.data() == data);
+        CHECK(v3[2] == 3.3);
+    }
+
+    SUBCASE("reserve_exact() and resize_uninitialized()")
+    {
+        sc2d::vec<int> v;
+        v.reserve_exact(7);
+        CHECK(v.capacity() == 7);
+        v.reserve(9);
+        CHECK(v.capacity() == 14);
+
+        v.resize_uninitialized(20);
+        CHECK(v.size() == 20);
+        CHECK(v.capacity() == 20);
+        for(int i = 0; i < 20; ++i)
+            v[i] = i;
+        CHECK(v.back() == 19);
+    }
+
+    SUBCASE("append()")
+    {
+        const int values[] = {1, 2, 3, 4, 5};
+        sc2d::vec<int> v;
+        v.append(values, 5);
+        CHECK(v.size() == 5);
+        CHECK(v[4] == 5);
+
+        // Appending own elements across reallocation
+        v.append(v.data(), v.size());
+        CHECK(v.size() == 10);
+        CHECK(v[5] == 1);
+        CHECK(v[9] == 5);
+    }
+
+    SUBCASE("non-trivial elements")
+    {
+        const std::string long_str(64, 'x');
+        sc2d::vec<std::string> v;
+        for(int i = 0; i < 20; ++i)
+            v.push_back(long_str + std::to_string(i));
+
+        v.insert(v.begin(), "first");
+        v.erase(v.begin() + 1, v.begin() + 11);
+        v.push_back(v[0]);
+
+        CHECK(v.size() == 12);
+        CHECK(v[0] == "first");
+        CHECK(v[1] == long_str + "10");
+        CHECK(v[10] == long_str + "19");
+        CHECK(v.back() == "first");
+
+        sc2d::vec<std::string> copy(v);
+        sc2d::vec<std::string> moved(std::move(v));
+        CHECK(copy == moved);
+        v.shrink_to_fit();
+        moved.shrink_to_fit();
+        CHECK(moved.capacity() == 12);
+        CHECK(moved[11] == "first");
+    }
+}